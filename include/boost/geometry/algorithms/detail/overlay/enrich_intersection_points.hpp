@@ -30,15 +30,21 @@
   #endif
 #endif
 
+#include <boost/core/ignore_unused.hpp>
 #include <boost/range.hpp>
 
+#include <boost/geometry/core/assert.hpp>
 #include <boost/geometry/algorithms/detail/ring_identifier.hpp>
 #include <boost/geometry/algorithms/detail/overlay/handle_colocations.hpp>
 #include <boost/geometry/algorithms/detail/overlay/handle_self_turns.hpp>
 #include <boost/geometry/algorithms/detail/overlay/is_self_turn.hpp>
 #include <boost/geometry/algorithms/detail/overlay/less_by_segment_ratio.hpp>
 #include <boost/geometry/algorithms/detail/overlay/overlay_type.hpp>
+#include <boost/geometry/algorithms/detail/overlay/ring_table.hpp>
 #include <boost/geometry/policies/robustness/robust_type.hpp>
+#include <boost/geometry/util/monotonic_arena.hpp>
+#include <boost/geometry/util/overlay_statistics.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 #ifdef BOOST_GEOMETRY_DEBUG_ENRICH
 #  include <boost/geometry/algorithms/detail/overlay/check_enrich.hpp>
@@ -277,23 +283,109 @@ inline void enrich_adapt(Operations& operations, Turns& turns)
         boost::end(operations), predicate), boost::end(operations));
 }
 
-template <typename Turns, typename MappedVector>
-inline void create_map(Turns const& turns, MappedVector& mapped_vector)
+// View of the operations of one ring, a part of the contiguous storage
+// of the operations of all rings
+template <typename Vector>
+class ring_operations
+{
+public :
+    typedef typename Vector::value_type value_type;
+    typedef typename Vector::iterator iterator;
+    typedef typename Vector::const_iterator const_iterator;
+    typedef typename Vector::size_type size_type;
+    typedef typename Vector::difference_type difference_type;
+
+    inline ring_operations(Vector& operations, size_type offset, size_type count)
+        : m_begin(operations.begin() + offset)
+        , m_count(count)
+    {}
+
+    inline iterator begin() { return m_begin; }
+    inline iterator end() { return m_begin + m_count; }
+    inline const_iterator begin() const { return m_begin; }
+    inline const_iterator end() const { return m_begin + m_count; }
+
+    inline size_type size() const { return m_count; }
+
+    inline value_type& operator[](size_type i) { return m_begin[i]; }
+    inline value_type const& operator[](size_type i) const { return m_begin[i]; }
+
+    // Only the operations at the end of the ring can be removed, as
+    // with erase(remove_if(...), end())
+    inline void erase(iterator first, iterator last)
+    {
+        BOOST_GEOMETRY_ASSERT(last == end());
+        boost::ignore_unused(last);
+        m_count = static_cast<size_type>(first - m_begin);
+    }
+
+private :
+    iterator m_begin;
+    size_type m_count;
+};
+
+// Places the (non discarded) operations of all turns in one vector,
+// grouped per ring, with a counting sort. Within each ring the operations
+// are in the order of the turns. The offsets of the operations of the
+// rings, in the order of the rings in the table, and the end, are
+// assigned to offsets.
+template <typename Turns, typename Table, typename Operations, typename Offsets>
+inline void bucket_operations(Turns const& turns, Table& table,
+                              Operations& operations, Offsets& offsets)
 {
     typedef typename boost::range_value<Turns>::type turn_type;
     typedef typename turn_type::container_type container_type;
-    typedef typename MappedVector::mapped_type mapped_type;
-    typedef typename boost::range_value<mapped_type>::type indexed_type;
+    typedef typename boost::range_value<Operations>::type indexed_type;
+
+    // Count the operations on each ring.
+    // Blocked operations or uu on clusters (for intersection)
+    // should be included, to block potential paths in clusters
+    for (typename boost::range_iterator<Turns const>::type
+            it = boost::begin(turns);
+         it != boost::end(turns);
+         ++it)
+    {
+        if (it->discarded)
+        {
+            continue;
+        }
+
+        for (typename boost::range_iterator<container_type const>::type
+                op_it = boost::begin(it->operations);
+            op_it != boost::end(it->operations);
+            ++op_it)
+        {
+            ring_identifier const ring_id
+                (
+                    op_it->seg_id.source_index,
+                    op_it->seg_id.multi_index,
+                    op_it->seg_id.ring_index
+                );
+            table[ring_id]++;
+        }
+    }
+
+    // Replace the counts by the offsets of the rings
+    std::size_t offset = 0;
+    offsets.reserve(table.size() + 1);
+    for (typename Table::iterator tit = table.begin(); tit != table.end(); ++tit)
+    {
+        std::size_t const count = tit->second;
+        offsets.push_back(offset);
+        tit->second = offset;
+        offset += count;
+    }
+    offsets.push_back(offset);
+
+    operations.resize(offset);
 
+    // Place the operations, the table then contains the ends of the rings
     std::size_t index = 0;
     for (typename boost::range_iterator<Turns const>::type
             it = boost::begin(turns);
          it != boost::end(turns);
          ++it, ++index)
     {
-        // Add all (non discarded) operations on this ring
-        // Blocked operations or uu on clusters (for intersection)
-        // should be included, to block potential paths in clusters
         turn_type const& turn = *it;
         if (turn.discarded)
         {
@@ -312,15 +404,63 @@ inline void create_map(Turns const& turns, MappedVector& mapped_vector)
                     op_it->seg_id.multi_index,
                     op_it->seg_id.ring_index
                 );
-            mapped_vector[ring_id].push_back
-                (
-                    indexed_type(index, op_index, *op_it,
-                        it->operations[1 - op_index].seg_id)
-                );
+            std::size_t& position = table[ring_id];
+            operations[position++] = indexed_type(index, op_index, *op_it,
+                        turn.operations[1 - op_index].seg_id);
         }
     }
 }
 
+// Sorts the operations of the rings, called for each ring, possibly
+// concurrently. The rings don't share operations.
+template
+<
+    bool Reverse1, bool Reverse2,
+    typename Operations,
+    typename Offsets,
+    typename Turns,
+    typename Geometry1, typename Geometry2,
+    typename RobustPolicy,
+    typename SideStrategy
+>
+struct enrich_sort_rings
+{
+    enrich_sort_rings(Operations& operations, Offsets const& offsets,
+                      Turns const& turns,
+                      Geometry1 const& geometry1, Geometry2 const& geometry2,
+                      RobustPolicy const& robust_policy,
+                      SideStrategy const& strategy)
+        : m_operations(operations)
+        , m_offsets(offsets)
+        , m_turns(turns)
+        , m_geometry1(geometry1)
+        , m_geometry2(geometry2)
+        , m_robust_policy(robust_policy)
+        , m_strategy(strategy)
+    {}
+
+    inline void operator()(std::size_t i)
+    {
+        ring_operations<Operations> ring(m_operations, m_offsets[i],
+                                         m_offsets[i + 1] - m_offsets[i]);
+        enrich_sort<Reverse1, Reverse2>(ring, m_turns,
+                    m_geometry1, m_geometry2,
+                    m_robust_policy, m_strategy);
+    }
+
+    Operations& m_operations;
+    Offsets const& m_offsets;
+    Turns const& m_turns;
+    Geometry1 const& m_geometry1;
+    Geometry2 const& m_geometry2;
+    RobustPolicy const& m_robust_policy;
+    SideStrategy const& m_strategy;
+};
+
+// The minimal number of operations for which the rings are sorted
+// by multiple threads
+static const std::size_t enrich_min_parallel_operations = 4096;
+
 template <typename Point1, typename Point2>
 inline typename geometry::coordinate_type<Point1>::type
         distance_measure(Point1 const& a, Point2 const& b)
@@ -388,6 +528,10 @@ inline void calculate_remaining_distance(Turns& turns)
 \param geometry2 \param_geometry
 \param robust_policy policy to handle robustness issues
 \param strategy strategy
+\param threads maximal number of threads sorting the turns of the rings,
+    including the calling one
+\param statistics statistics to which the time of handling the colocations
+    is added, or 0
  */
 template
 <
@@ -403,7 +547,9 @@ inline void enrich_intersection_points(Turns& turns,
     Clusters& clusters,
     Geometry1 const& geometry1, Geometry2 const& geometry2,
     RobustPolicy const& robust_policy,
-    SideStrategy const& strategy)
+    SideStrategy const& strategy,
+    std::size_t threads,
+    overlay_statistics* statistics = 0)
 {
     static const detail::overlay::operation_type target_operation
             = detail::overlay::operation_from_overlay<OverlayType>::value;
@@ -420,16 +566,39 @@ inline void enrich_intersection_points(Turns& turns,
             op_type
         > indexed_turn_operation;
 
-    typedef std::map
+    // The temporary containers take the memory from the allocator of turns
+    typedef typename geometry::detail::rebind_allocator
+        <
+            typename Turns::allocator_type,
+            indexed_turn_operation
+        >::type indexed_allocator_type;
+    typedef std::vector
         <
-            ring_identifier,
-            std::vector<indexed_turn_operation>
-        > mapped_vector_type;
+            indexed_turn_operation,
+            indexed_allocator_type
+        > indexed_vector_type;
+    typedef std::vector
+        <
+            std::size_t,
+            typename geometry::detail::rebind_allocator
+                <
+                    typename Turns::allocator_type,
+                    std::size_t
+                >::type
+        > offsets_type;
+    typedef detail::overlay::ring_table
+        <
+            std::size_t,
+            typename Turns::allocator_type
+        > ring_table_type;
 
     bool has_cc = false;
+    detail::statistics::phase_timer colocations_timer(statistics,
+        overlay_statistics::phase_handle_colocations);
     bool const has_colocations
         = detail::overlay::handle_colocations<Reverse1, Reverse2, OverlayType>(turns,
         clusters, geometry1, geometry2);
+    colocations_timer.stop();
 
     // Discard turns not part of target overlay
     for (typename boost::range_iterator<Turns>::type
@@ -482,44 +651,64 @@ inline void enrich_intersection_points(Turns& turns,
             >::apply(turns, clusters, geometry1, geometry2);
     }
 
-    // Create a map of vectors of indexed operation-types to be able
-    // to sort intersection points PER RING
-    mapped_vector_type mapped_vector;
+    // Place the indexed operations of all rings in one vector, grouped
+    // per ring, to be able to sort intersection points PER RING
+    ring_table_type ring_table(
+        typename ring_table_type::allocator_type(turns.get_allocator()));
+    indexed_vector_type operations(
+        indexed_allocator_type(turns.get_allocator()));
+    offsets_type offsets(
+        typename offsets_type::allocator_type(turns.get_allocator()));
 
-    detail::overlay::create_map(turns, mapped_vector);
+    detail::overlay::bucket_operations(turns, ring_table, operations, offsets);
 
-    // No const-iterator; contents of mapped copy is temporary,
-    // and changed by enrich
-    for (typename mapped_vector_type::iterator mit
-        = mapped_vector.begin();
-        mit != mapped_vector.end();
-        ++mit)
+    std::size_t const ring_count = ring_table.size();
+
+    // The rings are sorted independently, the order of the operations of
+    // each ring doesn't depend on the number of threads
+    detail::overlay::enrich_sort_rings
+        <
+            Reverse1, Reverse2,
+            indexed_vector_type, offsets_type, Turns,
+            Geometry1, Geometry2,
+            RobustPolicy, SideStrategy
+        > sorter(operations, offsets, turns,
+                 geometry1, geometry2,
+                 robust_policy, strategy);
+
+    if (threads > 1 && ring_count > 1
+        && operations.size() >= detail::overlay::enrich_min_parallel_operations)
     {
-#ifdef BOOST_GEOMETRY_DEBUG_ENRICH
-    std::cout << "ENRICH-sort Ring "
-        << mit->first << std::endl;
-#endif
-        detail::overlay::enrich_sort<Reverse1, Reverse2>(
-                    mit->second, turns,
-                    geometry1, geometry2,
-                    robust_policy, strategy);
+        detail::parallel::for_each_index(ring_count, threads, sorter);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < ring_count; i++)
+        {
+            sorter(i);
+        }
     }
 
-    for (typename mapped_vector_type::iterator mit
-        = mapped_vector.begin();
-        mit != mapped_vector.end();
-        ++mit)
+    // Enrich the rings in their order, for dissolve the adaptation
+    // of one ring may discard turns of the following rings
+    std::size_t ring_index = 0;
+    for (typename ring_table_type::iterator it = ring_table.begin();
+        it != ring_table.end();
+        ++it, ++ring_index)
     {
 #ifdef BOOST_GEOMETRY_DEBUG_ENRICH
     std::cout << "ENRICH-assign Ring "
-        << mit->first << std::endl;
+        << it->first << std::endl;
 #endif
+        detail::overlay::ring_operations<indexed_vector_type> ring(operations,
+                offsets[ring_index], offsets[ring_index + 1] - offsets[ring_index]);
+
         if (is_dissolve)
         {
-            detail::overlay::enrich_adapt(mit->second, turns);
+            detail::overlay::enrich_adapt(ring, turns);
         }
 
-        detail::overlay::enrich_assign(mit->second, turns, ! is_dissolve);
+        detail::overlay::enrich_assign(ring, turns, ! is_dissolve);
     }
 
     if (has_colocations)
@@ -548,6 +737,31 @@ inline void enrich_intersection_points(Turns& turns,
 
 }
 
+/*!
+\brief All intersection points are enriched with successor information
+\ingroup overlay
+\details The turns of the rings are sorted in the calling thread.
+ */
+template
+<
+    bool Reverse1, bool Reverse2,
+    overlay_type OverlayType,
+    typename Turns,
+    typename Clusters,
+    typename Geometry1, typename Geometry2,
+    typename RobustPolicy,
+    typename SideStrategy
+>
+inline void enrich_intersection_points(Turns& turns,
+    Clusters& clusters,
+    Geometry1 const& geometry1, Geometry2 const& geometry2,
+    RobustPolicy const& robust_policy,
+    SideStrategy const& strategy)
+{
+    enrich_intersection_points<Reverse1, Reverse2, OverlayType>(turns,
+        clusters, geometry1, geometry2, robust_policy, strategy, 1);
+}
+
 }} // namespace boost::geometry
 
 #endif // BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_ENRICH_HPP
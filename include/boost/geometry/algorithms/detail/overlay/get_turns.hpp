@@ -16,8 +16,12 @@
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_GET_TURNS_HPP
 
 
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include <boost/array.hpp>
 #include <boost/concept_check.hpp>
@@ -38,6 +42,7 @@
 #include <boost/geometry/geometries/concepts/check.hpp>
 
 #include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/parallel.hpp>
 #include <boost/geometry/views/closeable_view.hpp>
 #include <boost/geometry/views/reversible_view.hpp>
 #include <boost/geometry/views/detail/range_type.hpp>
@@ -49,6 +54,8 @@
 
 #include <boost/geometry/strategies/intersection_strategies.hpp>
 #include <boost/geometry/strategies/intersection_result.hpp>
+#include <boost/geometry/strategies/parallel.hpp>
+#include <boost/geometry/strategies/with_statistics.hpp>
 
 #include <boost/geometry/algorithms/detail/disjoint/box_box.hpp>
 #include <boost/geometry/algorithms/detail/disjoint/point_point.hpp>
@@ -63,6 +70,7 @@
 #include <boost/geometry/algorithms/detail/overlay/get_turn_info_la.hpp>
 #include <boost/geometry/algorithms/detail/overlay/segment_identifier.hpp>
 
+#include <boost/geometry/algorithms/detail/sections/prepared_sections.hpp>
 #include <boost/geometry/algorithms/detail/sections/range_by_section.hpp>
 #include <boost/geometry/algorithms/detail/sections/sectionalize.hpp>
 #include <boost/geometry/algorithms/detail/sections/section_functions.hpp>
@@ -541,6 +549,86 @@ struct section_visitor
 
 };
 
+// Collects the pairs of sections passed by partition, in the order of visiting
+template <typename Section>
+struct section_pairs_collector
+{
+    typedef std::vector<std::pair<Section const*, Section const*> > pairs_type;
+
+    pairs_type& m_pairs;
+
+    explicit section_pairs_collector(pairs_type& pairs)
+        : m_pairs(pairs)
+    {}
+
+    inline bool apply(Section const& sec1, Section const& sec2)
+    {
+        m_pairs.push_back(std::make_pair(&sec1, &sec2));
+        return true;
+    }
+};
+
+// Calculates the turns of a chunk of pairs of sections
+template
+<
+    typename Geometry1, typename Geometry2,
+    bool Reverse1, bool Reverse2,
+    typename TurnPolicy,
+    typename IntersectionStrategy,
+    typename RobustPolicy,
+    typename Turns,
+    typename Pairs
+>
+struct section_pairs_turns
+{
+    int m_source_id1;
+    Geometry1 const& m_geometry1;
+    int m_source_id2;
+    Geometry2 const& m_geometry2;
+    IntersectionStrategy const& m_intersection_strategy;
+    RobustPolicy const& m_rescale_policy;
+    Pairs const& m_pairs;
+    std::vector<Turns>& m_chunks_turns;
+
+    section_pairs_turns(int id1, Geometry1 const& g1,
+                        int id2, Geometry2 const& g2,
+                        IntersectionStrategy const& intersection_strategy,
+                        RobustPolicy const& robust_policy,
+                        Pairs const& pairs,
+                        std::vector<Turns>& chunks_turns)
+        : m_source_id1(id1), m_geometry1(g1)
+        , m_source_id2(id2), m_geometry2(g2)
+        , m_intersection_strategy(intersection_strategy)
+        , m_rescale_policy(robust_policy)
+        , m_pairs(pairs)
+        , m_chunks_turns(chunks_turns)
+    {}
+
+    inline void operator()(std::size_t chunk)
+    {
+        std::size_t const chunks_count = m_chunks_turns.size();
+        std::size_t const first = m_pairs.size() * chunk / chunks_count;
+        std::size_t const last = m_pairs.size() * (chunk + 1) / chunks_count;
+
+        no_interrupt_policy interrupt_policy;
+        section_visitor
+            <
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                TurnPolicy,
+                IntersectionStrategy, RobustPolicy,
+                Turns, no_interrupt_policy
+            > visitor(m_source_id1, m_geometry1, m_source_id2, m_geometry2,
+                      m_intersection_strategy, m_rescale_policy,
+                      m_chunks_turns[chunk], interrupt_policy);
+
+        for (std::size_t i = first; i < last; i++)
+        {
+            visitor.apply(*m_pairs[i].first, *m_pairs[i].second);
+        }
+    }
+};
+
 template
 <
     typename Geometry1, typename Geometry2,
@@ -573,18 +661,16 @@ public:
             > box_type;
         typedef geometry::sections<box_type, 2> sections_type;
 
-        sections_type sec1, sec2;
-        typedef boost::mpl::vector_c<std::size_t, 0, 1> dimensions;
-
-        typename IntersectionStrategy::envelope_strategy_type const
-            envelope_strategy = intersection_strategy.get_envelope_strategy();
-        typename IntersectionStrategy::expand_strategy_type const
-            expand_strategy = intersection_strategy.get_expand_strategy();
+        sections_type sec1_calculated, sec2_calculated;
 
-        geometry::sectionalize<Reverse1, dimensions>(geometry1, robust_policy,
-                sec1, envelope_strategy, expand_strategy, 0);
-        geometry::sectionalize<Reverse2, dimensions>(geometry2, robust_policy,
-                sec2, envelope_strategy, expand_strategy, 1);
+        detail::statistics::phase_timer sectionalize_timer(
+                detail::statistics::strategy_statistics(intersection_strategy),
+                overlay_statistics::phase_sectionalize);
+        sections_type const& sec1 = get_sections<Reverse1>(geometry1,
+                robust_policy, sec1_calculated, intersection_strategy, 0);
+        sections_type const& sec2 = get_sections<Reverse2>(geometry2,
+                robust_policy, sec2_calculated, intersection_strategy, 1);
+        sectionalize_timer.stop();
 
         // ... and then partition them, intersecting overlapping sections in visitor method
         section_visitor
@@ -607,6 +693,18 @@ public:
                 typename IntersectionStrategy::disjoint_box_box_strategy_type
             > overlaps_section_box_type;
 
+        std::size_t const threads
+            = detail::parallel::strategy_threads(intersection_strategy);
+
+        if (threads > 1 && ! InterruptPolicy::enabled)
+        {
+            apply_parallel<box_type>(source_id1, geometry1,
+                source_id2, geometry2, sec1, sec2,
+                intersection_strategy, robust_policy,
+                turns, visitor, threads);
+            return;
+        }
+
         geometry::partition
             <
                 box_type
@@ -614,6 +712,125 @@ public:
                      get_section_box_type(),
                      overlaps_section_box_type());
     }
+
+private :
+    // Returns the sections prepared by the strategy if it has them for
+    // the geometry, otherwise calculates them
+    template
+    <
+        bool Reverse,
+        typename Geometry,
+        typename RobustPolicy,
+        typename Sections,
+        typename IntersectionStrategy
+    >
+    static inline Sections const& get_sections(Geometry const& geometry,
+            RobustPolicy const& robust_policy,
+            Sections& sections,
+            IntersectionStrategy const& intersection_strategy,
+            int source_index)
+    {
+        Sections const* prepared
+            = detail::section::prepared_sections
+                <
+                    Reverse, Sections
+                >(geometry, intersection_strategy);
+        if (prepared != 0)
+        {
+            return *prepared;
+        }
+
+        typedef boost::mpl::vector_c<std::size_t, 0, 1> dimensions;
+
+        geometry::sectionalize<Reverse, dimensions>(geometry, robust_policy,
+                sections,
+                intersection_strategy.get_envelope_strategy(),
+                intersection_strategy.get_expand_strategy(),
+                source_index);
+        return sections;
+    }
+
+    // Partition only collects the pairs of sections, their turns are
+    // calculated afterwards in chunks of subsequent pairs, possibly in
+    // separate threads. The turns of the chunks are appended in the order
+    // of the chunks so the result is the same as the sequential one.
+    template
+    <
+        typename Box,
+        typename Sections,
+        typename IntersectionStrategy, typename RobustPolicy,
+        typename Turns, typename Visitor
+    >
+    static inline void apply_parallel(
+            int source_id1, Geometry1 const& geometry1,
+            int source_id2, Geometry2 const& geometry2,
+            Sections const& sec1, Sections const& sec2,
+            IntersectionStrategy const& intersection_strategy,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            Visitor& visitor,
+            std::size_t threads)
+    {
+        typedef typename boost::range_value<Sections>::type section_type;
+        typedef section_pairs_collector<section_type> collector_type;
+        typedef typename collector_type::pairs_type pairs_type;
+
+        pairs_type pairs;
+        collector_type collector(pairs);
+
+        typedef detail::section::get_section_box
+            <
+                typename IntersectionStrategy::expand_box_strategy_type
+            > get_section_box_type;
+        typedef detail::section::overlaps_section_box
+            <
+                typename IntersectionStrategy::disjoint_box_box_strategy_type
+            > overlaps_section_box_type;
+
+        geometry::partition
+            <
+                Box
+            >::apply(sec1, sec2, collector,
+                     get_section_box_type(), overlaps_section_box_type(),
+                     get_section_box_type(), overlaps_section_box_type(),
+                     geometry::partition<Box>::default_min_elements,
+                     detail::partition::visit_no_policy(),
+                     threads);
+
+        if (pairs.size() < detail::parallel::strategy_min_pairs(intersection_strategy))
+        {
+            for (typename pairs_type::const_iterator it = pairs.begin();
+                 it != pairs.end(); ++it)
+            {
+                visitor.apply(*it->first, *it->second);
+            }
+            return;
+        }
+
+        // More chunks than threads to balance the work
+        std::size_t const chunks_count = (std::min)(threads * 4, pairs.size());
+
+        std::vector<Turns> chunks_turns(chunks_count);
+
+        section_pairs_turns
+            <
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                TurnPolicy,
+                IntersectionStrategy, RobustPolicy,
+                Turns, pairs_type
+            > worker(source_id1, geometry1, source_id2, geometry2,
+                     intersection_strategy, robust_policy,
+                     pairs, chunks_turns);
+
+        detail::parallel::for_each_index(chunks_count, threads, worker);
+
+        for (std::size_t i = 0; i < chunks_count; i++)
+        {
+            std::copy(boost::begin(chunks_turns[i]), boost::end(chunks_turns[i]),
+                      std::back_inserter(turns));
+        }
+    }
 };
 
 
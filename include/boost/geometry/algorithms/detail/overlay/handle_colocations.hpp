@@ -17,7 +17,6 @@
 
 #include <cstddef>
 #include <algorithm>
-#include <map>
 #include <vector>
 
 #include <boost/core/ignore_unused.hpp>
@@ -32,6 +31,7 @@
 #include <boost/geometry/algorithms/detail/ring_identifier.hpp>
 #include <boost/geometry/algorithms/detail/overlay/segment_identifier.hpp>
 #include <boost/geometry/util/condition.hpp>
+#include <boost/geometry/util/monotonic_arena.hpp>
 
 #if defined(BOOST_GEOMETRY_DEBUG_HANDLE_COLOCATIONS)
 #  include <iostream>
@@ -47,29 +47,6 @@ namespace boost { namespace geometry
 namespace detail { namespace overlay
 {
 
-template <typename SegmentRatio>
-struct segment_fraction
-{
-    segment_identifier seg_id;
-    SegmentRatio fraction;
-
-    segment_fraction(segment_identifier const& id, SegmentRatio const& fr)
-        : seg_id(id)
-        , fraction(fr)
-    {}
-
-    segment_fraction()
-    {}
-
-    bool operator<(segment_fraction<SegmentRatio> const& other) const
-    {
-        return seg_id == other.seg_id
-                ? fraction < other.fraction
-                : seg_id < other.seg_id;
-    }
-
-};
-
 struct turn_operation_index
 {
     turn_operation_index(signed_size_type ti = -1,
@@ -148,56 +125,287 @@ private:
     Turns const& m_turns;
 };
 
-template <typename Operation, typename ClusterPerSegment>
-inline signed_size_type get_cluster_id(Operation const& op, ClusterPerSegment const& cluster_per_segment)
+inline std::size_t segment_hash(segment_identifier const& seg_id)
 {
-    typedef typename ClusterPerSegment::key_type segment_fraction_type;
-
-    segment_fraction_type seg_frac(op.seg_id, op.fraction);
-    typename ClusterPerSegment::const_iterator it
-            = cluster_per_segment.find(seg_frac);
+    signed_size_type const values[5] =
+        {
+            seg_id.source_index, seg_id.multi_index, seg_id.ring_index,
+            seg_id.piece_index, seg_id.segment_index
+        };
 
-    if (it == cluster_per_segment.end())
+    std::size_t seed = 0;
+    for (std::size_t i = 0; i < 5; i++)
     {
-        return -1;
+        seed ^= static_cast<std::size_t>(values[i])
+            + 0x9e3779b9u + (seed << 6) + (seed >> 2);
     }
-    return it->second;
+    return seed;
 }
 
-template <typename Operation, typename ClusterPerSegment>
-inline void add_cluster_id(Operation const& op,
-    ClusterPerSegment& cluster_per_segment, signed_size_type id)
+/*!
+\brief Operations of the turns grouped per segment, replacing
+    std::map<segment_identifier, std::vector<turn_operation_index> >
+    and the map of the cluster ids per segment and fraction
+\details The segment identifiers are hashed into an open addressing table,
+    giving each segment a group. The operations are then placed per group,
+    in the order of the turns, in one vector. Nothing is ordered until
+    sort() is called for a group having more than one operation.
+    After sorting, the operations of a segment with the same fraction are
+    consecutive and their first position is the key of their cluster id.
+*/
+template <typename Turns>
+class segment_operations
 {
-    typedef typename ClusterPerSegment::key_type segment_fraction_type;
+    typedef typename Turns::allocator_type turns_allocator_type;
 
-    segment_fraction_type seg_frac(op.seg_id, op.fraction);
+    typedef typename geometry::detail::rebind_allocator
+        <
+            turns_allocator_type, std::size_t
+        >::type size_allocator_type;
+    typedef std::vector<std::size_t, size_allocator_type> size_vector;
 
-    cluster_per_segment[seg_frac] = id;
-}
+    typedef std::vector
+        <
+            segment_identifier,
+            typename geometry::detail::rebind_allocator
+                <
+                    turns_allocator_type, segment_identifier
+                >::type
+        > key_vector;
+
+    typedef std::vector
+        <
+            turn_operation_index,
+            typename geometry::detail::rebind_allocator
+                <
+                    turns_allocator_type, turn_operation_index
+                >::type
+        > operation_vector;
+
+    typedef std::vector
+        <
+            signed_size_type,
+            typename geometry::detail::rebind_allocator
+                <
+                    turns_allocator_type, signed_size_type
+                >::type
+        > id_vector;
+
+public :
+    typedef typename operation_vector::const_iterator const_iterator;
+
+    explicit segment_operations(Turns const& turns)
+        : m_keys(turns.get_allocator())
+        , m_offsets(turns.get_allocator())
+        , m_operations(turns.get_allocator())
+        , m_positions(turns.get_allocator())
+        , m_runs(turns.get_allocator())
+        , m_cluster_ids(turns.get_allocator())
+    {
+        std::size_t const operation_count = 2 * boost::size(turns);
+
+        // The table is kept at most half full
+        std::size_t capacity = 16;
+        while (capacity < 2 * operation_count)
+        {
+            capacity *= 2;
+        }
+        std::size_t const mask = capacity - 1;
+        size_allocator_type const allocator(turns.get_allocator());
+        size_vector table(capacity, unused(), allocator);
+        size_vector group_of(operation_count, 0, allocator);
+
+        std::size_t index = 0;
+        for (typename boost::range_iterator<Turns const>::type
+                it = boost::begin(turns);
+             it != boost::end(turns);
+             ++it)
+        {
+            for (int i = 0; i < 2; i++, index++)
+            {
+                segment_identifier const& seg_id = it->operations[i].seg_id;
+                std::size_t slot = segment_hash(seg_id) & mask;
+                while (table[slot] != unused()
+                       && ! (m_keys[table[slot]] == seg_id))
+                {
+                    slot = (slot + 1) & mask;
+                }
+                if (table[slot] == unused())
+                {
+                    table[slot] = m_keys.size();
+                    m_keys.push_back(seg_id);
+                    m_offsets.push_back(0);
+                }
+                group_of[index] = table[slot];
+                m_offsets[table[slot]]++;
+            }
+        }
+
+        // Convert the counts to the offsets of the groups, the last offset
+        // is the end of the last group
+        std::size_t offset = 0;
+        for (std::size_t g = 0; g < m_offsets.size(); g++)
+        {
+            std::size_t const count = m_offsets[g];
+            m_offsets[g] = offset;
+            offset += count;
+        }
+        m_offsets.push_back(offset);
+
+        size_vector next(m_offsets.begin(), m_offsets.end() - 1, allocator);
+        m_operations.resize(operation_count);
+        m_positions.resize(operation_count);
+        m_runs.resize(operation_count);
+        for (std::size_t i = 0; i < operation_count; i++)
+        {
+            std::size_t const position = next[group_of[i]]++;
+            m_operations[position] = turn_operation_index(
+                static_cast<signed_size_type>(i / 2),
+                static_cast<signed_size_type>(i % 2));
+            m_positions[i] = position;
+            m_runs[position] = position;
+        }
+        m_cluster_ids.resize(operation_count, -1);
+    }
+
+    inline std::size_t group_count() const
+    {
+        return m_keys.size();
+    }
+
+    inline segment_identifier const& key(std::size_t group) const
+    {
+        return m_keys[group];
+    }
+
+    inline std::size_t size(std::size_t group) const
+    {
+        return m_offsets[group + 1] - m_offsets[group];
+    }
+
+    inline const_iterator begin(std::size_t group) const
+    {
+        return m_operations.begin() + m_offsets[group];
+    }
+
+    inline const_iterator end(std::size_t group) const
+    {
+        return m_operations.begin() + m_offsets[group + 1];
+    }
+
+    // Sorts the operations of the group on fraction and type, and lets the
+    // operations with the same fraction share their cluster id
+    inline void sort(std::size_t group, Turns const& turns)
+    {
+        typedef typename boost::range_value<Turns>::type turn_type;
+
+        std::size_t const first = m_offsets[group];
+        std::size_t const last = m_offsets[group + 1];
+
+        std::sort(m_operations.begin() + first, m_operations.begin() + last,
+                  less_by_fraction_and_type<Turns>(turns));
+
+        for (std::size_t position = first; position < last; position++)
+        {
+            turn_operation_index const& toi = m_operations[position];
+            m_positions[index_of(toi.turn_index, toi.op_index)] = position;
+
+            m_runs[position] = position;
+            if (position > first)
+            {
+                turn_operation_index const& previous = m_operations[position - 1];
+                turn_type const& previous_turn = turns[previous.turn_index];
+                turn_type const& turn = turns[toi.turn_index];
+                if (previous_turn.operations[previous.op_index].fraction
+                    == turn.operations[toi.op_index].fraction)
+                {
+                    m_runs[position] = m_runs[position - 1];
+                }
+            }
+        }
+    }
+
+    // Returns the cluster of the segment and fraction of the operation,
+    // -1 if there is none
+    inline signed_size_type cluster_id(signed_size_type turn_index,
+                                       signed_size_type op_index) const
+    {
+        return m_cluster_ids[run_of(turn_index, op_index)];
+    }
+
+    inline void set_cluster_id(signed_size_type turn_index,
+                               signed_size_type op_index,
+                               signed_size_type id)
+    {
+        m_cluster_ids[run_of(turn_index, op_index)] = id;
+    }
+
+private :
+    static inline std::size_t unused()
+    {
+        return static_cast<std::size_t>(-1);
+    }
+
+    static inline std::size_t index_of(signed_size_type turn_index,
+                                       signed_size_type op_index)
+    {
+        return 2 * static_cast<std::size_t>(turn_index)
+            + static_cast<std::size_t>(op_index);
+    }
+
+    inline std::size_t run_of(signed_size_type turn_index,
+                              signed_size_type op_index) const
+    {
+        return m_runs[m_positions[index_of(turn_index, op_index)]];
+    }
 
-template <typename Turn, typename ClusterPerSegment>
-inline signed_size_type add_turn_to_cluster(Turn const& turn,
-        ClusterPerSegment& cluster_per_segment, signed_size_type& cluster_id)
+    key_vector m_keys;
+    size_vector m_offsets;
+    operation_vector m_operations;
+    size_vector m_positions;
+    size_vector m_runs;
+    id_vector m_cluster_ids;
+};
+
+template <typename SegmentOperations>
+struct less_by_segment_key
+{
+    explicit less_by_segment_key(SegmentOperations const& operations)
+        : m_operations(operations)
+    {}
+
+    inline bool operator()(std::size_t left, std::size_t right) const
+    {
+        return m_operations.key(left) < m_operations.key(right);
+    }
+
+private :
+    SegmentOperations const& m_operations;
+};
+
+template <typename SegmentOperations>
+inline signed_size_type add_turn_to_cluster(signed_size_type turn_index,
+        SegmentOperations& operations, signed_size_type& cluster_id)
 {
-    signed_size_type cid0 = get_cluster_id(turn.operations[0], cluster_per_segment);
-    signed_size_type cid1 = get_cluster_id(turn.operations[1], cluster_per_segment);
+    signed_size_type cid0 = operations.cluster_id(turn_index, 0);
+    signed_size_type cid1 = operations.cluster_id(turn_index, 1);
 
     if (cid0 == -1 && cid1 == -1)
     {
         // Because of this, first cluster ID will be 1
         ++cluster_id;
-        add_cluster_id(turn.operations[0], cluster_per_segment, cluster_id);
-        add_cluster_id(turn.operations[1], cluster_per_segment, cluster_id);
+        operations.set_cluster_id(turn_index, 0, cluster_id);
+        operations.set_cluster_id(turn_index, 1, cluster_id);
         return cluster_id;
     }
     else if (cid0 == -1 && cid1 != -1)
     {
-        add_cluster_id(turn.operations[0], cluster_per_segment, cid1);
+        operations.set_cluster_id(turn_index, 0, cid1);
         return cid1;
     }
     else if (cid0 != -1 && cid1 == -1)
     {
-        add_cluster_id(turn.operations[1], cluster_per_segment, cid0);
+        operations.set_cluster_id(turn_index, 1, cid0);
         return cid0;
     }
     else if (cid0 == cid1)
@@ -217,26 +425,25 @@ inline signed_size_type add_turn_to_cluster(Turn const& turn,
 template
 <
     typename Turns,
-    typename ClusterPerSegment,
-    typename Operations,
+    typename SegmentOperations,
     typename Geometry1,
     typename Geometry2
 >
 inline void handle_colocation_cluster(Turns& turns,
         signed_size_type& cluster_id,
-        ClusterPerSegment& cluster_per_segment,
-        Operations const& operations,
+        SegmentOperations& operations,
+        std::size_t group,
         Geometry1 const& /*geometry1*/, Geometry2 const& /*geometry2*/)
 {
     typedef typename boost::range_value<Turns>::type turn_type;
     typedef typename turn_type::turn_operation_type turn_operation_type;
 
-    std::vector<turn_operation_index>::const_iterator vit = operations.begin();
+    typename SegmentOperations::const_iterator vit = operations.begin(group);
 
     turn_operation_index ref_toi = *vit;
     signed_size_type ref_id = -1;
 
-    for (++vit; vit != operations.end(); ++vit)
+    for (++vit; vit != operations.end(group); ++vit)
     {
         turn_type& ref_turn = turns[ref_toi.turn_index];
         turn_operation_type const& ref_op
@@ -250,26 +457,20 @@ inline void handle_colocation_cluster(Turns& turns,
 
         if (ref_op.fraction == op.fraction)
         {
-            turn_operation_type const& other_op = turn.operations[1 - toi.op_index];
-
             if (ref_id == -1)
             {
-                ref_id = add_turn_to_cluster(ref_turn, cluster_per_segment, cluster_id);
+                ref_id = add_turn_to_cluster(ref_toi.turn_index, operations, cluster_id);
             }
             BOOST_ASSERT(ref_id != -1);
 
             // ref_turn (both operations) are already added to cluster,
             // so also "op" is already added to cluster,
             // We only need to add other_op
-            signed_size_type id = get_cluster_id(other_op, cluster_per_segment);
-            if (id != -1 && id != ref_id)
-            {
-            }
-            else if (id == -1)
+            signed_size_type const other_index = 1 - toi.op_index;
+            if (operations.cluster_id(toi.turn_index, other_index) == -1)
             {
                 // Add to same cluster
-                add_cluster_id(other_op, cluster_per_segment, ref_id);
-                id = ref_id;
+                operations.set_cluster_id(toi.turn_index, other_index, ref_id);
             }
         }
         else
@@ -286,15 +487,13 @@ template
 <
     typename Turns,
     typename Clusters,
-    typename ClusterPerSegment
+    typename SegmentOperations
 >
 inline void assign_cluster_to_turns(Turns& turns,
         Clusters& clusters,
-        ClusterPerSegment const& cluster_per_segment)
+        SegmentOperations const& operations)
 {
     typedef typename boost::range_value<Turns>::type turn_type;
-    typedef typename turn_type::turn_operation_type turn_operation_type;
-    typedef typename ClusterPerSegment::key_type segment_fraction_type;
 
     signed_size_type turn_index = 0;
     for (typename boost::range_iterator<Turns>::type it = turns.begin();
@@ -312,19 +511,17 @@ inline void assign_cluster_to_turns(Turns& turns,
 
         for (int i = 0; i < 2; i++)
         {
-            turn_operation_type const& op = turn.operations[i];
-            segment_fraction_type seg_frac(op.seg_id, op.fraction);
-            typename ClusterPerSegment::const_iterator cit = cluster_per_segment.find(seg_frac);
-            if (cit != cluster_per_segment.end())
+            signed_size_type const id = operations.cluster_id(turn_index, i);
+            if (id != -1)
             {
 #if defined(BOOST_GEOMETRY_DEBUG_HANDLE_COLOCATIONS)
                 if (turn.is_clustered()
-                        && turn.cluster_id != cit->second)
+                        && turn.cluster_id != id)
                 {
                     std::cout << " CONFLICT " << std::endl;
                 }
 #endif
-                turn.cluster_id = cit->second;
+                turn.cluster_id = id;
                 clusters[turn.cluster_id].turn_indices.insert(turn_index);
             }
         }
@@ -601,82 +798,61 @@ inline bool handle_colocations(Turns& turns, Clusters& clusters,
 {
     static const detail::overlay::operation_type target_operation
             = detail::overlay::operation_from_overlay<OverlayType>::value;
-    typedef std::map
-        <
-            segment_identifier,
-            std::vector<turn_operation_index>
-        > map_type;
 
-    // Create and fill map on segment-identifier Map is sorted on seg_id,
-    // meaning it is sorted on ring_identifier too. This means that exterior
-    // rings are handled first. If there is a colocation on the exterior ring,
-    // that information can be used for the interior ring too
-    map_type map;
-
-    signed_size_type index = 0;
-    for (typename boost::range_iterator<Turns>::type
-            it = boost::begin(turns);
-         it != boost::end(turns);
-         ++it, ++index)
-    {
-        map[it->operations[0].seg_id].push_back(turn_operation_index(index, 0));
-        map[it->operations[1].seg_id].push_back(turn_operation_index(index, 1));
-    }
+    // Group the operations per segment identifier
+    segment_operations<Turns> operations(turns);
 
     // Check if there are multiple turns on one or more segments,
     // if not then nothing is to be done
-    bool colocations = 0;
-    for (typename map_type::const_iterator it = map.begin();
-         it != map.end();
-         ++it)
+    typedef std::vector
+        <
+            std::size_t,
+            typename geometry::detail::rebind_allocator
+                <
+                    typename Turns::allocator_type, std::size_t
+                >::type
+        > group_vector;
+    group_vector colocated(turns.get_allocator());
+    for (std::size_t group = 0; group < operations.group_count(); group++)
     {
-        if (it->second.size() > 1u)
+        if (operations.size(group) > 1u)
         {
-            colocations = true;
-            break;
+            colocated.push_back(group);
         }
     }
 
-    if (! colocations)
+    if (colocated.empty())
     {
         return false;
     }
 
-    // Sort all vectors, per same segment
-    less_by_fraction_and_type<Turns> less(turns);
-    for (typename map_type::iterator it = map.begin();
-         it != map.end(); ++it)
+    // Sort the segments having multiple turns on segment identifier,
+    // meaning they are sorted on ring_identifier too. This means that
+    // exterior rings are handled first. If there is a colocation on the
+    // exterior ring, that information can be used for the interior ring too
+    std::sort(colocated.begin(), colocated.end(),
+              less_by_segment_key<segment_operations<Turns> >(operations));
+
+    // Sort all groups, per same segment
+    for (typename group_vector::const_iterator it = colocated.begin();
+         it != colocated.end(); ++it)
     {
-        std::sort(it->second.begin(), it->second.end(), less);
+        operations.sort(*it, turns);
     }
 
-    typedef typename boost::range_value<Turns>::type turn_type;
-    typedef typename turn_type::segment_ratio_type segment_ratio_type;
-
-    typedef std::map
-        <
-            segment_fraction<segment_ratio_type>,
-            signed_size_type
-        > cluster_per_segment_type;
-
-    cluster_per_segment_type cluster_per_segment;
-
     // Assign to zero, because of pre-increment later the cluster_id
     // effectively starts with 1
     // (and can later be negated to use uniquely with turn_index)
     signed_size_type cluster_id = 0;
 
-    for (typename map_type::const_iterator it = map.begin();
-         it != map.end(); ++it)
+    for (typename group_vector::const_iterator it = colocated.begin();
+         it != colocated.end(); ++it)
     {
-        if (it->second.size() > 1u)
-        {
-            handle_colocation_cluster(turns, cluster_id, cluster_per_segment,
-                it->second, geometry1, geometry2);
-        }
+        handle_colocation_cluster(turns, cluster_id, operations,
+            *it, geometry1, geometry2);
     }
 
-    assign_cluster_to_turns(turns, clusters, cluster_per_segment);
+    assign_cluster_to_turns(turns, clusters, operations);
     // Get colocated information here and not later, to keep information
     // on turns which are discarded afterwards
     set_colocation<OverlayType>(turns, clusters);
@@ -691,13 +867,13 @@ inline bool handle_colocations(Turns& turns, Clusters& clusters,
     }
 
 #if defined(BOOST_GEOMETRY_DEBUG_HANDLE_COLOCATIONS)
-    std::cout << "*** Colocations " << map.size() << std::endl;
-    for (typename map_type::const_iterator it = map.begin();
-         it != map.end(); ++it)
+    std::cout << "*** Colocations " << colocated.size() << std::endl;
+    for (typename group_vector::const_iterator it = colocated.begin();
+         it != colocated.end(); ++it)
     {
-        std::cout << it->first << std::endl;
-        for (std::vector<turn_operation_index>::const_iterator vit
-             = it->second.begin(); vit != it->second.end(); ++vit)
+        std::cout << operations.key(*it) << std::endl;
+        for (typename segment_operations<Turns>::const_iterator vit
+             = operations.begin(*it); vit != operations.end(*it); ++vit)
         {
             turn_operation_index const& toi = *vit;
             std::cout << geometry::wkt(turns[toi.turn_index].point)
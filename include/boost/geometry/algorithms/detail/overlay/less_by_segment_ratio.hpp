@@ -47,6 +47,15 @@ struct indexed_turn_operation
     segment_identifier const* other_seg_id; // segment id of other segment of intersection of two segments
     TurnOperation const* subject;
 
+    // Necessary to allocate the storage of all rings at once
+    inline indexed_turn_operation()
+        : turn_index(0)
+        , operation_index(0)
+        , skip(false)
+        , other_seg_id(0)
+        , subject(0)
+    {}
+
     inline indexed_turn_operation(std::size_t ti, std::size_t oi,
                 TurnOperation const& sub,
                 segment_identifier const& oid)
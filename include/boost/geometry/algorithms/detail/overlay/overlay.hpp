@@ -18,6 +18,7 @@
 
 
 #include <deque>
+#include <functional>
 #include <map>
 
 #include <boost/range.hpp>
@@ -44,11 +45,16 @@
 #include <boost/geometry/algorithms/detail/overlay/add_rings.hpp>
 #include <boost/geometry/algorithms/detail/overlay/assign_parents.hpp>
 #include <boost/geometry/algorithms/detail/overlay/ring_properties.hpp>
+#include <boost/geometry/algorithms/detail/overlay/ring_table.hpp>
 #include <boost/geometry/algorithms/detail/overlay/select_rings.hpp>
 #include <boost/geometry/algorithms/detail/overlay/do_reverse.hpp>
 
 #include <boost/geometry/policies/robustness/segment_ratio_type.hpp>
 
+#include <boost/geometry/strategies/parallel.hpp>
+#include <boost/geometry/strategies/with_arena.hpp>
+#include <boost/geometry/strategies/with_statistics.hpp>
+
 #include <boost/geometry/util/condition.hpp>
 
 #ifdef BOOST_GEOMETRY_DEBUG_ASSEMBLE
@@ -193,6 +199,21 @@ inline void get_ring_turn_info(TurnInfoMap& turn_info_map, Turns const& turns, C
     }
 }
 
+// Table of properties of rings, taking the memory from the arena of the
+// Strategy if it has one
+template <typename Strategy, typename Properties>
+struct ring_map_type
+{
+    typedef ring_table
+        <
+            Properties,
+            typename detail::arena::strategy_allocator
+                <
+                    Strategy, Properties
+                >::type
+        > type;
+};
+
 template
 <
     typename GeometryOut, overlay_type OverlayType, bool ReverseOut,
@@ -203,9 +224,11 @@ inline OutputIterator return_if_one_input_is_empty(Geometry1 const& geometry1,
             Geometry2 const& geometry2,
             OutputIterator out, Strategy const& strategy)
 {
+    typedef typename geometry::ring_type<GeometryOut>::type ring_type;
     typedef std::deque
         <
-            typename geometry::ring_type<GeometryOut>::type
+            ring_type,
+            typename detail::arena::strategy_allocator<Strategy, ring_type>::type
         > ring_container_type;
 
     typedef typename geometry::point_type<Geometry1>::type point_type1;
@@ -219,6 +242,15 @@ inline OutputIterator return_if_one_input_is_empty(Geometry1 const& geometry1,
                 >::type::template result_type<point_type1>::type
         > properties;
 
+    typedef typename ring_map_type
+        <
+            Strategy, ring_turn_info
+        >::type ring_turn_info_map;
+    typedef typename ring_map_type
+        <
+            Strategy, properties
+        >::type ring_properties_map;
+
 // Silence warning C4127: conditional expression is constant
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -239,11 +271,13 @@ inline OutputIterator return_if_one_input_is_empty(Geometry1 const& geometry1,
 #endif
 
 
-    std::map<ring_identifier, ring_turn_info> empty;
-    std::map<ring_identifier, properties> all_of_one_of_them;
+    ring_turn_info_map empty(
+        detail::arena::get_allocator<typename ring_turn_info_map::value_type>(strategy));
+    ring_properties_map all_of_one_of_them(
+        detail::arena::get_allocator<typename ring_properties_map::value_type>(strategy));
 
     select_rings<OverlayType>(geometry1, geometry2, empty, all_of_one_of_them, strategy);
-    ring_container_type rings;
+    ring_container_type rings(detail::arena::get_allocator<ring_type>(strategy));
     assign_parents<OverlayType>(geometry1, geometry2, rings, all_of_one_of_them, strategy);
     return add_rings<GeometryOut>(all_of_one_of_them, geometry1, geometry2, rings, out,
                                   strategy.template get_area_strategy<point_type1>());
@@ -267,6 +301,13 @@ struct overlay
                 Strategy const& strategy,
                 Visitor& visitor)
     {
+        // Declared first, so the arena is released after all of the
+        // containers using it are destroyed
+        detail::arena::release_guard<Strategy> const release_arena(strategy);
+        detail::statistics::operation_recorder<Strategy> const record_operation(strategy);
+        overlay_statistics* const statistics
+                = detail::statistics::strategy_statistics(strategy);
+
         bool const is_empty1 = geometry::is_empty(geometry1);
         bool const is_empty2 = geometry::is_empty(geometry2);
 
@@ -289,25 +330,45 @@ struct overlay
             point_type,
             typename geometry::segment_ratio_type<point_type, RobustPolicy>::type
         > turn_info;
-        typedef std::deque<turn_info> turn_container_type;
+        typedef std::deque
+            <
+                turn_info,
+                typename detail::arena::strategy_allocator<Strategy, turn_info>::type
+            > turn_container_type;
 
+        typedef typename geometry::ring_type<GeometryOut>::type ring_type;
         typedef std::deque
             <
-                typename geometry::ring_type<GeometryOut>::type
+                ring_type,
+                typename detail::arena::strategy_allocator<Strategy, ring_type>::type
             > ring_container_type;
 
         // Define the clusters, mapping cluster_id -> turns
         typedef std::map
             <
                 signed_size_type,
-                cluster_info
+                cluster_info,
+                std::less<signed_size_type>,
+                typename detail::arena::strategy_allocator
+                    <
+                        Strategy,
+                        std::pair<signed_size_type const, cluster_info>
+                    >::type
             > cluster_type;
 
-        turn_container_type turns;
+        typedef typename ring_map_type
+            <
+                Strategy, ring_turn_info
+            >::type ring_turn_info_map;
+
+        turn_container_type turns(detail::arena::get_allocator<turn_info>(strategy));
 
 #ifdef BOOST_GEOMETRY_DEBUG_ASSEMBLE
 std::cout << "get turns" << std::endl;
 #endif
+        detail::statistics::phase_timer get_turns_timer(statistics,
+                overlay_statistics::phase_get_turns,
+                overlay_statistics::phase_sectionalize);
         detail::get_turns::no_interrupt_policy policy;
         geometry::get_turns
             <
@@ -330,18 +391,44 @@ std::cout << "get turns" << std::endl;
         }
 #endif
 
+        get_turns_timer.stop();
+        if (statistics != 0)
+        {
+            statistics->turns += turns.size();
+        }
+
 
 #ifdef BOOST_GEOMETRY_DEBUG_ASSEMBLE
 std::cout << "enrich" << std::endl;
 #endif
         typename Strategy::side_strategy_type side_strategy = strategy.get_side_strategy();
-        cluster_type clusters;
-        std::map<ring_identifier, ring_turn_info> turn_info_per_ring;
-
+        cluster_type clusters(std::less<signed_size_type>(),
+            detail::arena::get_allocator<typename cluster_type::value_type>(strategy));
+        ring_turn_info_map turn_info_per_ring(
+            detail::arena::get_allocator<typename ring_turn_info_map::value_type>(strategy));
+
+        detail::statistics::phase_timer enrich_timer(statistics,
+                overlay_statistics::phase_enrich,
+                overlay_statistics::phase_handle_colocations);
         geometry::enrich_intersection_points<Reverse1, Reverse2, OverlayType>(turns,
                 clusters, geometry1, geometry2,
                     robust_policy,
-                    side_strategy);
+                    side_strategy,
+                    detail::parallel::strategy_threads(strategy),
+                    statistics);
+        enrich_timer.stop();
+        if (statistics != 0)
+        {
+            statistics->clusters += clusters.size();
+            for (typename boost::range_iterator<turn_container_type const>::type
+                    it = boost::begin(turns); it != boost::end(turns); ++it)
+            {
+                if (it->discarded)
+                {
+                    statistics->discarded_turns++;
+                }
+            }
+        }
 
         visitor.visit_turns(2, turns);
 
@@ -353,7 +440,9 @@ std::cout << "traverse" << std::endl;
         // Traverse through intersection/turn points and create rings of them.
         // Note that these rings are always in clockwise order, even in CCW polygons,
         // and are marked as "to be reversed" below
-        ring_container_type rings;
+        detail::statistics::phase_timer traverse_timer(statistics,
+                overlay_statistics::phase_traverse);
+        ring_container_type rings(detail::arena::get_allocator<ring_type>(strategy));
         traverse<Reverse1, Reverse2, Geometry1, Geometry2, OverlayType>::apply
                 (
                     geometry1, geometry2,
@@ -367,6 +456,11 @@ std::cout << "traverse" << std::endl;
         visitor.visit_turns(3, turns);
 
         get_ring_turn_info<OverlayType>(turn_info_per_ring, turns, clusters);
+        traverse_timer.stop();
+        if (statistics != 0)
+        {
+            statistics->traversed_rings += rings.size();
+        }
 
         typedef typename Strategy::template area_strategy<point_type>::type area_strategy_type;
 
@@ -376,8 +470,17 @@ std::cout << "traverse" << std::endl;
                 typename area_strategy_type::template result_type<point_type>::type
             > properties;
 
+        typedef typename ring_map_type
+            <
+                Strategy, properties
+            >::type ring_properties_map;
+
+        detail::statistics::phase_timer assign_parents_timer(statistics,
+                overlay_statistics::phase_assign_parents);
+
         // Select all rings which are NOT touched by any intersection point
-        std::map<ring_identifier, properties> selected_ring_properties;
+        ring_properties_map selected_ring_properties(
+            detail::arena::get_allocator<typename ring_properties_map::value_type>(strategy));
         select_rings<OverlayType>(geometry1, geometry2, turn_info_per_ring,
                 selected_ring_properties, strategy);
 
@@ -398,6 +501,10 @@ std::cout << "traverse" << std::endl;
 
         assign_parents<OverlayType>(geometry1, geometry2,
             rings, selected_ring_properties, strategy);
+        assign_parents_timer.stop();
+
+        detail::statistics::phase_timer const add_rings_timer(statistics,
+                overlay_statistics::phase_add_rings);
 
         // NOTE: There is no need to check result area for union because
         // as long as the polygons in the input are valid the resulting
@@ -0,0 +1,393 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_RING_TABLE_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_RING_TABLE_HPP
+
+
+#include <cstddef>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/geometry/core/assert.hpp>
+
+#include <boost/geometry/algorithms/detail/ring_identifier.hpp>
+
+#include <boost/geometry/util/monotonic_arena.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace overlay
+{
+
+
+template <typename Table, typename Value>
+class ring_table_iterator
+    : public boost::iterator_facade
+        <
+            ring_table_iterator<Table, Value>,
+            Value,
+            boost::forward_traversal_tag
+        >
+{
+public :
+    inline ring_table_iterator()
+        : m_table(0)
+        , m_source(0)
+        , m_row(0)
+        , m_pos(0)
+    {}
+
+    inline ring_table_iterator(Table* table, std::size_t source,
+                               std::size_t row, std::size_t pos)
+        : m_table(table)
+        , m_source(source)
+        , m_row(row)
+        , m_pos(pos)
+    {}
+
+    // Conversion from iterator to const_iterator
+    template <typename OtherTable, typename OtherValue>
+    inline ring_table_iterator(ring_table_iterator<OtherTable, OtherValue> const& other,
+            typename boost::enable_if_c
+                <
+                    boost::is_convertible<OtherTable*, Table*>::value
+                >::type* = 0)
+        : m_table(other.m_table)
+        , m_source(other.m_source)
+        , m_row(other.m_row)
+        , m_pos(other.m_pos)
+    {}
+
+    // Moves to the first used slot, starting at the current position
+    inline void skip_unused()
+    {
+        while (m_source < m_table->m_rows.size())
+        {
+            typename Table::row_vector const& rows = m_table->m_rows[m_source];
+            while (m_row < rows.size())
+            {
+                typename Table::row const& r = rows[m_row];
+                for ( ; m_pos < r.count; m_pos++)
+                {
+                    if (m_table->m_slots[r.offset + m_pos] != Table::unused())
+                    {
+                        return;
+                    }
+                }
+                m_pos = 0;
+                m_row++;
+            }
+            m_row = 0;
+            m_source++;
+        }
+    }
+
+private :
+    friend class boost::iterator_core_access;
+
+    template <typename OtherTable, typename OtherValue>
+    friend class ring_table_iterator;
+
+    inline Value& dereference() const
+    {
+        typename Table::row const& r = m_table->m_rows[m_source][m_row];
+        return m_table->m_values[m_table->m_slots[r.offset + m_pos]];
+    }
+
+    template <typename OtherTable, typename OtherValue>
+    inline bool equal(ring_table_iterator<OtherTable, OtherValue> const& other) const
+    {
+        return m_source == other.m_source
+            && m_row == other.m_row
+            && m_pos == other.m_pos;
+    }
+
+    inline void increment()
+    {
+        m_pos++;
+        skip_unused();
+    }
+
+    Table* m_table;
+    std::size_t m_source;
+    std::size_t m_row;
+    std::size_t m_pos;
+};
+
+
+/*!
+\brief Table of properties per ring, replacing std::map<ring_identifier, T>
+\details Ring identifiers are small dense integers, so the values are found
+    by indexing: per source index, a row per multi index, and in the row a
+    slot per ring index. The slots of all rows are kept in one vector and
+    contain the position of the value in the vector of values. A row growing
+    beyond its size is moved to the end of the slots, or extended in place
+    if it is already there, which is usually the case because the rings of
+    a geometry are added in order.
+    The interface is the subset of the interface of std::map used by overlay.
+    Iteration is in the order of the ring identifiers, as for std::map.
+\note Unlike for std::map, adding a ring invalidates the references to the
+    values and the iterators.
+*/
+template <typename T, typename Allocator = std::allocator<T> >
+class ring_table
+{
+public :
+    typedef ring_identifier key_type;
+    typedef T mapped_type;
+    typedef std::pair<ring_identifier, T> value_type;
+    typedef std::size_t size_type;
+    typedef typename geometry::detail::rebind_allocator
+        <
+            Allocator, value_type
+        >::type allocator_type;
+
+    typedef ring_table_iterator<ring_table, value_type> iterator;
+    typedef ring_table_iterator<ring_table const, value_type const> const_iterator;
+
+private :
+    template <typename Table, typename Value>
+    friend class ring_table_iterator;
+
+    struct row
+    {
+        inline row()
+            : offset(0)
+            , count(0)
+        {}
+
+        std::size_t offset;
+        std::size_t count;
+    };
+
+    typedef std::vector
+        <
+            row,
+            typename geometry::detail::rebind_allocator<Allocator, row>::type
+        > row_vector;
+
+    typedef std::vector
+        <
+            row_vector,
+            typename geometry::detail::rebind_allocator<Allocator, row_vector>::type
+        > source_vector;
+
+    typedef std::vector
+        <
+            std::size_t,
+            typename geometry::detail::rebind_allocator<Allocator, std::size_t>::type
+        > slot_vector;
+
+    typedef std::vector<value_type, allocator_type> value_vector;
+
+    static inline std::size_t unused()
+    {
+        return static_cast<std::size_t>(-1);
+    }
+
+public :
+    inline ring_table()
+    {}
+
+    explicit inline ring_table(allocator_type const& allocator)
+        : m_rows(typename source_vector::allocator_type(allocator))
+        , m_slots(typename slot_vector::allocator_type(allocator))
+        , m_values(allocator)
+    {}
+
+    inline iterator begin()
+    {
+        iterator it(this, 0, 0, 0);
+        it.skip_unused();
+        return it;
+    }
+
+    inline const_iterator begin() const
+    {
+        const_iterator it(this, 0, 0, 0);
+        it.skip_unused();
+        return it;
+    }
+
+    inline iterator end()
+    {
+        return iterator(this, m_rows.size(), 0, 0);
+    }
+
+    inline const_iterator end() const
+    {
+        return const_iterator(this, m_rows.size(), 0, 0);
+    }
+
+    inline iterator find(ring_identifier const& id)
+    {
+        return find_slot(id) != unused() ? position(id) : end();
+    }
+
+    inline const_iterator find(ring_identifier const& id) const
+    {
+        return find_slot(id) != unused() ? position(id) : end();
+    }
+
+    inline size_type count(ring_identifier const& id) const
+    {
+        return find_slot(id) != unused() ? 1 : 0;
+    }
+
+    inline std::pair<iterator, bool> insert(value_type const& value)
+    {
+        std::size_t& slot = get_slot(value.first);
+        bool const inserted = slot == unused();
+        if (inserted)
+        {
+            slot = m_values.size();
+            m_values.push_back(value);
+        }
+        return std::make_pair(position(value.first), inserted);
+    }
+
+    inline T& operator[](ring_identifier const& id)
+    {
+        std::size_t& slot = get_slot(id);
+        if (slot == unused())
+        {
+            slot = m_values.size();
+            m_values.push_back(value_type(id, T()));
+        }
+        return m_values[slot].second;
+    }
+
+    inline size_type size() const
+    {
+        return m_values.size();
+    }
+
+    inline bool empty() const
+    {
+        return m_values.empty();
+    }
+
+    inline void clear()
+    {
+        m_rows.clear();
+        m_slots.clear();
+        m_values.clear();
+    }
+
+    inline allocator_type get_allocator() const
+    {
+        return m_values.get_allocator();
+    }
+
+private :
+    static inline std::size_t row_index(ring_identifier const& id)
+    {
+        return static_cast<std::size_t>(id.multi_index + 1);
+    }
+
+    static inline std::size_t pos_index(ring_identifier const& id)
+    {
+        return static_cast<std::size_t>(id.ring_index + 1);
+    }
+
+    inline iterator position(ring_identifier const& id)
+    {
+        return iterator(this, static_cast<std::size_t>(id.source_index),
+                        row_index(id), pos_index(id));
+    }
+
+    inline const_iterator position(ring_identifier const& id) const
+    {
+        return const_iterator(this, static_cast<std::size_t>(id.source_index),
+                              row_index(id), pos_index(id));
+    }
+
+    inline std::size_t find_slot(ring_identifier const& id) const
+    {
+        std::size_t const source = static_cast<std::size_t>(id.source_index);
+        if (id.source_index < 0 || source >= m_rows.size())
+        {
+            return unused();
+        }
+        row_vector const& rows = m_rows[source];
+        std::size_t const r = row_index(id);
+        if (r >= rows.size())
+        {
+            return unused();
+        }
+        std::size_t const pos = pos_index(id);
+        return pos < rows[r].count ? m_slots[rows[r].offset + pos] : unused();
+    }
+
+    inline std::size_t& get_slot(ring_identifier const& id)
+    {
+        BOOST_GEOMETRY_ASSERT(id.source_index >= 0
+                              && id.multi_index >= -1
+                              && id.ring_index >= -1);
+
+        std::size_t const source = static_cast<std::size_t>(id.source_index);
+        if (source >= m_rows.size())
+        {
+            m_rows.resize(source + 1,
+                row_vector(typename row_vector::allocator_type(m_values.get_allocator())));
+        }
+
+        row_vector& rows = m_rows[source];
+        std::size_t const ri = row_index(id);
+        if (ri >= rows.size())
+        {
+            rows.resize(ri + 1);
+        }
+
+        row& r = rows[ri];
+        std::size_t const pos = pos_index(id);
+        if (pos >= r.count)
+        {
+            std::size_t const count = (std::max)(pos + 1, r.count * 2);
+            if (r.count > 0 && r.offset + r.count == m_slots.size())
+            {
+                // The row is the last one, extend it in place
+                m_slots.resize(r.offset + count, unused());
+            }
+            else
+            {
+                // Move the row to the end, its old slots are not used anymore
+                std::size_t const offset = m_slots.size();
+                m_slots.resize(offset + count, unused());
+                std::copy(m_slots.begin() + r.offset,
+                          m_slots.begin() + r.offset + r.count,
+                          m_slots.begin() + offset);
+                r.offset = offset;
+            }
+            r.count = count;
+        }
+        return m_slots[r.offset + pos];
+    }
+
+    source_vector m_rows;
+    slot_vector m_slots;
+    value_vector m_values;
+};
+
+
+}} // namespace detail::overlay
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_RING_TABLE_HPP
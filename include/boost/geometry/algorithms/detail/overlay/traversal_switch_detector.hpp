@@ -23,6 +23,7 @@
 #include <boost/geometry/algorithms/detail/overlay/copy_segments.hpp>
 #include <boost/geometry/algorithms/detail/overlay/cluster_info.hpp>
 #include <boost/geometry/algorithms/detail/overlay/is_self_turn.hpp>
+#include <boost/geometry/algorithms/detail/overlay/ring_table.hpp>
 #include <boost/geometry/algorithms/detail/overlay/turn_info.hpp>
 #include <boost/geometry/core/access.hpp>
 #include <boost/geometry/core/assert.hpp>
@@ -116,7 +117,7 @@ struct traversal_switch_detector
     };
 
     // Keeps turn indices per ring
-    typedef std::map<ring_identifier, merged_ring_properties > merge_map;
+    typedef ring_table<merged_ring_properties> merge_map;
     typedef std::map<signed_size_type, region_properties> region_connection_map;
 
     typedef set_type::const_iterator set_iterator;
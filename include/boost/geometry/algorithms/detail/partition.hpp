@@ -17,11 +17,15 @@
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_PARTITION_HPP
 
 #include <cstddef>
+#include <deque>
+#include <utility>
 #include <vector>
 #include <boost/range.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/geometry/core/access.hpp>
 #include <boost/geometry/core/coordinate_type.hpp>
 #include <boost/geometry/algorithms/assign.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 
 namespace boost { namespace geometry
@@ -105,6 +109,84 @@ inline void expand_with_elements(Box& total, IteratorVector const& input,
 }
 
 
+// Collects the pairs of iterators of the visited items in the order of
+// visiting, used to pass them to the actual visitor later
+template <typename Iterator1, typename Iterator2>
+struct visits_collector
+{
+    typedef std::vector<std::pair<Iterator1, Iterator2> > visits_type;
+
+    visits_type visits;
+};
+
+template <typename VisitPolicy, typename Iterator1, typename Iterator2>
+inline bool visit_pair(VisitPolicy& visitor,
+                       Iterator1 const& it1, Iterator2 const& it2)
+{
+    return visitor.apply(*it1, *it2);
+}
+
+template <typename Iterator1, typename Iterator2>
+inline bool visit_pair(visits_collector<Iterator1, Iterator2>& collector,
+                       Iterator1 const& it1, Iterator2 const& it2)
+{
+    collector.visits.push_back(std::make_pair(it1, it2));
+    return true;
+}
+
+template <typename Collector, typename VisitPolicy>
+inline bool visit_collected(Collector const& collector, VisitPolicy& visitor)
+{
+    typedef typename Collector::visits_type::const_iterator it_type;
+    for (it_type it = collector.visits.begin(); it != collector.visits.end(); ++it)
+    {
+        if (! visit_pair(visitor, it->first, it->second))
+        {
+            return false; // interrupt
+        }
+    }
+    return true;
+}
+
+// Keeps the iterator vectors of all levels of the recursion so they are
+// reused by the subsequent divisions at the same level instead of being
+// allocated at each of them
+template <typename IteratorVector>
+class iterator_vector_pool
+{
+public :
+    // Returns the cleared vector of the level, index is in [0, 3)
+    inline IteratorVector& get(std::size_t level, std::size_t index)
+    {
+        std::size_t const i = level * 3 + index;
+        if (i >= m_vectors.size())
+        {
+            // deque doesn't invalidate references to the existing vectors
+            m_vectors.resize(i + 1);
+        }
+        m_vectors[i].clear();
+        return m_vectors[i];
+    }
+
+private :
+    std::deque<IteratorVector> m_vectors;
+};
+
+template <typename IteratorVector1, typename IteratorVector2>
+struct partition_state
+{
+    partition_state(std::size_t threads_, std::size_t min_parallel_elements_)
+        : threads(threads_)
+        , min_parallel_elements(min_parallel_elements_)
+    {}
+
+    iterator_vector_pool<IteratorVector1> pool1;
+    iterator_vector_pool<IteratorVector2> pool2;
+    // The number of threads this part of the recursion may use
+    std::size_t threads;
+    std::size_t min_parallel_elements;
+};
+
 // Match forward_range with itself
 template <typename IteratorVector, typename VisitPolicy>
 inline bool handle_one(IteratorVector const& input, VisitPolicy& visitor)
@@ -122,7 +204,7 @@ inline bool handle_one(IteratorVector const& input, VisitPolicy& visitor)
         it_type it2 = it1;
         for (++it2; it2 != boost::end(input); ++it2)
         {
-            if (! visitor.apply(**it1, **it2))
+            if (! visit_pair(visitor, *it1, *it2))
             {
                 return false; // interrupt
             }
@@ -166,7 +248,7 @@ inline bool handle_two(IteratorVector1 const& input1,
             it2 != boost::end(input2);
             ++it2)
         {
-            if (! visitor.apply(**it1, **it2))
+            if (! visit_pair(visitor, *it1, *it2))
             {
                 return false; // interrupt
             }
@@ -209,6 +291,101 @@ inline bool recurse_ok(IteratorVector1 const& input1,
 }
 
 
+struct visit_no_policy
+{
+    template <typename Box>
+    static inline void apply(Box const&, std::size_t )
+    {}
+};
+
+// Calls the visitor for the items of a part in the calling thread
+template <typename Part, typename VisitPolicy, typename VisitBoxPolicy, typename State>
+struct visit_part
+{
+    visit_part(Part const& p, VisitPolicy& v, VisitBoxPolicy& bp, State& s)
+        : part(p), visitor(v), box_policy(bp), state(s), result(true)
+    {}
+
+    inline void operator()()
+    {
+        result = part.apply(visitor, box_policy, state);
+    }
+
+    Part const& part;
+    VisitPolicy& visitor;
+    VisitBoxPolicy& box_policy;
+    State& state;
+    bool result;
+};
+
+// Collects the visits of the items of a part, in a separate thread
+template <typename Part, typename Collector, typename State>
+struct collect_part
+{
+    collect_part(Part const& p, std::size_t t, std::size_t m)
+        : part(p), threads(t), min_parallel_elements(m)
+    {}
+
+    inline void operator()()
+    {
+        State state(threads, min_parallel_elements);
+        visit_no_policy box_policy;
+        part.apply(collector, box_policy, state);
+    }
+
+    Part const& part;
+    std::size_t threads;
+    std::size_t min_parallel_elements;
+    Collector collector;
+};
+
+// Visits the items of the lower part and then of the upper part.
+// If there are threads left the upper part is divided in a separate thread
+// while the lower part is visited in the calling thread. The visits of the
+// upper part are collected and passed to the visitor afterwards, so the
+// visitor is called only by the calling thread and in the same order as
+// sequentially. The expand and overlaps policies are called concurrently.
+template
+<
+    typename Collector,
+    typename LowerPart,
+    typename UpperPart,
+    typename VisitPolicy,
+    typename VisitBoxPolicy,
+    typename State
+>
+inline bool visit_parts(LowerPart const& lower, UpperPart const& upper,
+                        std::size_t upper_size,
+                        VisitPolicy& visitor,
+                        VisitBoxPolicy& box_policy,
+                        State& state)
+{
+    // The boxes of the upper part wouldn't be visited in the right order
+    if (state.threads > 1
+        && upper_size >= state.min_parallel_elements
+        && boost::is_same<VisitBoxPolicy, visit_no_policy>::value)
+    {
+        std::size_t const threads = state.threads;
+        std::size_t const upper_threads = threads / 2;
+
+        collect_part<UpperPart, Collector, State>
+            upper_collect(upper, upper_threads, state.min_parallel_elements);
+        visit_part<LowerPart, VisitPolicy, VisitBoxPolicy, State>
+            lower_visit(lower, visitor, box_policy, state);
+
+        state.threads = threads - upper_threads;
+        geometry::detail::parallel::invoke(upper_collect, lower_visit);
+        state.threads = threads;
+
+        return lower_visit.result
+            && visit_collected(upper_collect.collector, visitor);
+    }
+
+    return lower.apply(visitor, box_policy, state)
+        && upper.apply(visitor, box_policy, state);
+}
+
+
 template <int Dimension, typename Box>
 class partition_two_ranges;
 
@@ -232,7 +409,8 @@ class partition_one_range
         typename VisitPolicy,
         typename ExpandPolicy,
         typename OverlapsPolicy,
-        typename VisitBoxPolicy
+        typename VisitBoxPolicy,
+        typename State
     >
     static inline bool next_level(Box const& box,
                                   IteratorVector const& input,
@@ -240,7 +418,8 @@ class partition_one_range
                                   VisitPolicy& visitor,
                                   ExpandPolicy const& expand_policy,
                                   OverlapsPolicy const& overlaps_policy,
-                                  VisitBoxPolicy& box_policy)
+                                  VisitBoxPolicy& box_policy,
+                                  State& state)
     {
         if (recurse_ok(input, min_elements, level))
         {
@@ -249,7 +428,8 @@ class partition_one_range
                     1 - Dimension,
                     Box
                 >::apply(box, input, level + 1, min_elements,
-                         visitor, expand_policy, overlaps_policy, box_policy);
+                         visitor, expand_policy, overlaps_policy, box_policy,
+                         state);
         }
         else
         {
@@ -265,7 +445,8 @@ class partition_one_range
         typename VisitPolicy,
         typename ExpandPolicy,
         typename OverlapsPolicy,
-        typename VisitBoxPolicy
+        typename VisitBoxPolicy,
+        typename State
     >
     static inline bool next_level2(Box const& box,
                                    IteratorVector const& input1,
@@ -274,7 +455,8 @@ class partition_one_range
                                    VisitPolicy& visitor,
                                    ExpandPolicy const& expand_policy,
                                    OverlapsPolicy const& overlaps_policy,
-                                   VisitBoxPolicy& box_policy)
+                                   VisitBoxPolicy& box_policy,
+                                   State& state)
     {
         if (recurse_ok(input1, input2, min_elements, level))
         {
@@ -283,7 +465,8 @@ class partition_one_range
                     1 - Dimension, Box
                 >::apply(box, input1, input2, level + 1, min_elements,
                          visitor, expand_policy, overlaps_policy,
-                         expand_policy, overlaps_policy, box_policy);
+                         expand_policy, overlaps_policy, box_policy,
+                         state);
         }
         else
         {
@@ -291,6 +474,39 @@ class partition_one_range
         }
     }
 
+    // The lower or upper part of the input, passed to visit_parts()
+    template
+    <
+        typename IteratorVector,
+        typename ExpandPolicy,
+        typename OverlapsPolicy
+    >
+    struct part
+    {
+        part(Box const& b, IteratorVector const& i,
+             std::size_t l, std::size_t m,
+             ExpandPolicy const& ep, OverlapsPolicy const& op)
+            : box(b), input(i), level(l), min_elements(m)
+            , expand_policy(ep), overlaps_policy(op)
+        {}
+
+        template <typename VisitPolicy, typename VisitBoxPolicy, typename State>
+        inline bool apply(VisitPolicy& visitor, VisitBoxPolicy& box_policy,
+                          State& state) const
+        {
+            return next_level(box, input, level, min_elements,
+                              visitor, expand_policy, overlaps_policy,
+                              box_policy, state);
+        }
+
+        Box const& box;
+        IteratorVector const& input;
+        std::size_t level;
+        std::size_t min_elements;
+        ExpandPolicy const& expand_policy;
+        OverlapsPolicy const& overlaps_policy;
+    };
+
 public :
     template
     <
@@ -298,7 +514,8 @@ public :
         typename VisitPolicy,
         typename ExpandPolicy,
         typename OverlapsPolicy,
-        typename VisitBoxPolicy
+        typename VisitBoxPolicy,
+        typename State
     >
     static inline bool apply(Box const& box,
                              IteratorVector const& input,
@@ -307,14 +524,17 @@ public :
                              VisitPolicy& visitor,
                              ExpandPolicy const& expand_policy,
                              OverlapsPolicy const& overlaps_policy,
-                             VisitBoxPolicy& box_policy)
+                             VisitBoxPolicy& box_policy,
+                             State& state)
     {
         box_policy.apply(box, level);
 
         Box lower_box, upper_box;
         divide_box<Dimension>(box, lower_box, upper_box);
 
-        IteratorVector lower, upper, exceeding;
+        IteratorVector& lower = state.pool1.get(level, 0);
+        IteratorVector& upper = state.pool1.get(level, 1);
+        IteratorVector& exceeding = state.pool1.get(level, 2);
         divide_into_subsets(lower_box, upper_box,
                             input, lower, upper, exceeding,
                             overlaps_policy);
@@ -327,23 +547,31 @@ public :
                    // Recursively do exceeding elements only, in next dimension they
                    // will probably be less exceeding within the new box
             if (! (next_level(exceeding_box, exceeding, level, min_elements,
-                              visitor, expand_policy, overlaps_policy, box_policy)
+                              visitor, expand_policy, overlaps_policy, box_policy,
+                              state)
                    // Switch to two forward ranges, combine exceeding with
                    // lower resp upper, but not lower/lower, upper/upper
                 && next_level2(exceeding_box, exceeding, lower, level, min_elements,
-                               visitor, expand_policy, overlaps_policy, box_policy)
+                               visitor, expand_policy, overlaps_policy, box_policy,
+                               state)
                 && next_level2(exceeding_box, exceeding, upper, level, min_elements,
-                               visitor, expand_policy, overlaps_policy, box_policy)) )
+                               visitor, expand_policy, overlaps_policy, box_policy,
+                               state)) )
             {
                 return false; // interrupt
             }
         }
 
         // Recursively call operation both parts
-        return next_level(lower_box, lower, level, min_elements,
-                          visitor, expand_policy, overlaps_policy, box_policy)
-            && next_level(upper_box, upper, level, min_elements,
-                          visitor, expand_policy, overlaps_policy, box_policy);
+        typedef typename boost::range_value<IteratorVector>::type iterator_type;
+        typedef part<IteratorVector, ExpandPolicy, OverlapsPolicy> part_type;
+
+        return visit_parts<visits_collector<iterator_type, iterator_type> >(
+                    part_type(lower_box, lower, level, min_elements,
+                              expand_policy, overlaps_policy),
+                    part_type(upper_box, upper, level, min_elements,
+                              expand_policy, overlaps_policy),
+                    boost::size(upper), visitor, box_policy, state);
     }
 };
 
@@ -363,7 +591,8 @@ class partition_two_ranges
         typename OverlapsPolicy1,
         typename ExpandPolicy2,
         typename OverlapsPolicy2,
-        typename VisitBoxPolicy
+        typename VisitBoxPolicy,
+        typename State
     >
     static inline bool next_level(Box const& box,
                                   IteratorVector1 const& input1,
@@ -374,14 +603,16 @@ class partition_two_ranges
                                   OverlapsPolicy1 const& overlaps_policy1,
                                   ExpandPolicy2 const& expand_policy2,
                                   OverlapsPolicy2 const& overlaps_policy2,
-                                  VisitBoxPolicy& box_policy)
+                                  VisitBoxPolicy& box_policy,
+                                  State& state)
     {
         return partition_two_ranges
             <
                 1 - Dimension, Box
             >::apply(box, input1, input2, level + 1, min_elements,
                      visitor, expand_policy1, overlaps_policy1,
-                     expand_policy2, overlaps_policy2, box_policy);
+                     expand_policy2, overlaps_policy2, box_policy,
+                     state);
     }
 
     template <typename IteratorVector, typename ExpandPolicy>
@@ -409,6 +640,56 @@ class partition_two_ranges
         return box;
     }
 
+    // The lower or upper parts of both inputs, passed to visit_parts()
+    template
+    <
+        typename IteratorVector1,
+        typename IteratorVector2,
+        typename ExpandPolicy1,
+        typename OverlapsPolicy1,
+        typename ExpandPolicy2,
+        typename OverlapsPolicy2
+    >
+    struct part
+    {
+        part(Box const& b,
+             IteratorVector1 const& i1, IteratorVector2 const& i2,
+             std::size_t l, std::size_t m,
+             ExpandPolicy1 const& ep1, OverlapsPolicy1 const& op1,
+             ExpandPolicy2 const& ep2, OverlapsPolicy2 const& op2)
+            : box(b), input1(i1), input2(i2), level(l), min_elements(m)
+            , expand_policy1(ep1), overlaps_policy1(op1)
+            , expand_policy2(ep2), overlaps_policy2(op2)
+        {}
+
+        template <typename VisitPolicy, typename VisitBoxPolicy, typename State>
+        inline bool apply(VisitPolicy& visitor, VisitBoxPolicy& box_policy,
+                          State& state) const
+        {
+            if (recurse_ok(input1, input2, min_elements, level))
+            {
+                return next_level(box, input1, input2, level,
+                                  min_elements, visitor, expand_policy1, overlaps_policy1,
+                                  expand_policy2, overlaps_policy2, box_policy,
+                                  state);
+            }
+            else
+            {
+                return handle_two(input1, input2, visitor);
+            }
+        }
+
+        Box const& box;
+        IteratorVector1 const& input1;
+        IteratorVector2 const& input2;
+        std::size_t level;
+        std::size_t min_elements;
+        ExpandPolicy1 const& expand_policy1;
+        OverlapsPolicy1 const& overlaps_policy1;
+        ExpandPolicy2 const& expand_policy2;
+        OverlapsPolicy2 const& overlaps_policy2;
+    };
+
 public :
     template
     <
@@ -419,7 +700,8 @@ public :
         typename OverlapsPolicy1,
         typename ExpandPolicy2,
         typename OverlapsPolicy2,
-        typename VisitBoxPolicy
+        typename VisitBoxPolicy,
+        typename State
     >
     static inline bool apply(Box const& box,
                              IteratorVector1 const& input1,
@@ -431,15 +713,20 @@ public :
                              OverlapsPolicy1 const& overlaps_policy1,
                              ExpandPolicy2 const& expand_policy2,
                              OverlapsPolicy2 const& overlaps_policy2,
-                             VisitBoxPolicy& box_policy)
+                             VisitBoxPolicy& box_policy,
+                             State& state)
     {
         box_policy.apply(box, level);
 
         Box lower_box, upper_box;
         divide_box<Dimension>(box, lower_box, upper_box);
 
-        IteratorVector1 lower1, upper1, exceeding1;
-        IteratorVector2 lower2, upper2, exceeding2;
+        IteratorVector1& lower1 = state.pool1.get(level, 0);
+        IteratorVector1& upper1 = state.pool1.get(level, 1);
+        IteratorVector1& exceeding1 = state.pool1.get(level, 2);
+        IteratorVector2& lower2 = state.pool2.get(level, 0);
+        IteratorVector2& upper2 = state.pool2.get(level, 1);
+        IteratorVector2& exceeding2 = state.pool2.get(level, 2);
         divide_into_subsets(lower_box, upper_box,
                             input1, lower1, upper1, exceeding1,
                             overlaps_policy1);
@@ -457,7 +744,7 @@ public :
                                                 expand_policy1, expand_policy2);
                 if (! next_level(exceeding_box, exceeding1, exceeding2, level,
                                  min_elements, visitor, expand_policy1, overlaps_policy1,
-                                 expand_policy2, overlaps_policy2, box_policy))
+                                 expand_policy2, overlaps_policy2, box_policy, state))
                 {
                     return false; // interrupt
                 }
@@ -479,10 +766,10 @@ public :
                 Box exceeding_box = get_new_box(exceeding1, expand_policy1);
                 if (! (next_level(exceeding_box, exceeding1, lower2, level,
                                   min_elements, visitor, expand_policy1, overlaps_policy1,
-                                  expand_policy2, overlaps_policy2, box_policy)
+                                  expand_policy2, overlaps_policy2, box_policy, state)
                     && next_level(exceeding_box, exceeding1, upper2, level,
                                   min_elements, visitor, expand_policy1, overlaps_policy1,
-                                  expand_policy2, overlaps_policy2, box_policy)) )
+                                  expand_policy2, overlaps_policy2, box_policy, state)) )
                 {
                     return false; // interrupt
                 }
@@ -505,10 +792,10 @@ public :
                 Box exceeding_box = get_new_box(exceeding2, expand_policy2);
                 if (! (next_level(exceeding_box, lower1, exceeding2, level,
                                   min_elements, visitor, expand_policy1, overlaps_policy1,
-                                  expand_policy2, overlaps_policy2, box_policy)
+                                  expand_policy2, overlaps_policy2, box_policy, state)
                     && next_level(exceeding_box, upper1, exceeding2, level,
                                   min_elements, visitor, expand_policy1, overlaps_policy1,
-                                  expand_policy2, overlaps_policy2, box_policy)) )
+                                  expand_policy2, overlaps_policy2, box_policy, state)) )
                 {
                     return false; // interrupt
                 }
@@ -523,51 +810,27 @@ public :
             }
         }
 
-        if (recurse_ok(lower1, lower2, min_elements, level))
-        {
-            if (! next_level(lower_box, lower1, lower2, level,
-                             min_elements, visitor, expand_policy1, overlaps_policy1,
-                             expand_policy2, overlaps_policy2, box_policy) )
-            {
-                return false; // interrupt
-            }
-        }
-        else
-        {
-            if (! handle_two(lower1, lower2, visitor))
-            {
-                return false; // interrupt
-            }
-        }
-
-        if (recurse_ok(upper1, upper2, min_elements, level))
-        {
-            if (! next_level(upper_box, upper1, upper2, level,
-                             min_elements, visitor, expand_policy1, overlaps_policy1,
-                             expand_policy2, overlaps_policy2, box_policy) )
-            {
-                return false; // interrupt
-            }
-        }
-        else
-        {
-            if (! handle_two(upper1, upper2, visitor))
-            {
-                return false; // interrupt
-            }
-        }
-
-        return true;
+        typedef typename boost::range_value<IteratorVector1>::type iterator_type1;
+        typedef typename boost::range_value<IteratorVector2>::type iterator_type2;
+        typedef part
+            <
+                IteratorVector1, IteratorVector2,
+                ExpandPolicy1, OverlapsPolicy1,
+                ExpandPolicy2, OverlapsPolicy2
+            > part_type;
+
+        return visit_parts<visits_collector<iterator_type1, iterator_type2> >(
+                    part_type(lower_box, lower1, lower2, level, min_elements,
+                              expand_policy1, overlaps_policy1,
+                              expand_policy2, overlaps_policy2),
+                    part_type(upper_box, upper1, upper2, level, min_elements,
+                              expand_policy1, overlaps_policy1,
+                              expand_policy2, overlaps_policy2),
+                    boost::size(upper1) + boost::size(upper2),
+                    visitor, box_policy, state);
     }
 };
 
-struct visit_no_policy
-{
-    template <typename Box>
-    static inline void apply(Box const&, std::size_t )
-    {}
-};
-
 struct include_all_policy
 {
     template <typename Item>
@@ -588,8 +851,13 @@ template
 >
 class partition
 {
+public :
     static const std::size_t default_min_elements = 16;
 
+private :
+    // Minimal number of elements of a part divided in a separate thread
+    static const std::size_t min_parallel_elements = 4096;
+
     template
     <
         typename IncludePolicy,
@@ -663,6 +931,30 @@ public:
                              OverlapsPolicy const& overlaps_policy,
                              std::size_t min_elements,
                              VisitBoxPolicy box_visitor)
+    {
+        return apply(forward_range, visitor, expand_policy, overlaps_policy,
+                     min_elements, box_visitor,
+                     detail::parallel::hardware_concurrency());
+    }
+
+    // The parts of the input may be divided in at most the specified number
+    // of threads, the visitor is called only by the calling thread and in
+    // the same order as with one thread
+    template
+    <
+        typename ForwardRange,
+        typename VisitPolicy,
+        typename ExpandPolicy,
+        typename OverlapsPolicy,
+        typename VisitBoxPolicy
+    >
+    static inline bool apply(ForwardRange const& forward_range,
+                             VisitPolicy& visitor,
+                             ExpandPolicy const& expand_policy,
+                             OverlapsPolicy const& overlaps_policy,
+                             std::size_t min_elements,
+                             VisitBoxPolicy box_visitor,
+                             std::size_t threads)
     {
         typedef typename boost::range_iterator
             <
@@ -671,17 +963,25 @@ public:
 
         if (std::size_t(boost::size(forward_range)) > min_elements)
         {
-            std::vector<iterator_type> iterator_vector;
+            typedef std::vector<iterator_type> iterator_vector_type;
+            iterator_vector_type iterator_vector;
             Box total;
             assign_inverse(total);
             expand_to_range<IncludePolicy1>(forward_range, total,
                                             iterator_vector, expand_policy);
 
+            detail::partition::partition_state
+                <
+                    iterator_vector_type, iterator_vector_type
+                > state(detail::parallel::threads_count(threads),
+                        min_parallel_elements);
+
             return detail::partition::partition_one_range
                 <
                     0, Box
                 >::apply(total, iterator_vector, 0, min_elements,
-                         visitor, expand_policy, overlaps_policy, box_visitor);
+                         visitor, expand_policy, overlaps_policy, box_visitor,
+                         state);
         }
         else
         {
@@ -789,6 +1089,37 @@ public:
                              OverlapsPolicy2 const& overlaps_policy2,
                              std::size_t min_elements,
                              VisitBoxPolicy box_visitor)
+    {
+        return apply(forward_range1, forward_range2, visitor,
+                     expand_policy1, overlaps_policy1, expand_policy2, overlaps_policy2,
+                     min_elements, box_visitor,
+                     detail::parallel::hardware_concurrency());
+    }
+
+    // The parts of the inputs may be divided in at most the specified number
+    // of threads, the visitor is called only by the calling thread and in
+    // the same order as with one thread
+    template
+    <
+        typename ForwardRange1,
+        typename ForwardRange2,
+        typename VisitPolicy,
+        typename ExpandPolicy1,
+        typename OverlapsPolicy1,
+        typename ExpandPolicy2,
+        typename OverlapsPolicy2,
+        typename VisitBoxPolicy
+    >
+    static inline bool apply(ForwardRange1 const& forward_range1,
+                             ForwardRange2 const& forward_range2,
+                             VisitPolicy& visitor,
+                             ExpandPolicy1 const& expand_policy1,
+                             OverlapsPolicy1 const& overlaps_policy1,
+                             ExpandPolicy2 const& expand_policy2,
+                             OverlapsPolicy2 const& overlaps_policy2,
+                             std::size_t min_elements,
+                             VisitBoxPolicy box_visitor,
+                             std::size_t threads)
     {
         typedef typename boost::range_iterator
             <
@@ -803,8 +1134,10 @@ public:
         if (std::size_t(boost::size(forward_range1)) > min_elements
             && std::size_t(boost::size(forward_range2)) > min_elements)
         {
-            std::vector<iterator_type1> iterator_vector1;
-            std::vector<iterator_type2> iterator_vector2;
+            typedef std::vector<iterator_type1> iterator_vector_type1;
+            typedef std::vector<iterator_type2> iterator_vector_type2;
+            iterator_vector_type1 iterator_vector1;
+            iterator_vector_type2 iterator_vector2;
             Box total;
             assign_inverse(total);
             expand_to_range<IncludePolicy1>(forward_range1, total,
@@ -812,13 +1145,19 @@ public:
             expand_to_range<IncludePolicy2>(forward_range2, total,
                                             iterator_vector2, expand_policy2);
 
+            detail::partition::partition_state
+                <
+                    iterator_vector_type1, iterator_vector_type2
+                > state(detail::parallel::threads_count(threads),
+                        min_parallel_elements);
+
             return detail::partition::partition_two_ranges
                 <
                     0, Box
                 >::apply(total, iterator_vector1, iterator_vector2,
                          0, min_elements, visitor, expand_policy1,
                          overlaps_policy1, expand_policy2, overlaps_policy2,
-                         box_visitor);
+                         box_visitor, state);
         }
         else
         {
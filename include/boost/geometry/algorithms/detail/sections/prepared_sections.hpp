@@ -0,0 +1,105 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_SECTIONS_PREPARED_SECTIONS_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_DETAIL_SECTIONS_PREPARED_SECTIONS_HPP
+
+
+#include <boost/core/addressof.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace section
+{
+
+// Base of the strategies passing the sections of a geometry, calculated
+// once, to get_turns. There are sections for both orders of the rings
+// because difference reverses the second geometry.
+template <typename Geometry, typename Sections>
+class prepared_sections_holder
+{
+public :
+    inline prepared_sections_holder(Geometry const& geometry,
+                                    Sections const& sections,
+                                    Sections const& reversed_sections)
+        : m_geometry(boost::addressof(geometry))
+        , m_sections(boost::addressof(sections))
+        , m_reversed_sections(boost::addressof(reversed_sections))
+    {}
+
+    // Returns the sections if they were calculated for this geometry,
+    // otherwise null
+    template <bool Reverse>
+    inline Sections const* get_sections(Geometry const& geometry) const
+    {
+        return boost::addressof(geometry) != m_geometry ? 0
+             : Reverse ? m_reversed_sections
+             : m_sections;
+    }
+
+private :
+    Geometry const* m_geometry;
+    Sections const* m_sections;
+    Sections const* m_reversed_sections;
+};
+
+
+// Strategy behaving as the wrapped intersection Strategy, passing the
+// prepared sections to get_turns
+template <typename Strategy, typename Geometry, typename Sections>
+class with_prepared_sections
+    : public Strategy
+    , public prepared_sections_holder<Geometry, Sections>
+{
+public :
+    inline with_prepared_sections(Strategy const& strategy,
+                                  Geometry const& geometry,
+                                  Sections const& sections,
+                                  Sections const& reversed_sections)
+        : Strategy(strategy)
+        , prepared_sections_holder<Geometry, Sections>(geometry,
+                sections, reversed_sections)
+    {}
+};
+
+
+// The overloads taking pointers are chosen also for the strategies derived
+// from prepared_sections_holder, e.g. wrapped with other wrappers.
+// Sections is specified, so the sections of other types are not used.
+template <bool Reverse, typename Sections, typename Geometry>
+inline Sections const* prepared_sections_of(Geometry const& geometry,
+        prepared_sections_holder<Geometry, Sections> const* holder)
+{
+    return holder->template get_sections<Reverse>(geometry);
+}
+
+template <bool Reverse, typename Sections, typename Geometry>
+inline Sections const* prepared_sections_of(Geometry const& , void const* )
+{
+    return 0;
+}
+
+// Returns the sections of the geometry prepared by the strategy, if any
+template <bool Reverse, typename Sections, typename Geometry, typename Strategy>
+inline Sections const* prepared_sections(Geometry const& geometry,
+                                         Strategy const& strategy)
+{
+    return prepared_sections_of<Reverse, Sections>(geometry,
+                                    boost::addressof(strategy));
+}
+
+
+}} // namespace detail::section
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_DETAIL_SECTIONS_PREPARED_SECTIONS_HPP
@@ -31,6 +31,7 @@
 
 #include <boost/geometry/algorithms/detail/equals/point_point.hpp>
 #include <boost/geometry/algorithms/detail/interior_iterator.hpp>
+#include <boost/geometry/algorithms/detail/within/point_in_geometry_index.hpp>
 
 #include <boost/geometry/geometries/concepts/check.hpp>
 #include <boost/geometry/strategies/concepts/within_concept.hpp>
@@ -368,6 +369,13 @@ inline int point_in_geometry(Point const& point, Geometry const& geometry, Strat
 {
     concepts::within::check<Point, Geometry, Strategy>();
 
+    // Use the index of the geometry if it was prepared by the strategy
+    int result = 0;
+    if (detail::within::point_in_prepared_index(point, geometry, strategy, result))
+    {
+        return result;
+    }
+
     return detail_dispatch::within::point_in_geometry<Geometry>::apply(point, geometry, strategy);
 }
 
@@ -0,0 +1,469 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_WITHIN_POINT_IN_GEOMETRY_INDEX_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_DETAIL_WITHIN_POINT_IN_GEOMETRY_INDEX_HPP
+
+
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <boost/core/addressof.hpp>
+#include <boost/range.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/closure.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/exterior_ring.hpp>
+#include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/ring_type.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/algorithms/detail/interior_iterator.hpp>
+#include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/select_most_precise.hpp>
+#include <boost/geometry/views/detail/normalized_view.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace within
+{
+
+
+/*!
+\brief Index of the segments of an areal geometry, used to check the
+    position of many points with the winding strategy
+\details The winding strategy of the cartesian coordinate system counts
+    only the segments whose x-range contains the x-coordinate of the point.
+    The x-range of the geometry is divided into bands and each band lists
+    the segments overlapping it, extended by one band on both sides for
+    coordinates compared with a tolerance. A point is checked against the
+    segments of its band only, the result is the same as the result of
+    point_in_geometry for the geometry.
+    The segments of a band are listed in the order of the rings, so the
+    rings are checked one by one and combined as point_in_geometry does for
+    polygons and multi-polygons.
+*/
+template <typename Geometry>
+class point_in_geometry_index
+{
+    typedef typename geometry::point_type<Geometry>::type point_type;
+    typedef typename select_most_precise
+        <
+            typename geometry::coordinate_type<Geometry>::type,
+            double
+        >::type calculation_type;
+
+    struct segment
+    {
+        point_type first;
+        point_type second;
+        std::size_t ring;
+    };
+
+    struct ring_info
+    {
+        std::size_t polygon;
+        bool exterior;
+    };
+
+public :
+    inline point_in_geometry_index()
+        : m_min(0)
+        , m_scale(0)
+    {}
+
+    explicit inline point_in_geometry_index(Geometry const& geometry)
+        : m_min(0)
+        , m_scale(0)
+    {
+        build(geometry);
+    }
+
+    inline void build(Geometry const& geometry)
+    {
+        m_segments.clear();
+        m_rings.clear();
+        m_offsets.clear();
+        m_entries.clear();
+
+        add_rings(geometry, typename geometry::tag<Geometry>::type());
+        if (m_segments.empty())
+        {
+            return;
+        }
+
+        calculation_type min_x = get<0>(m_segments.front().first);
+        calculation_type max_x = min_x;
+        for (std::size_t i = 0; i < m_segments.size(); i++)
+        {
+            segment const& s = m_segments[i];
+            min_x = (std::min)(min_x, (std::min)(calculation_type(get<0>(s.first)),
+                                                 calculation_type(get<0>(s.second))));
+            max_x = (std::max)(max_x, (std::max)(calculation_type(get<0>(s.first)),
+                                                 calculation_type(get<0>(s.second))));
+        }
+
+        // The bands should be much wider than the tolerance of the coordinates
+        calculation_type const width = max_x - min_x;
+        calculation_type const tolerance
+            = std::numeric_limits<calculation_type>::epsilon()
+            * (std::max)(calculation_type(1),
+                         (std::max)(math::abs(min_x), math::abs(max_x)))
+            * 16;
+
+        std::size_t count = (std::max)(std::size_t(1), m_segments.size() / 4);
+        if (width <= tolerance)
+        {
+            count = 1;
+        }
+        else if (width / count < tolerance)
+        {
+            count = (std::max)(std::size_t(1),
+                               static_cast<std::size_t>(width / tolerance));
+        }
+
+        // Halve the number of bands until the segments spanning many bands
+        // don't take too much memory
+        std::size_t entry_count = 0;
+        for (;;)
+        {
+            m_min = min_x;
+            m_scale = count > 1 ? count / width : calculation_type(0);
+            m_offsets.assign(count + 1, 0);
+
+            entry_count = 0;
+            for (std::size_t i = 0; i < m_segments.size(); i++)
+            {
+                std::size_t first, last;
+                get_bands(m_segments[i], count, first, last);
+                entry_count += last - first + 1;
+            }
+            if (count == 1 || entry_count <= 16 * m_segments.size())
+            {
+                break;
+            }
+            count /= 2;
+        }
+
+        // Counting sort of the segments by band, keeping their order
+        for (std::size_t i = 0; i < m_segments.size(); i++)
+        {
+            std::size_t first, last;
+            get_bands(m_segments[i], count, first, last);
+            for (std::size_t b = first; b <= last; b++)
+            {
+                m_offsets[b + 1]++;
+            }
+        }
+        for (std::size_t b = 0; b < count; b++)
+        {
+            m_offsets[b + 1] += m_offsets[b];
+        }
+
+        std::vector<std::size_t> positions(m_offsets.begin(), m_offsets.end() - 1);
+        m_entries.resize(entry_count);
+        for (std::size_t i = 0; i < m_segments.size(); i++)
+        {
+            std::size_t first, last;
+            get_bands(m_segments[i], count, first, last);
+            for (std::size_t b = first; b <= last; b++)
+            {
+                m_entries[positions[b]++] = i;
+            }
+        }
+    }
+
+    // Returns 1 if the point is in the interior, 0 if it is on the boundary
+    // and -1 if it is in the exterior, as point_in_geometry
+    template <typename Point, typename Strategy>
+    inline int apply(Point const& point, Strategy const& strategy) const
+    {
+        std::size_t band = 0;
+        if (m_offsets.empty() || ! find_band(get<0>(point), band))
+        {
+            return -1;
+        }
+
+        std::size_t polygon = static_cast<std::size_t>(-1);
+        int code = -1;
+
+        std::size_t i = m_offsets[band];
+        std::size_t const end = m_offsets[band + 1];
+        while (i < end)
+        {
+            std::size_t const ring = m_segments[m_entries[i]].ring;
+            typename Strategy::state_type state;
+            for ( ; i < end && m_segments[m_entries[i]].ring == ring; i++)
+            {
+                segment const& s = m_segments[m_entries[i]];
+                if (! strategy.apply(point, s.first, s.second, state))
+                {
+                    // Skip the other segments of the ring
+                    while (i < end && m_segments[m_entries[i]].ring == ring)
+                    {
+                        i++;
+                    }
+                    break;
+                }
+            }
+
+            int const ring_code = strategy.result(state);
+            ring_info const& info = m_rings[ring];
+            if (info.polygon != polygon)
+            {
+                // The first polygon containing or touching the point decides
+                if (code >= 0)
+                {
+                    return code;
+                }
+                polygon = info.polygon;
+                // If the exterior ring is not listed the point is outside
+                code = info.exterior ? ring_code : -1;
+            }
+            else if (code == 1 && ring_code != -1)
+            {
+                // Inside (1) or on (0) an interior ring
+                code = -ring_code;
+            }
+        }
+        return code;
+    }
+
+private :
+    template <typename Ring>
+    inline void add_ring(Ring const& ring, std::size_t polygon, bool exterior)
+    {
+        if (boost::size(ring) < core_detail::closure::minimum_ring_size
+                                    <
+                                        geometry::closure<Ring>::value
+                                    >::value)
+        {
+            return;
+        }
+
+        ring_info info;
+        info.polygon = polygon;
+        info.exterior = exterior;
+        std::size_t const index = m_rings.size();
+        m_rings.push_back(info);
+
+        typedef detail::normalized_view<Ring const> view_type;
+        typedef typename boost::range_iterator<view_type const>::type iterator_type;
+
+        view_type view(ring);
+        iterator_type it = boost::begin(view);
+        iterator_type const end = boost::end(view);
+        for (iterator_type previous = it++; it != end; ++previous, ++it)
+        {
+            segment s;
+            s.first = *previous;
+            s.second = *it;
+            s.ring = index;
+            m_segments.push_back(s);
+        }
+    }
+
+    template <typename Polygon>
+    inline void add_polygon(Polygon const& polygon, std::size_t index)
+    {
+        add_ring(exterior_ring(polygon), index, true);
+
+        typename interior_return_type<Polygon const>::type
+            rings = interior_rings(polygon);
+        for (typename detail::interior_iterator<Polygon const>::type
+                it = boost::begin(rings); it != boost::end(rings); ++it)
+        {
+            add_ring(*it, index, false);
+        }
+    }
+
+    inline void add_rings(Geometry const& ring, ring_tag)
+    {
+        add_ring(ring, 0, true);
+    }
+
+    inline void add_rings(Geometry const& polygon, polygon_tag)
+    {
+        add_polygon(polygon, 0);
+    }
+
+    inline void add_rings(Geometry const& multi_polygon, multi_polygon_tag)
+    {
+        std::size_t index = 0;
+        for (typename boost::range_iterator<Geometry const>::type
+                it = boost::begin(multi_polygon);
+             it != boost::end(multi_polygon); ++it, ++index)
+        {
+            add_polygon(*it, index);
+        }
+    }
+
+    inline void get_bands(segment const& s, std::size_t count,
+                          std::size_t& first, std::size_t& last) const
+    {
+        calculation_type const x1 = get<0>(s.first);
+        calculation_type const x2 = get<0>(s.second);
+        first = band_of((std::min)(x1, x2), count);
+        last = band_of((std::max)(x1, x2), count);
+        first = first > 0 ? first - 1 : 0;
+        last = last + 1 < count ? last + 1 : count - 1;
+    }
+
+    // Band of a coordinate within the range of the geometry
+    inline std::size_t band_of(calculation_type const& x, std::size_t count) const
+    {
+        calculation_type const b = (x - m_min) * m_scale;
+        return b <= 0 ? 0
+             : b >= calculation_type(count) ? count - 1
+             : static_cast<std::size_t>(b);
+    }
+
+    // Returns false if the coordinate is more than one band outside the
+    // range of the geometry, no segment can be counted then
+    template <typename Coordinate>
+    inline bool find_band(Coordinate const& x, std::size_t& band) const
+    {
+        std::size_t const count = m_offsets.size() - 1;
+        calculation_type const b = (calculation_type(x) - m_min) * m_scale;
+        if (count > 1 && (b < -1 || b >= calculation_type(count + 1)))
+        {
+            return false;
+        }
+        band = band_of(calculation_type(x), count);
+        return true;
+    }
+
+    calculation_type m_min;
+    calculation_type m_scale;
+    std::vector<segment> m_segments;
+    std::vector<ring_info> m_rings;
+    // Per band the offset of its segments in the entries
+    std::vector<std::size_t> m_offsets;
+    std::vector<std::size_t> m_entries;
+};
+
+
+// Base of the strategies passing the index of a geometry, built once,
+// to point_in_geometry
+template <typename Geometry>
+class prepared_index_holder
+{
+public :
+    typedef point_in_geometry_index<Geometry> index_type;
+
+    inline prepared_index_holder(Geometry const& geometry,
+                                 index_type const& index)
+        : m_geometry(boost::addressof(geometry))
+        , m_index(boost::addressof(index))
+    {}
+
+    // Returns the index if it was built for this geometry, otherwise null
+    inline index_type const* get_index(Geometry const& geometry) const
+    {
+        return boost::addressof(geometry) != m_geometry ? 0 : m_index;
+    }
+
+private :
+    Geometry const* m_geometry;
+    index_type const* m_index;
+};
+
+
+// Point in geometry strategy behaving as the wrapped Strategy, passing
+// the prepared index to point_in_geometry
+template <typename Strategy, typename Geometry>
+class with_prepared_index
+    : public Strategy
+    , public prepared_index_holder<Geometry>
+{
+public :
+    inline with_prepared_index(Strategy const& strategy,
+                               Geometry const& geometry,
+                               point_in_geometry_index<Geometry> const& index)
+        : Strategy(strategy)
+        , prepared_index_holder<Geometry>(geometry, index)
+    {}
+};
+
+
+template <typename Geometry>
+inline point_in_geometry_index<Geometry> const* prepared_index_of(
+        Geometry const& geometry,
+        prepared_index_holder<Geometry> const* holder)
+{
+    return holder->get_index(geometry);
+}
+
+template <typename Geometry>
+inline point_in_geometry_index<Geometry> const* prepared_index_of(
+        Geometry const& , void const* )
+{
+    return 0;
+}
+
+// Returns the index of the geometry prepared by the strategy, if any
+template <typename Geometry, typename Strategy>
+inline point_in_geometry_index<Geometry> const* prepared_index(
+        Geometry const& geometry, Strategy const& strategy)
+{
+    return prepared_index_of(geometry, boost::addressof(strategy));
+}
+
+template <typename Point, typename Geometry, typename Strategy>
+inline bool point_in_prepared_index(Point const& point, Geometry const& geometry,
+                                    Strategy const& strategy, int& result,
+                                    boost::true_type)
+{
+    point_in_geometry_index<Geometry> const* index
+        = prepared_index(geometry, strategy);
+    if (index == 0)
+    {
+        return false;
+    }
+    result = index->apply(point, strategy);
+    return true;
+}
+
+template <typename Point, typename Geometry, typename Strategy>
+inline bool point_in_prepared_index(Point const& , Geometry const& ,
+                                    Strategy const& , int& ,
+                                    boost::false_type)
+{
+    return false;
+}
+
+// Calculates the position of the point with the index of the geometry
+// prepared by the strategy, returns false if there is none. The index is
+// only instantiated for the strategies which can pass it.
+template <typename Point, typename Geometry, typename Strategy>
+inline bool point_in_prepared_index(Point const& point, Geometry const& geometry,
+                                    Strategy const& strategy, int& result)
+{
+    return point_in_prepared_index(point, geometry, strategy, result,
+        typename boost::is_base_of
+            <
+                prepared_index_holder<Geometry>, Strategy
+            >::type());
+}
+
+
+}} // namespace detail::within
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_DETAIL_WITHIN_POINT_IN_GEOMETRY_INDEX_HPP
@@ -0,0 +1,344 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_PREPARED_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_PREPARED_HPP
+
+
+#include <cstddef>
+
+#include <boost/mpl/assert.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/vector_c.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/coordinate_system.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tag_cast.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/intersects.hpp>
+#include <boost/geometry/algorithms/relate.hpp>
+#include <boost/geometry/algorithms/relation.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+#include <boost/geometry/algorithms/detail/disjoint/box_box.hpp>
+#include <boost/geometry/algorithms/detail/sections/prepared_sections.hpp>
+#include <boost/geometry/algorithms/detail/sections/sectionalize.hpp>
+#include <boost/geometry/algorithms/detail/within/point_in_geometry_index.hpp>
+
+#include <boost/geometry/policies/robustness/no_rescale_policy.hpp>
+
+#include <boost/geometry/strategies/default_strategy.hpp>
+#include <boost/geometry/strategies/relate.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace prepared
+{
+
+// Strategy for the geometries checked against the prepared geometry:
+// the intersection strategy passing the prepared sections, or for points
+// the point in geometry strategy passing the prepared index
+template
+<
+    typename Geometry2,
+    typename Geometry,
+    typename Strategy,
+    typename Sections,
+    bool Indexed,
+    typename TagCast = typename tag_cast
+        <
+            typename tag<Geometry2>::type, pointlike_tag
+        >::type
+>
+struct prepared_strategy
+{
+    typedef detail::section::with_prepared_sections
+        <
+            Strategy, Geometry, Sections
+        > type;
+
+    static inline type apply(Geometry const& geometry, Strategy const& strategy,
+                             Sections const& sections,
+                             Sections const& reversed_sections,
+                             detail::within::point_in_geometry_index<Geometry> const& )
+    {
+        return type(strategy, geometry, sections, reversed_sections);
+    }
+};
+
+template
+<
+    typename Geometry2,
+    typename Geometry,
+    typename Strategy,
+    typename Sections,
+    bool Indexed
+>
+struct prepared_strategy<Geometry2, Geometry, Strategy, Sections, Indexed, pointlike_tag>
+{
+    typedef typename strategy::relate::services::default_strategy
+        <
+            Geometry2, Geometry
+        >::type point_strategy_type;
+
+    typedef typename boost::mpl::if_c
+        <
+            Indexed,
+            detail::within::with_prepared_index<point_strategy_type, Geometry>,
+            point_strategy_type
+        >::type type;
+
+    static inline type apply(Geometry const& geometry, Strategy const& ,
+                             Sections const& , Sections const& ,
+                             detail::within::point_in_geometry_index<Geometry> const& index)
+    {
+        return make(geometry, index, boost::integral_constant<bool, Indexed>());
+    }
+
+private :
+    static inline type make(Geometry const& geometry,
+                            detail::within::point_in_geometry_index<Geometry> const& index,
+                            boost::true_type)
+    {
+        return type(point_strategy_type(), geometry, index);
+    }
+
+    static inline type make(Geometry const& ,
+                            detail::within::point_in_geometry_index<Geometry> const& ,
+                            boost::false_type)
+    {
+        return type();
+    }
+};
+
+}} // namespace detail::prepared
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Polygonal geometry prepared to be checked against many other
+    geometries with spatial predicates
+\ingroup relate
+\details The envelope, the sections and, in the cartesian coordinate
+    system, an index of the segments for points are built once, by the
+    constructor. Checking a point then visits only the segments around its
+    x-coordinate instead of all segments of the geometry. Checking another
+    geometry reuses the sections instead of sectionalizing the prepared
+    geometry again. The results are the same as the results of the
+    corresponding free functions.
+    All of the operations are const and may be called concurrently.
+\note The geometry is referenced, it must outlive the prepared geometry.
+\note If rescaling is used (BOOST_GEOMETRY_USE_RESCALING) within, covered_by
+    and relate of non-pointlike geometries rescale, depending on both
+    geometries, and the prepared sections are not used for them.
+\tparam Geometry \tparam_geometry, a ring, a polygon or a multi-polygon
+\tparam Strategy intersection strategy, used for the non-pointlike geometries
+*/
+template
+<
+    typename Geometry,
+    typename Strategy = typename strategy::relate::services::default_strategy
+        <
+            Geometry, Geometry
+        >::type
+>
+class prepared
+{
+    BOOST_MPL_ASSERT_MSG
+        (
+            (boost::is_same
+                <
+                    typename tag_cast
+                        <
+                            typename tag<Geometry>::type, polygonal_tag
+                        >::type,
+                    polygonal_tag
+                >::value),
+            NOT_IMPLEMENTED_FOR_THIS_GEOMETRY_TYPE,
+            (types<Geometry>)
+        );
+
+    typedef typename geometry::point_type<Geometry>::type point_type;
+    typedef model::box<point_type> box_type;
+    typedef geometry::sections<box_type, 2> sections_type;
+    typedef detail::within::point_in_geometry_index<Geometry> index_type;
+
+    // The index depends on the winding strategy of the cartesian
+    // coordinate system
+    static const bool is_indexed = boost::is_same
+        <
+            typename cs_tag<Geometry>::type, cartesian_tag
+        >::value;
+
+    template <typename Geometry2>
+    struct strategy_type
+        : detail::prepared::prepared_strategy
+            <
+                Geometry2, Geometry, Strategy, sections_type, is_indexed
+            >
+    {};
+
+public :
+    /*!
+    \brief The constructor.
+    \param geometry The geometry to prepare.
+    \param strategy The intersection strategy.
+    */
+    explicit prepared(Geometry const& geometry,
+                      Strategy const& strategy = Strategy())
+        : m_geometry(geometry)
+        , m_strategy(strategy)
+    {
+        concepts::check<Geometry const>();
+
+        geometry::envelope(geometry, m_envelope, m_strategy.get_envelope_strategy());
+
+        typedef boost::mpl::vector_c<std::size_t, 0, 1> dimensions;
+        detail::no_rescale_policy robust_policy;
+        geometry::sectionalize<false, dimensions>(m_geometry, robust_policy,
+                m_sections, m_strategy.get_envelope_strategy(),
+                m_strategy.get_expand_strategy());
+        geometry::sectionalize<true, dimensions>(m_geometry, robust_policy,
+                m_reversed_sections, m_strategy.get_envelope_strategy(),
+                m_strategy.get_expand_strategy());
+
+        if (is_indexed)
+        {
+            m_index.build(m_geometry);
+        }
+    }
+
+    /*!
+    \brief Returns the prepared geometry.
+    */
+    inline Geometry const& geometry() const
+    {
+        return m_geometry;
+    }
+
+    /*!
+    \brief Returns the envelope of the prepared geometry.
+    */
+    inline box_type const& envelope() const
+    {
+        return m_envelope;
+    }
+
+    /*!
+    \brief Checks if the geometry is completely inside the prepared geometry
+    \details Behaves as within(geometry2, geometry())
+    \param geometry2 \param_geometry
+    */
+    template <typename Geometry2>
+    inline bool within(Geometry2 const& geometry2) const
+    {
+        return geometry::within(geometry2, m_geometry,
+                                get_strategy<Geometry2>());
+    }
+
+    /*!
+    \brief Checks if the geometry is inside or on the border of the prepared
+        geometry
+    \details Behaves as covered_by(geometry2, geometry())
+    \param geometry2 \param_geometry
+    */
+    template <typename Geometry2>
+    inline bool covered_by(Geometry2 const& geometry2) const
+    {
+        return geometry::covered_by(geometry2, m_geometry,
+                                    get_strategy<Geometry2>());
+    }
+
+    /*!
+    \brief Checks if the geometry has at least one point in common with the
+        prepared geometry
+    \details Behaves as intersects(geometry2, geometry())
+    \param geometry2 \param_geometry
+    */
+    template <typename Geometry2>
+    inline bool intersects(Geometry2 const& geometry2) const
+    {
+        concepts::check<Geometry2 const>();
+
+        box_type box;
+        geometry::envelope(geometry2, box);
+
+        return ! detail::disjoint::disjoint_box_box(box, m_envelope,
+                    m_strategy.get_disjoint_box_box_strategy())
+            && geometry::intersects(geometry2, m_geometry,
+                                    get_strategy<Geometry2>());
+    }
+
+    /*!
+    \brief Checks if the geometry has no point in common with the prepared
+        geometry
+    \details Behaves as disjoint(geometry2, geometry())
+    \param geometry2 \param_geometry
+    */
+    template <typename Geometry2>
+    inline bool disjoint(Geometry2 const& geometry2) const
+    {
+        return ! intersects(geometry2);
+    }
+
+    /*!
+    \brief Checks the relation of the geometry and the prepared geometry
+        defined by a mask
+    \details Behaves as relate(geometry2, geometry(), mask)
+    \param geometry2 \param_geometry
+    \param mask An intersection model mask object.
+    */
+    template <typename Geometry2, typename Mask>
+    inline bool relate(Geometry2 const& geometry2, Mask const& mask) const
+    {
+        return geometry::relate(geometry2, m_geometry, mask,
+                                get_strategy<Geometry2>());
+    }
+
+    /*!
+    \brief Calculates the relation of the geometry and the prepared geometry
+    \details Behaves as relation(geometry2, geometry())
+    \param geometry2 \param_geometry
+    */
+    template <typename Geometry2>
+    inline de9im::matrix relation(Geometry2 const& geometry2) const
+    {
+        return geometry::relation(geometry2, m_geometry,
+                                  get_strategy<Geometry2>());
+    }
+
+private :
+    template <typename Geometry2>
+    inline typename strategy_type<Geometry2>::type get_strategy() const
+    {
+        return strategy_type<Geometry2>::apply(m_geometry, m_strategy,
+                    m_sections, m_reversed_sections, m_index);
+    }
+
+    Geometry const& m_geometry;
+    Strategy m_strategy;
+    box_type m_envelope;
+    sections_type m_sections;
+    sections_type m_reversed_sections;
+    index_type m_index;
+};
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_PREPARED_HPP
@@ -0,0 +1,327 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_PREPARED_CLIP_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_PREPARED_CLIP_HPP
+
+
+#include <cstddef>
+
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/vector_c.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/point_type.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/difference.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/intersection.hpp>
+#include <boost/geometry/algorithms/intersects.hpp>
+#include <boost/geometry/algorithms/detail/disjoint/box_box.hpp>
+#include <boost/geometry/algorithms/detail/sections/prepared_sections.hpp>
+#include <boost/geometry/algorithms/detail/sections/sectionalize.hpp>
+
+#include <boost/geometry/policies/robustness/get_rescale_policy.hpp>
+#include <boost/geometry/policies/robustness/no_rescale_policy.hpp>
+#include <boost/geometry/policies/robustness/robust_point_type.hpp>
+
+#include <boost/geometry/strategies/default_strategy.hpp>
+#include <boost/geometry/strategies/relate.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+/*!
+\brief Geometry prepared to be intersected with or subtracted from many
+    other geometries
+\ingroup overlay
+\details The envelope, the sections and the rescale policy of the geometry
+    are calculated once, by the constructor. The operations against other
+    geometries reuse them instead of sectionalizing the geometry again,
+    and return early if the envelopes are disjoint. The results are the
+    same as the results of the corresponding free functions.
+    All of the operations are const and may be called concurrently.
+\note The geometry is referenced, it must outlive the prepared_clip.
+\note If rescaling is used (BOOST_GEOMETRY_USE_RESCALING), the rescale
+    policy depends on the envelopes of both geometries. The prepared
+    rescale policy and sections are then used only for the geometries
+    within the envelope of the prepared geometry, for the other ones the
+    prepared geometry is sectionalized as usual.
+\tparam Geometry \tparam_geometry
+\tparam Strategy intersection strategy, used for all of the operations
+*/
+template
+<
+    typename Geometry,
+    typename Strategy = typename strategy::relate::services::default_strategy
+        <
+            Geometry, Geometry
+        >::type
+>
+class prepared_clip
+{
+    typedef typename geometry::point_type<Geometry>::type point_type;
+    typedef model::box<point_type> box_type;
+
+    typedef typename geometry::rescale_overlay_policy_type
+        <
+            Geometry, Geometry
+        >::type robust_policy_type;
+
+    static const bool is_rescaled
+        = ! boost::is_same<robust_policy_type, detail::no_rescale_policy>::value;
+
+    // Sections used by the overlay, and the sections without rescaling,
+    // used by intersects
+    typedef geometry::sections
+        <
+            model::box
+                <
+                    typename geometry::robust_point_type
+                        <
+                            point_type, robust_policy_type
+                        >::type
+                >,
+            2
+        > sections_type;
+    typedef geometry::sections<box_type, 2> plain_sections_type;
+
+    typedef detail::section::with_prepared_sections
+        <
+            Strategy, Geometry, sections_type
+        > prepared_strategy_type;
+
+    typedef typename boost::mpl::if_c
+        <
+            is_rescaled,
+            detail::section::with_prepared_sections
+                <
+                    Strategy, Geometry, plain_sections_type
+                >,
+            prepared_strategy_type
+        >::type plain_prepared_strategy_type;
+
+    struct intersection_operation
+    {
+        template <typename Geometry2, typename RobustPolicy, typename GeometryOut, typename S>
+        static inline bool apply(Geometry2 const& geometry2, Geometry const& geometry,
+                                 RobustPolicy const& robust_policy,
+                                 GeometryOut& geometry_out, S const& strategy)
+        {
+            return resolve_strategy::intersection::apply(geometry2, geometry,
+                        robust_policy, geometry_out, strategy);
+        }
+    };
+
+    struct difference_operation
+    {
+        template <typename Geometry2, typename RobustPolicy, typename Collection, typename S>
+        static inline bool apply(Geometry2 const& geometry2, Geometry const& geometry,
+                                 RobustPolicy const& robust_policy,
+                                 Collection& output_collection, S const& strategy)
+        {
+            resolve_strategy::difference::apply(geometry2, geometry,
+                        robust_policy, output_collection, strategy);
+            return true;
+        }
+    };
+
+public :
+    /*!
+    \brief The constructor.
+    \param geometry The geometry to prepare.
+    \param strategy The intersection strategy.
+    */
+    explicit prepared_clip(Geometry const& geometry,
+                           Strategy const& strategy = Strategy())
+        : m_geometry(geometry)
+        , m_strategy(strategy)
+        , m_robust_policy(geometry::get_rescale_policy<robust_policy_type>(geometry))
+    {
+        concepts::check<Geometry const>();
+
+        geometry::envelope(geometry, m_envelope, m_strategy.get_envelope_strategy());
+
+        sectionalize(m_robust_policy, m_sections, m_reversed_sections);
+        if (is_rescaled)
+        {
+            sectionalize(detail::no_rescale_policy(),
+                         m_plain_sections, m_plain_reversed_sections);
+        }
+    }
+
+    /*!
+    \brief Returns the prepared geometry.
+    */
+    inline Geometry const& geometry() const
+    {
+        return m_geometry;
+    }
+
+    /*!
+    \brief Returns the envelope of the prepared geometry.
+    */
+    inline box_type const& envelope() const
+    {
+        return m_envelope;
+    }
+
+    /*!
+    \brief Calculates the intersection of the geometry with the prepared geometry
+    \details Behaves as intersection(geometry2, geometry(), geometry_out, strategy)
+    \param geometry2 \param_geometry
+    \param geometry_out The output geometry, either a multi_point, multi_polygon,
+        multi_linestring, or a box (for intersection of two boxes)
+    */
+    template <typename Geometry2, typename GeometryOut>
+    inline bool intersection(Geometry2 const& geometry2,
+                             GeometryOut& geometry_out) const
+    {
+        concepts::check<Geometry2 const>();
+
+        box_type box;
+        geometry::envelope(geometry2, box, m_strategy.get_envelope_strategy());
+        if (disjoint(box))
+        {
+            return true;
+        }
+
+        return apply<intersection_operation>(geometry2, box, geometry_out);
+    }
+
+    /*!
+    \brief Calculates the difference of the geometry and the prepared geometry
+    \details Behaves as difference(geometry2, geometry(), output_collection, strategy)
+    \param geometry2 \param_geometry
+    \param output_collection The output collection
+    */
+    template <typename Geometry2, typename Collection>
+    inline void difference(Geometry2 const& geometry2,
+                           Collection& output_collection) const
+    {
+        concepts::check<Geometry2 const>();
+
+        box_type box;
+        geometry::envelope(geometry2, box, m_strategy.get_envelope_strategy());
+
+        apply<difference_operation>(geometry2, box, output_collection);
+    }
+
+    /*!
+    \brief Checks if the geometry intersects the prepared geometry
+    \details Behaves as intersects(geometry2, geometry(), strategy)
+    \param geometry2 \param_geometry, linear or areal
+    */
+    template <typename Geometry2>
+    inline bool intersects(Geometry2 const& geometry2) const
+    {
+        concepts::check<Geometry2 const>();
+
+        box_type box;
+        geometry::envelope(geometry2, box, m_strategy.get_envelope_strategy());
+
+        // Intersects doesn't rescale
+        return ! disjoint(box)
+            && geometry::intersects(geometry2, m_geometry,
+                                    prepared_strategy(boost::integral_constant<bool, is_rescaled>()));
+    }
+
+private :
+    template <typename RobustPolicy, typename Sections>
+    inline void sectionalize(RobustPolicy const& robust_policy,
+                             Sections& sections, Sections& reversed_sections) const
+    {
+        typedef boost::mpl::vector_c<std::size_t, 0, 1> dimensions;
+        geometry::sectionalize<false, dimensions>(m_geometry, robust_policy,
+                sections, m_strategy.get_envelope_strategy(),
+                m_strategy.get_expand_strategy());
+        geometry::sectionalize<true, dimensions>(m_geometry, robust_policy,
+                reversed_sections, m_strategy.get_envelope_strategy(),
+                m_strategy.get_expand_strategy());
+    }
+
+    inline bool disjoint(box_type const& box) const
+    {
+        return detail::disjoint::disjoint_box_box(box, m_envelope,
+                    m_strategy.get_disjoint_box_box_strategy());
+    }
+
+    inline prepared_strategy_type prepared_strategy(boost::false_type) const
+    {
+        return prepared_strategy_type(m_strategy, m_geometry,
+                                      m_sections, m_reversed_sections);
+    }
+
+    inline plain_prepared_strategy_type prepared_strategy(boost::true_type) const
+    {
+        return plain_prepared_strategy_type(m_strategy, m_geometry,
+                    m_plain_sections, m_plain_reversed_sections);
+    }
+
+    template <typename Operation, typename Geometry2, typename Output>
+    inline bool apply(Geometry2 const& geometry2, box_type const& box,
+                      Output& output) const
+    {
+        typedef typename geometry::rescale_overlay_policy_type
+            <
+                Geometry2, Geometry
+            >::type policy_type;
+
+        return apply<Operation>(geometry2, box, output,
+                    boost::is_same<policy_type, robust_policy_type>());
+    }
+
+    // The prepared rescale policy is the same as the policy of both
+    // geometries if there is no rescaling, or if geometry2 is within the
+    // envelope of the prepared geometry. The sections are reused then.
+    template <typename Operation, typename Geometry2, typename Output>
+    inline bool apply(Geometry2 const& geometry2, box_type const& box,
+                      Output& output, boost::true_type) const
+    {
+        if (! is_rescaled || geometry::covered_by(box, m_envelope))
+        {
+            return Operation::apply(geometry2, m_geometry, m_robust_policy,
+                        output, prepared_strategy(boost::false_type()));
+        }
+        return apply<Operation>(geometry2, box, output, boost::false_type());
+    }
+
+    template <typename Operation, typename Geometry2, typename Output>
+    inline bool apply(Geometry2 const& geometry2, box_type const& ,
+                      Output& output, boost::false_type) const
+    {
+        typedef typename geometry::rescale_overlay_policy_type
+            <
+                Geometry2, Geometry
+            >::type policy_type;
+
+        return Operation::apply(geometry2, m_geometry,
+                    geometry::get_rescale_policy<policy_type>(geometry2, m_geometry),
+                    output, m_strategy);
+    }
+
+    Geometry const& m_geometry;
+    Strategy m_strategy;
+    robust_policy_type m_robust_policy;
+    box_type m_envelope;
+    sections_type m_sections;
+    sections_type m_reversed_sections;
+    plain_sections_type m_plain_sections;
+    plain_sections_type m_plain_reversed_sections;
+};
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_PREPARED_CLIP_HPP
@@ -0,0 +1,717 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_TILED_OVERLAY_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_TILED_OVERLAY_HPP
+
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/range.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/closure.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/exterior_ring.hpp>
+#include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/ring_type.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/concepts/check.hpp>
+#include <boost/geometry/geometries/multi_polygon.hpp>
+
+#include <boost/geometry/algorithms/convert.hpp>
+#include <boost/geometry/algorithms/detail/disjoint/box_box.hpp>
+#include <boost/geometry/algorithms/detail/overlay/overlay_type.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/expand.hpp>
+#include <boost/geometry/algorithms/intersection.hpp>
+#include <boost/geometry/algorithms/is_empty.hpp>
+#include <boost/geometry/algorithms/union.hpp>
+#include <boost/geometry/algorithms/union_all.hpp>
+
+#include <boost/geometry/strategies/default_strategy.hpp>
+#include <boost/geometry/strategies/parallel.hpp>
+#include <boost/geometry/strategies/relate.hpp>
+
+#include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/parallel.hpp>
+#include <boost/geometry/util/range.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace tiled_overlay
+{
+
+// The seams of the tiles along one axis. The distance between the seams is
+// a power of two and the seams are multiples of it, so the seams and the
+// corners of the tiles are exactly the same for neighbouring tiles.
+template <typename Coordinate>
+struct grid_axis
+{
+    grid_axis(Coordinate const& min_value, Coordinate const& max_value,
+              std::size_t tiles)
+        : origin(0)
+        , step(1)
+        , count(1)
+    {
+        double const size = boost::numeric_cast<double>(max_value)
+                          - boost::numeric_cast<double>(min_value);
+        if (tiles <= 1 || ! (size > 0.0))
+        {
+            origin = min_value;
+            step = max_value - min_value;
+            return;
+        }
+
+        int exponent = 0;
+        std::frexp(size / double(tiles), &exponent);
+        double step_value = std::ldexp(1.0, exponent);
+        if (boost::is_integral<Coordinate>::value && step_value < 1.0)
+        {
+            step_value = 1.0;
+        }
+
+        double const origin_value = std::floor(
+                boost::numeric_cast<double>(min_value) / step_value) * step_value;
+        double const cells = std::ceil(
+                (boost::numeric_cast<double>(max_value) - origin_value) / step_value);
+
+        origin = boost::numeric_cast<Coordinate>(origin_value);
+        step = boost::numeric_cast<Coordinate>(step_value);
+        count = (std::max)(std::size_t(1), static_cast<std::size_t>(cells));
+    }
+
+    inline Coordinate seam(std::size_t i) const
+    {
+        return origin + boost::numeric_cast<Coordinate>(i) * step;
+    }
+
+    // The interior seams strictly between the values are first, ..., last - 1
+    inline void seams_between(Coordinate const& a, Coordinate const& b,
+                              std::size_t& first, std::size_t& last) const
+    {
+        first = last = 1;
+        Coordinate const low = (std::min)(a, b);
+        Coordinate const high = (std::max)(a, b);
+        double const from = (boost::numeric_cast<double>(low)
+                - boost::numeric_cast<double>(origin))
+                / boost::numeric_cast<double>(step);
+        double const to = (boost::numeric_cast<double>(high)
+                - boost::numeric_cast<double>(origin))
+                / boost::numeric_cast<double>(step);
+        if (! (to >= 1.0) || ! (from < double(count - 1)))
+        {
+            return;
+        }
+
+        first = (std::max)(std::size_t(1),
+                    static_cast<std::size_t>((std::max)(0.0, std::floor(from))));
+        last = static_cast<std::size_t>(
+                    (std::min)(double(count - 1), std::ceil(to))) + 1;
+
+        // Correct the rounding of the division, the seams must be inside
+        while (first < last && ! (seam(first) > low))
+        {
+            first++;
+        }
+        while (last > first && ! (seam(last - 1) < high))
+        {
+            last--;
+        }
+    }
+
+    Coordinate origin;
+    Coordinate step;
+    std::size_t count;
+};
+
+
+template <typename Point>
+struct less_by_distance
+{
+    inline bool operator()(std::pair<double, Point> const& left,
+                           std::pair<double, Point> const& right) const
+    {
+        return left.first < right.first;
+    }
+};
+
+template <typename Point>
+inline bool equals_point(Point const& p, Point const& q)
+{
+    return get<0>(p) == get<0>(q) && get<1>(p) == get<1>(q);
+}
+
+// Appends the points where the segment crosses the interior seams, in the
+// order along the segment. The point on a seam is calculated from the
+// lexicographically smallest endpoint, so it is the same for the segment
+// in both directions, e.g. the segment shared by two polygons.
+template <typename Point, typename Grid, typename Ring>
+inline void append_seam_points(Point const& p, Point const& q,
+                               Grid const& grid_x, Grid const& grid_y,
+                               Ring& ring)
+{
+    typedef typename coordinate_type<Point>::type coordinate_type;
+
+    std::size_t first_x = 0, last_x = 0, first_y = 0, last_y = 0;
+    grid_x.seams_between(get<0>(p), get<0>(q), first_x, last_x);
+    grid_y.seams_between(get<1>(p), get<1>(q), first_y, last_y);
+    if (first_x == last_x && first_y == last_y)
+    {
+        return;
+    }
+
+    bool const p_first = get<0>(p) < get<0>(q)
+        || (get<0>(p) == get<0>(q) && get<1>(p) < get<1>(q));
+    Point const& a = p_first ? p : q;
+    Point const& b = p_first ? q : p;
+
+    double const ax = boost::numeric_cast<double>(get<0>(a));
+    double const ay = boost::numeric_cast<double>(get<1>(a));
+    double const dx = boost::numeric_cast<double>(get<0>(b)) - ax;
+    double const dy = boost::numeric_cast<double>(get<1>(b)) - ay;
+    double const px = boost::numeric_cast<double>(get<0>(p));
+    double const py = boost::numeric_cast<double>(get<1>(p));
+
+    // Crossings, with their distance from p along the main axis of the segment
+    std::vector<std::pair<double, Point> > crossings;
+    bool const along_x = geometry::math::abs(dx) >= geometry::math::abs(dy);
+
+    for (std::size_t i = first_x; i < last_x; i++)
+    {
+        coordinate_type const x = grid_x.seam(i);
+        double const xd = boost::numeric_cast<double>(x);
+        double const y = ay + (xd - ax) * dy / dx;
+        Point point;
+        set<0>(point, x);
+        set<1>(point, geometry::math::rounding_cast<coordinate_type>(y));
+        crossings.push_back(std::make_pair(
+            along_x ? geometry::math::abs(xd - px) : geometry::math::abs(y - py),
+            point));
+    }
+    for (std::size_t i = first_y; i < last_y; i++)
+    {
+        coordinate_type const y = grid_y.seam(i);
+        double const yd = boost::numeric_cast<double>(y);
+        double const x = ax + (yd - ay) * dx / dy;
+        Point point;
+        set<0>(point, geometry::math::rounding_cast<coordinate_type>(x));
+        set<1>(point, y);
+        crossings.push_back(std::make_pair(
+            along_x ? geometry::math::abs(x - px) : geometry::math::abs(yd - py),
+            point));
+    }
+
+    std::sort(crossings.begin(), crossings.end(), less_by_distance<Point>());
+
+    for (std::size_t i = 0; i < crossings.size(); i++)
+    {
+        Point const& point = crossings[i].second;
+        Point const& previous = range::back(ring);
+        if (! equals_point(point, previous) && ! equals_point(point, q))
+        {
+            range::push_back(ring, point);
+        }
+    }
+}
+
+template <typename Ring, typename Grid>
+inline void insert_ring_seam_points(Ring const& ring, Ring& result,
+                               Grid const& grid_x, Grid const& grid_y)
+{
+    typedef typename boost::range_iterator<Ring const>::type iterator_type;
+
+    iterator_type it = boost::begin(ring);
+    if (it == boost::end(ring))
+    {
+        return;
+    }
+
+    range::push_back(result, *it);
+    for (iterator_type prev = it++; it != boost::end(ring); prev = it++)
+    {
+        append_seam_points(*prev, *it, grid_x, grid_y, result);
+        range::push_back(result, *it);
+    }
+
+    if (geometry::closure<Ring>::value == open)
+    {
+        append_seam_points(range::back(ring), range::front(ring),
+                           grid_x, grid_y, result);
+    }
+}
+
+// Inserts a vertex where an edge of the polygons crosses a seam between
+// the tiles. Clipping to the tiles then keeps these vertices and the
+// corners of the tiles, so the pieces in neighbouring tiles share their
+// vertices along the seams exactly.
+template <typename MultiPolygon, typename Grid>
+inline void insert_seam_points(MultiPolygon const& multi_polygon,
+                               MultiPolygon& result,
+                               Grid const& grid_x, Grid const& grid_y)
+{
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+    typedef typename geometry::ring_type<polygon_type>::type ring_type;
+    typedef typename boost::range_iterator
+        <
+            typename geometry::interior_type<polygon_type>::type const
+        >::type interior_iterator;
+
+    range::resize(result, boost::size(multi_polygon));
+    for (std::size_t i = 0; i < boost::size(multi_polygon); i++)
+    {
+        polygon_type const& polygon = range::at(multi_polygon, i);
+        polygon_type& target = range::at(result, i);
+
+        insert_ring_seam_points(geometry::exterior_ring(polygon),
+                           geometry::exterior_ring(target), grid_x, grid_y);
+
+        for (interior_iterator it = boost::begin(geometry::interior_rings(polygon));
+             it != boost::end(geometry::interior_rings(polygon)); ++it)
+        {
+            ring_type ring;
+            insert_ring_seam_points(*it, ring, grid_x, grid_y);
+            range::push_back(geometry::interior_rings(target), ring);
+        }
+    }
+}
+
+template <typename Box>
+inline bool box_covered_by(Box const& inner, Box const& outer)
+{
+    return get<min_corner, 0>(inner) >= get<min_corner, 0>(outer)
+        && get<min_corner, 1>(inner) >= get<min_corner, 1>(outer)
+        && get<max_corner, 0>(inner) <= get<max_corner, 0>(outer)
+        && get<max_corner, 1>(inner) <= get<max_corner, 1>(outer);
+}
+
+// The polygons of the input, with their envelopes
+template <typename MultiPolygon, typename Box>
+struct tiled_input
+{
+    typedef MultiPolygon multi_polygon_type;
+
+    MultiPolygon geometry;
+    std::vector<Box> boxes;
+};
+
+template <typename Input, typename Geometry, typename Grid, typename Strategy>
+inline void prepare_input(Geometry const& geometry, Input& input,
+                          Grid const& grid_x, Grid const& grid_y,
+                          Strategy const& strategy)
+{
+    typedef typename Input::multi_polygon_type multi_polygon_type;
+
+    multi_polygon_type converted;
+    geometry::convert(geometry, converted);
+    insert_seam_points(converted, input.geometry, grid_x, grid_y);
+
+    input.boxes.resize(boost::size(input.geometry));
+    for (std::size_t i = 0; i < input.boxes.size(); i++)
+    {
+        geometry::envelope(range::at(input.geometry, i), input.boxes[i],
+                           strategy.get_envelope_strategy());
+    }
+}
+
+// Clips the input to the tile. Polygons inside the tile are taken as they
+// are, the others are clipped with one intersection.
+template <typename Input, typename Box, typename MultiPolygon, typename Strategy>
+inline void clip(Input const& input, Box const& tile, MultiPolygon& result,
+                 Strategy const& strategy)
+{
+    MultiPolygon partial;
+    for (std::size_t i = 0; i < input.boxes.size(); i++)
+    {
+        if (detail::disjoint::disjoint_box_box(input.boxes[i], tile,
+                    strategy.get_disjoint_box_box_strategy()))
+        {
+            continue;
+        }
+        if (box_covered_by(input.boxes[i], tile))
+        {
+            range::push_back(result, range::at(input.geometry, i));
+        }
+        else
+        {
+            range::push_back(partial, range::at(input.geometry, i));
+        }
+    }
+
+    if (! boost::empty(partial))
+    {
+        MultiPolygon clipped;
+        geometry::intersection(partial, tile, clipped, strategy);
+        result.insert(result.end(), boost::begin(clipped), boost::end(clipped));
+    }
+}
+
+template <overlay_type OverlayType>
+struct tile_operation
+{
+    template <typename MultiPolygon, typename Strategy>
+    static inline void apply(MultiPolygon const& clipped1,
+                             MultiPolygon const& clipped2,
+                             MultiPolygon& result, Strategy const& strategy)
+    {
+        if (! boost::empty(clipped1) && ! boost::empty(clipped2))
+        {
+            geometry::intersection(clipped1, clipped2, result, strategy);
+        }
+    }
+};
+
+template <>
+struct tile_operation<overlay_union>
+{
+    template <typename MultiPolygon, typename Strategy>
+    static inline void apply(MultiPolygon const& clipped1,
+                             MultiPolygon const& clipped2,
+                             MultiPolygon& result, Strategy const& strategy)
+    {
+        if (boost::empty(clipped2))
+        {
+            result = clipped1;
+        }
+        else if (boost::empty(clipped1))
+        {
+            result = clipped2;
+        }
+        else
+        {
+            geometry::union_(clipped1, clipped2, result, strategy);
+        }
+    }
+};
+
+// Clips both inputs to a tile and calculates their overlay. The tiles are
+// independent and may be calculated concurrently.
+template
+<
+    overlay_type OverlayType,
+    typename Input,
+    typename Grid,
+    typename Box,
+    typename Strategy
+>
+struct overlay_tiles
+{
+    typedef typename Input::multi_polygon_type multi_polygon_type;
+
+    overlay_tiles(Input const& input1, Input const& input2,
+                  Grid const& grid_x, Grid const& grid_y,
+                  std::vector<multi_polygon_type>& results,
+                  Strategy const& strategy)
+        : m_input1(input1)
+        , m_input2(input2)
+        , m_grid_x(grid_x)
+        , m_grid_y(grid_y)
+        , m_results(results)
+        , m_strategy(strategy)
+    {}
+
+    inline void operator()(std::size_t index)
+    {
+        std::size_t const i = index % m_grid_x.count;
+        std::size_t const j = index / m_grid_x.count;
+
+        Box tile;
+        set<min_corner, 0>(tile, m_grid_x.seam(i));
+        set<min_corner, 1>(tile, m_grid_y.seam(j));
+        set<max_corner, 0>(tile, m_grid_x.seam(i + 1));
+        set<max_corner, 1>(tile, m_grid_y.seam(j + 1));
+
+        multi_polygon_type clipped1, clipped2;
+        clip(m_input1, tile, clipped1, m_strategy);
+        if (OverlayType == overlay_intersection && boost::empty(clipped1))
+        {
+            return;
+        }
+        clip(m_input2, tile, clipped2, m_strategy);
+
+        tile_operation<OverlayType>::apply(clipped1, clipped2,
+                                           m_results[index], m_strategy);
+    }
+
+    Input const& m_input1;
+    Input const& m_input2;
+    Grid const& m_grid_x;
+    Grid const& m_grid_y;
+    std::vector<multi_polygon_type>& m_results;
+    Strategy const& m_strategy;
+};
+
+template <overlay_type OverlayType>
+struct plain_operation
+{
+    template <typename Geometry1, typename Geometry2, typename Collection, typename Strategy>
+    static inline void apply(Geometry1 const& geometry1, Geometry2 const& geometry2,
+                             Collection& output_collection, Strategy const& strategy)
+    {
+        geometry::intersection(geometry1, geometry2, output_collection, strategy);
+    }
+};
+
+template <>
+struct plain_operation<overlay_union>
+{
+    template <typename Geometry1, typename Geometry2, typename Collection, typename Strategy>
+    static inline void apply(Geometry1 const& geometry1, Geometry2 const& geometry2,
+                             Collection& output_collection, Strategy const& strategy)
+    {
+        geometry::union_(geometry1, geometry2, output_collection, strategy);
+    }
+};
+
+template
+<
+    overlay_type OverlayType,
+    typename Geometry1,
+    typename Geometry2,
+    typename Collection,
+    typename Strategy
+>
+inline void apply(Geometry1 const& geometry1, Geometry2 const& geometry2,
+                  Collection& output_collection, std::size_t tiles,
+                  Strategy const& strategy)
+{
+    typedef typename boost::range_value<Collection>::type polygon_type;
+    typedef typename geometry::point_type<polygon_type>::type point_type;
+    typedef typename geometry::coordinate_type<point_type>::type coordinate_type;
+    typedef model::box<point_type> box_type;
+    typedef model::multi_polygon<polygon_type> multi_polygon_type;
+
+    typedef tiled_input<multi_polygon_type, box_type> input_type;
+    typedef grid_axis<coordinate_type> grid_type;
+
+    if (geometry::is_empty(geometry1) || geometry::is_empty(geometry2))
+    {
+        plain_operation<OverlayType>::apply(geometry1, geometry2,
+                                            output_collection, strategy);
+        return;
+    }
+
+    // The tiles cover the area where the result can be, the common part of
+    // the envelopes for intersection, both envelopes for union
+    box_type box1, box2;
+    geometry::envelope(geometry1, box1, strategy.get_envelope_strategy());
+    geometry::envelope(geometry2, box2, strategy.get_envelope_strategy());
+
+    if (OverlayType == overlay_intersection
+        && detail::disjoint::disjoint_box_box(box1, box2,
+                strategy.get_disjoint_box_box_strategy()))
+    {
+        return;
+    }
+
+    box_type space = box1;
+    if (OverlayType == overlay_intersection)
+    {
+        set<min_corner, 0>(space, (std::max)(get<min_corner, 0>(box1), get<min_corner, 0>(box2)));
+        set<min_corner, 1>(space, (std::max)(get<min_corner, 1>(box1), get<min_corner, 1>(box2)));
+        set<max_corner, 0>(space, (std::min)(get<max_corner, 0>(box1), get<max_corner, 0>(box2)));
+        set<max_corner, 1>(space, (std::min)(get<max_corner, 1>(box1), get<max_corner, 1>(box2)));
+    }
+    else
+    {
+        geometry::expand(space, box2);
+    }
+
+    grid_type const grid_x(get<min_corner, 0>(space), get<max_corner, 0>(space), tiles);
+    grid_type const grid_y(get<min_corner, 1>(space), get<max_corner, 1>(space), tiles);
+    std::size_t const tile_count = grid_x.count * grid_y.count;
+
+    if (tile_count <= 1)
+    {
+        plain_operation<OverlayType>::apply(geometry1, geometry2,
+                                            output_collection, strategy);
+        return;
+    }
+
+    input_type input1, input2;
+    prepare_input(geometry1, input1, grid_x, grid_y, strategy);
+    prepare_input(geometry2, input2, grid_x, grid_y, strategy);
+
+    std::vector<multi_polygon_type> results(tile_count);
+    overlay_tiles
+        <
+            OverlayType, input_type, grid_type, box_type, Strategy
+        > operation(input1, input2, grid_x, grid_y, results, strategy);
+    detail::parallel::for_each_index(tile_count,
+            detail::parallel::strategy_threads(strategy), operation);
+
+    // Merge the pieces of the tiles along the seams
+    geometry::union_all(results, output_collection, strategy);
+}
+
+
+}} // namespace detail::tiled_overlay
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Calculates the intersection of two areal geometries tile by tile
+\ingroup intersection
+\details The common part of the envelopes of the geometries is divided into
+    a grid of about tiles x tiles tiles. Each tile is clipped from both
+    geometries and their intersection is calculated independently. The
+    results of the tiles are merged with union_all. If the strategy is
+    wrapped with strategy::intersection::parallel the tiles, and the merges,
+    are divided between threads.
+    The seams between the tiles are at multiples of a power of two. Before
+    clipping, a vertex is inserted where an edge crosses a seam, so the
+    pieces of neighbouring tiles share their vertices exactly. These
+    vertices, rounded to the coordinate type, stay in the output.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Collection output collection, either a multi-polygon,
+    or a std::vector<Polygon> / std::deque<Polygon> etc
+\tparam Strategy \tparam_strategy{Intersection}
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param output_collection the output collection
+\param tiles the number of tiles along each axis
+\param strategy \param_strategy{intersection}
+
+\qbk{distinguish,with strategy}
+*/
+template
+<
+    typename Geometry1,
+    typename Geometry2,
+    typename Collection,
+    typename Strategy
+>
+inline void tiled_intersection(Geometry1 const& geometry1,
+                               Geometry2 const& geometry2,
+                               Collection& output_collection,
+                               std::size_t tiles,
+                               Strategy const& strategy)
+{
+    concepts::check<Geometry1 const>();
+    concepts::check<Geometry2 const>();
+    concepts::check<typename boost::range_value<Collection>::type>();
+
+    detail::tiled_overlay::apply<overlay_intersection>(geometry1, geometry2,
+            output_collection, tiles, strategy);
+}
+
+
+/*!
+\brief Calculates the intersection of two areal geometries tile by tile
+\ingroup intersection
+\details See tiled_intersection with strategy.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Collection output collection, either a multi-polygon,
+    or a std::vector<Polygon> / std::deque<Polygon> etc
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param output_collection the output collection
+\param tiles the number of tiles along each axis
+*/
+template <typename Geometry1, typename Geometry2, typename Collection>
+inline void tiled_intersection(Geometry1 const& geometry1,
+                               Geometry2 const& geometry2,
+                               Collection& output_collection,
+                               std::size_t tiles)
+{
+    typedef typename strategy::relate::services::default_strategy
+        <
+            Geometry1, Geometry2
+        >::type strategy_type;
+
+    tiled_intersection(geometry1, geometry2, output_collection, tiles,
+                       strategy_type());
+}
+
+
+/*!
+\brief Combines two areal geometries tile by tile
+\ingroup union
+\details The combined envelope of the geometries is divided into a grid of
+    about tiles x tiles tiles, see tiled_intersection. Each tile is clipped
+    from both geometries and their union is calculated independently.
+    The results of the tiles are merged with union_all.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Collection output collection, either a multi-polygon,
+    or a std::vector<Polygon> / std::deque<Polygon> etc
+\tparam Strategy \tparam_strategy{Union_}
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param output_collection the output collection
+\param tiles the number of tiles along each axis
+\param strategy \param_strategy{union_}
+
+\qbk{distinguish,with strategy}
+*/
+template
+<
+    typename Geometry1,
+    typename Geometry2,
+    typename Collection,
+    typename Strategy
+>
+inline void tiled_union(Geometry1 const& geometry1,
+                        Geometry2 const& geometry2,
+                        Collection& output_collection,
+                        std::size_t tiles,
+                        Strategy const& strategy)
+{
+    concepts::check<Geometry1 const>();
+    concepts::check<Geometry2 const>();
+    concepts::check<typename boost::range_value<Collection>::type>();
+
+    detail::tiled_overlay::apply<overlay_union>(geometry1, geometry2,
+            output_collection, tiles, strategy);
+}
+
+
+/*!
+\brief Combines two areal geometries tile by tile
+\ingroup union
+\details See tiled_union with strategy.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Collection output collection, either a multi-polygon,
+    or a std::vector<Polygon> / std::deque<Polygon> etc
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param output_collection the output collection
+\param tiles the number of tiles along each axis
+*/
+template <typename Geometry1, typename Geometry2, typename Collection>
+inline void tiled_union(Geometry1 const& geometry1,
+                        Geometry2 const& geometry2,
+                        Collection& output_collection,
+                        std::size_t tiles)
+{
+    typedef typename strategy::relate::services::default_strategy
+        <
+            Geometry1, Geometry2
+        >::type strategy_type;
+
+    tiled_union(geometry1, geometry2, output_collection, tiles,
+                strategy_type());
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_TILED_OVERLAY_HPP
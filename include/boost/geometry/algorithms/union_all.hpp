@@ -0,0 +1,243 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_UNION_ALL_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_UNION_ALL_HPP
+
+
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <boost/range.hpp>
+
+#include <boost/geometry/core/point_type.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/concepts/check.hpp>
+#include <boost/geometry/geometries/multi_polygon.hpp>
+
+#include <boost/geometry/algorithms/assign.hpp>
+#include <boost/geometry/algorithms/convert.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/expand.hpp>
+#include <boost/geometry/algorithms/is_empty.hpp>
+#include <boost/geometry/algorithms/union.hpp>
+#include <boost/geometry/algorithms/detail/disjoint/box_box.hpp>
+
+#include <boost/geometry/index/detail/algorithms/hilbert_key.hpp>
+
+#include <boost/geometry/strategies/default_strategy.hpp>
+#include <boost/geometry/strategies/parallel.hpp>
+#include <boost/geometry/strategies/relate.hpp>
+
+#include <boost/geometry/util/parallel.hpp>
+#include <boost/geometry/util/range.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace union_all
+{
+
+// Union of a group of the input geometries
+template <typename MultiPolygon, typename Box>
+struct node
+{
+    typedef MultiPolygon multi_polygon_type;
+
+    MultiPolygon geometry;
+    Box box;
+};
+
+// Merges the pairs of neighbouring nodes of one level of the tree.
+// The merges are independent and may be called concurrently.
+template <typename Node, typename Strategy>
+struct merge_pairs
+{
+    merge_pairs(std::vector<Node>& nodes, std::vector<Node>& merged,
+                Strategy const& strategy)
+        : m_nodes(nodes)
+        , m_merged(merged)
+        , m_strategy(strategy)
+    {}
+
+    inline void operator()(std::size_t i)
+    {
+        Node& target = m_merged[i];
+        Node& first = m_nodes[2 * i];
+        target.box = first.box;
+        target.geometry.swap(first.geometry);
+
+        if (2 * i + 1 >= m_nodes.size())
+        {
+            return;
+        }
+
+        Node& second = m_nodes[2 * i + 1];
+        if (detail::disjoint::disjoint_box_box(target.box, second.box,
+                    m_strategy.get_disjoint_box_box_strategy()))
+        {
+            // The polygons of disjoint groups don't have to be merged
+            target.geometry.insert(target.geometry.end(),
+                                   boost::begin(second.geometry),
+                                   boost::end(second.geometry));
+        }
+        else
+        {
+            typename Node::multi_polygon_type result;
+            geometry::union_(target.geometry, second.geometry, result, m_strategy);
+            target.geometry.swap(result);
+        }
+        geometry::expand(target.box, second.box);
+
+        // Release the memory of the merged level as soon as possible
+        typename Node::multi_polygon_type().swap(second.geometry);
+    }
+
+    std::vector<Node>& m_nodes;
+    std::vector<Node>& m_merged;
+    Strategy const& m_strategy;
+};
+
+
+template <typename Range, typename Collection, typename Strategy>
+inline void apply(Range const& geometries, Collection& output_collection,
+                  Strategy const& strategy)
+{
+    typedef typename boost::range_value<Collection>::type polygon_type;
+    typedef typename geometry::point_type<polygon_type>::type point_type;
+    typedef model::box<point_type> box_type;
+    typedef node<model::multi_polygon<polygon_type>, box_type> node_type;
+
+    typedef typename boost::range_iterator<Range const>::type iterator_type;
+
+    // Envelopes of the input geometries, the empty ones are skipped
+    std::vector<box_type> boxes;
+    std::vector<iterator_type> inputs;
+    box_type space;
+    geometry::assign_inverse(space);
+    for (iterator_type it = boost::begin(geometries);
+         it != boost::end(geometries); ++it)
+    {
+        if (geometry::is_empty(*it))
+        {
+            continue;
+        }
+        box_type box;
+        geometry::envelope(*it, box, strategy.get_envelope_strategy());
+        geometry::expand(space, box);
+        boxes.push_back(box);
+        inputs.push_back(it);
+    }
+
+    if (inputs.empty())
+    {
+        return;
+    }
+
+    // Order the geometries along the Hilbert curve, so neighbouring leaves
+    // of the tree are usually close to each other
+    std::vector<std::pair<index::detail::hilbert_key_type, std::size_t> > keys;
+    keys.reserve(inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); i++)
+    {
+        keys.push_back(std::make_pair(index::detail::hilbert_key(boxes[i], space), i));
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<node_type> nodes(inputs.size());
+    for (std::size_t i = 0; i < keys.size(); i++)
+    {
+        std::size_t const index = keys[i].second;
+        geometry::convert(*inputs[index], nodes[i].geometry);
+        nodes[i].box = boxes[index];
+    }
+
+    // Merge the neighbours level by level, in a balanced binary tree
+    std::size_t const threads = detail::parallel::strategy_threads(strategy);
+    while (nodes.size() > 1)
+    {
+        std::vector<node_type> merged((nodes.size() + 1) / 2);
+        merge_pairs<node_type, Strategy> merger(nodes, merged, strategy);
+        detail::parallel::for_each_index(merged.size(), threads, merger);
+        nodes.swap(merged);
+    }
+
+    std::copy(boost::begin(nodes.front().geometry),
+              boost::end(nodes.front().geometry),
+              range::back_inserter(output_collection));
+}
+
+
+}} // namespace detail::union_all
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Combines all geometries of a range with each other
+\ingroup union
+\details Calculates the union of many polygons or multi-polygons at once.
+    The geometries are ordered along the Hilbert curve of the centers of
+    their envelopes and merged pairwise in a balanced binary tree, so most
+    of the merges combine small neighbouring groups. Groups with disjoint
+    envelopes are combined without overlay. If the strategy is wrapped with
+    strategy::intersection::parallel the independent merges of each level
+    of the tree are divided between threads.
+\tparam Range a range of polygonal geometries
+\tparam Collection output collection, either a multi-polygon,
+    or a std::vector<Polygon> / std::deque<Polygon> etc
+\tparam Strategy \tparam_strategy{Union_}
+\param geometries the geometries to combine
+\param output_collection the output collection
+\param strategy \param_strategy{union_}
+
+\qbk{distinguish,with strategy}
+*/
+template <typename Range, typename Collection, typename Strategy>
+inline void union_all(Range const& geometries,
+                      Collection& output_collection,
+                      Strategy const& strategy)
+{
+    concepts::check<typename boost::range_value<Range>::type const>();
+    concepts::check<typename boost::range_value<Collection>::type>();
+
+    detail::union_all::apply(geometries, output_collection, strategy);
+}
+
+
+/*!
+\brief Combines all geometries of a range with each other
+\ingroup union
+\details Calculates the union of many polygons or multi-polygons at once,
+    see union_all with strategy.
+\tparam Range a range of polygonal geometries
+\tparam Collection output collection, either a multi-polygon,
+    or a std::vector<Polygon> / std::deque<Polygon> etc
+\param geometries the geometries to combine
+\param output_collection the output collection
+*/
+template <typename Range, typename Collection>
+inline void union_all(Range const& geometries,
+                      Collection& output_collection)
+{
+    typedef typename boost::range_value<Range>::type geometry_type;
+    typedef typename strategy::relate::services::default_strategy
+        <
+            geometry_type, geometry_type
+        >::type strategy_type;
+
+    union_all(geometries, output_collection, strategy_type());
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_UNION_ALL_HPP
@@ -18,6 +18,8 @@
 #include <boost/geometry/geometries/concepts/point_concept.hpp>
 #include <boost/geometry/util/select_coordinate_type.hpp>
 
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 
 namespace boost { namespace geometry
@@ -70,6 +72,60 @@ inline ReturnType determinant(U const& u, V const& v)
         >::apply(get<0>(u), get<1>(u), get<0>(v), get<1>(v));
 }
 
+// Calculates the 128 bits product of two unsigned 64 bits integers
+inline void multiply_wide(boost::ulong_long_type a, boost::ulong_long_type b,
+                          boost::ulong_long_type& high, boost::ulong_long_type& low)
+{
+    typedef boost::ulong_long_type ull;
+    ull const mask = 0xffffffffull;
+
+    ull const a0 = a & mask, a1 = a >> 32;
+    ull const b0 = b & mask, b1 = b >> 32;
+    ull const p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+
+    ull const middle = (p00 >> 32) + (p01 & mask) + (p10 & mask);
+    low = (middle << 32) | (p00 & mask);
+    high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+}
+
+// Returns the sign of the determinant ux * vy - uy * vx of the integers,
+// calculated exactly, without overflow.
+inline int determinant_sign(boost::long_long_type ux, boost::long_long_type uy,
+                            boost::long_long_type vx, boost::long_long_type vy)
+{
+#if defined(BOOST_HAS_INT128)
+    boost::int128_type const result
+        = boost::int128_type(ux) * vy - boost::int128_type(uy) * vx;
+    return result > 0 ? 1 : result < 0 ? -1 : 0;
+#else
+    typedef boost::ulong_long_type ull;
+
+    // Compare the products ux * vy and uy * vx by their signs and, if
+    // these are the same, by their magnitudes
+    int const sign1 = (ux > 0 ? 1 : ux < 0 ? -1 : 0) * (vy > 0 ? 1 : vy < 0 ? -1 : 0);
+    int const sign2 = (uy > 0 ? 1 : uy < 0 ? -1 : 0) * (vx > 0 ? 1 : vx < 0 ? -1 : 0);
+    if (sign1 != sign2)
+    {
+        return sign1 > sign2 ? 1 : -1;
+    }
+    if (sign1 == 0)
+    {
+        return 0;
+    }
+
+    ull high1, low1, high2, low2;
+    multiply_wide(ux < 0 ? 0ull - ull(ux) : ull(ux),
+                  vy < 0 ? 0ull - ull(vy) : ull(vy), high1, low1);
+    multiply_wide(uy < 0 ? 0ull - ull(uy) : ull(uy),
+                  vx < 0 ? 0ull - ull(vx) : ull(vx), high2, low2);
+
+    int const compared = high1 != high2 ? (high1 > high2 ? 1 : -1)
+                       : low1 != low2 ? (low1 > low2 ? 1 : -1)
+                       : 0;
+    return sign1 > 0 ? compared : -compared;
+#endif
+}
+
 } // namespace detail
 #endif // DOXYGEN_NO_DETAIL
 
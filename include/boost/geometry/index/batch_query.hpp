@@ -0,0 +1,52 @@
+// Boost.Geometry Index
+//
+// R-tree batched query options
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_BATCH_QUERY_HPP
+#define BOOST_GEOMETRY_INDEX_BATCH_QUERY_HPP
+
+#include <cstddef>
+
+#include <boost/geometry/util/parallel.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief Batched query options.
+
+Passed to rtree::query_batch(). The queries are ordered along the Hilbert curve,
+divided into chunks of subsequent queries and the chunks are processed in
+separate threads.
+
+\par
+If more than one thread is used the output iterators are used concurrently so
+each of them must write to a separate container. If threads are not available
+or are disabled by defining \c BOOST_GEOMETRY_NO_THREADS the queries are performed
+in the calling thread.
+*/
+class batch_query
+{
+public:
+    /*!
+    \brief The constructor.
+
+    \param threads  The maximum number of threads, including the calling one.
+                    If 0 the number of hardware threads is used. Default: 1.
+    */
+    explicit batch_query(std::size_t threads = 1)
+        : m_threads(geometry::detail::parallel::threads_count(threads))
+    {}
+
+    std::size_t get_threads() const { return m_threads; }
+
+private:
+    std::size_t m_threads;
+};
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_BATCH_QUERY_HPP
@@ -0,0 +1,439 @@
+// Boost.Geometry Index
+//
+// R-tree queried concurrently with modifications
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_CONCURRENT_RTREE_HPP
+#define BOOST_GEOMETRY_INDEX_CONCURRENT_RTREE_HPP
+
+#include <boost/core/no_exceptions_support.hpp>
+
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/geometry/index/detail/left_right.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+template <typename Rtree, typename ValueOrRange>
+struct concurrent_insert
+{
+    explicit concurrent_insert(ValueOrRange const& v) : value_or_range(v) {}
+
+    typename Rtree::size_type operator()(Rtree & tree) const
+    {
+        tree.insert(value_or_range);
+        return 0;
+    }
+
+    ValueOrRange const& value_or_range;
+};
+
+template <typename Rtree, typename Iterator>
+struct concurrent_insert_range
+{
+    concurrent_insert_range(Iterator f, Iterator l) : first(f), last(l) {}
+
+    typename Rtree::size_type operator()(Rtree & tree) const
+    {
+        tree.insert(first, last);
+        return 0;
+    }
+
+    Iterator first, last;
+};
+
+template <typename Rtree, typename ValueOrRange>
+struct concurrent_remove
+{
+    explicit concurrent_remove(ValueOrRange const& v) : value_or_range(v) {}
+
+    typename Rtree::size_type operator()(Rtree & tree) const
+    {
+        return tree.remove(value_or_range);
+    }
+
+    ValueOrRange const& value_or_range;
+};
+
+template <typename Rtree, typename Iterator>
+struct concurrent_remove_range
+{
+    concurrent_remove_range(Iterator f, Iterator l) : first(f), last(l) {}
+
+    typename Rtree::size_type operator()(Rtree & tree) const
+    {
+        return tree.remove(first, last);
+    }
+
+    Iterator first, last;
+};
+
+template <typename Rtree>
+struct concurrent_clear
+{
+    typename Rtree::size_type operator()(Rtree & tree) const
+    {
+        tree.clear();
+        return 0;
+    }
+};
+
+}} // namespace detail::rtree
+
+/*!
+\brief The R-tree which may be queried by many threads while it is modified.
+
+The container stores two instances of the rtree. The readers query one of them
+while the writer modifies the other one, then the readers are switched to the
+modified instance and the writer applies the same modification to the previous
+one when all of the readers using it are finished. So the readers never wait
+for the writer nor for each other and each query sees a consistent state of the
+tree, either before or after a modification. The modifications are serialized,
+the writer waits for the readers which started before the switch.
+
+\par
+The queries are performed through a snapshot which gives access to the rtree
+with all of its query functions and query iterators. The snapshot should be
+short-lived, the writer can't finish a modification while it exists, and it
+must not be kept by the thread calling a modifying function.
+
+\par
+The memory used by the container and the cost of the modifications are doubled.
+If threads are not available or are disabled by defining \c BOOST_GEOMETRY_NO_THREADS
+the container can't be used concurrently.
+
+\tparam Value           The type of objects stored in the container.
+\tparam Parameters      Compile-time parameters.
+\tparam IndexableGetter The function object extracting Indexable from Value.
+\tparam EqualTo         The function object comparing objects of type Value.
+\tparam Allocator       The allocator used to allocate/deallocate memory,
+                        construct/destroy nodes and Values.
+*/
+template
+<
+    typename Value,
+    typename Parameters,
+    typename IndexableGetter = index::indexable<Value>,
+    typename EqualTo = index::equal_to<Value>,
+    typename Allocator = boost::container::new_allocator<Value>
+>
+class concurrent_rtree
+{
+    concurrent_rtree(concurrent_rtree const&);
+    concurrent_rtree & operator=(concurrent_rtree const&);
+
+public:
+    /*! \brief The type of the rtree instances. */
+    typedef index::rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> rtree_type;
+
+    /*! \brief The type of Value stored in the container. */
+    typedef typename rtree_type::value_type value_type;
+    /*! \brief R-tree parameters type. */
+    typedef typename rtree_type::parameters_type parameters_type;
+    /*! \brief The function object extracting Indexable from Value. */
+    typedef typename rtree_type::indexable_getter indexable_getter;
+    /*! \brief The function object comparing objects of type Value. */
+    typedef typename rtree_type::value_equal value_equal;
+    /*! \brief The type of allocator used by the container. */
+    typedef typename rtree_type::allocator_type allocator_type;
+    /*! \brief The Indexable type to which Value is translated. */
+    typedef typename rtree_type::indexable_type indexable_type;
+    /*! \brief The Box type used by the R-tree. */
+    typedef typename rtree_type::bounds_type bounds_type;
+    /*! \brief Unsigned integral type used by the container. */
+    typedef typename rtree_type::size_type size_type;
+
+    /*!
+    \brief The read access to a consistent state of the container.
+
+    While the snapshot exists the rtree it refers to isn't modified.
+    The query iterators of this rtree are valid until the snapshot is destroyed.
+
+    \par Example
+    \verbatim
+    {
+        Concurrent::snapshot s(tree);
+        for ( Rtree::const_query_iterator it = s->qbegin(bgi::intersects(box)) ; it != s->qend() ; ++it )
+            ...
+    }
+    \endverbatim
+    */
+    class snapshot
+    {
+        snapshot(snapshot const&);
+        snapshot & operator=(snapshot const&);
+
+    public:
+        /*!
+        \brief The constructor, never waits.
+
+        \param tree     The concurrent rtree.
+        */
+        explicit snapshot(concurrent_rtree const& tree)
+            : m_control(tree.m_control)
+            , m_token(m_control.arrive())
+            , m_tree(tree.instance(m_control.read_instance()))
+        {}
+
+        /*!
+        \brief The destructor, releases the rtree.
+        */
+        ~snapshot()
+        {
+            m_control.depart(m_token);
+        }
+
+        /*! \brief Returns the rtree. */
+        rtree_type const& operator*() const { return m_tree; }
+        /*! \brief Returns the pointer to the rtree. */
+        rtree_type const* operator->() const { return &m_tree; }
+
+    private:
+        detail::left_right & m_control;
+        detail::left_right_token m_token;
+        rtree_type const& m_tree;
+    };
+
+    /*!
+    \brief The constructor.
+
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    If allocator default constructor throws.
+    */
+    inline explicit concurrent_rtree(parameters_type const& parameters = parameters_type(),
+                                     indexable_getter const& getter = indexable_getter(),
+                                     value_equal const& equal = value_equal(),
+                                     allocator_type const& allocator = allocator_type())
+        : m_tree0(parameters, getter, equal, allocator)
+        , m_tree1(parameters, getter, equal, allocator)
+    {}
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using packing algorithm.
+
+    \param rng          The range of Values.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template <typename Range>
+    inline explicit concurrent_rtree(Range const& rng,
+                                     parameters_type const& parameters = parameters_type(),
+                                     indexable_getter const& getter = indexable_getter(),
+                                     value_equal const& equal = value_equal(),
+                                     allocator_type const& allocator = allocator_type())
+        : m_tree0(rng, parameters, getter, equal, allocator)
+        , m_tree1(m_tree0)
+    {}
+
+    /*!
+    \brief Insert a value or a range of values to the index.
+
+    The same as rtree::insert(). Waits for the readers using the instance
+    of the rtree which is modified as the second one.
+
+    \param conv_or_rng  The value convertible to value_type or a range of values.
+
+    \par Throws
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+
+    \warning
+    If an exception is thrown the instances of the rtree are made equal by copying.
+    If the copying throws the container is left in an inconsistent state.
+    */
+    template <typename ConvertibleOrRange>
+    inline void insert(ConvertibleOrRange const& conv_or_rng)
+    {
+        modify(detail::rtree::concurrent_insert<rtree_type, ConvertibleOrRange>(conv_or_rng));
+    }
+
+    /*!
+    \brief Insert a range of values to the index.
+
+    The same as rtree::insert(). The range is traversed twice.
+
+    \param first    The beginning of the range of values.
+    \param last     The end of the range of values.
+    */
+    template <typename Iterator>
+    inline void insert(Iterator first, Iterator last)
+    {
+        modify(detail::rtree::concurrent_insert_range<rtree_type, Iterator>(first, last));
+    }
+
+    /*!
+    \brief Remove a value or a range of values from the container.
+
+    The same as rtree::remove().
+
+    \param conv_or_rng  The value convertible to value_type or a range of values.
+
+    \return The number of removed values.
+    */
+    template <typename ConvertibleOrRange>
+    inline size_type remove(ConvertibleOrRange const& conv_or_rng)
+    {
+        return modify(detail::rtree::concurrent_remove<rtree_type, ConvertibleOrRange>(conv_or_rng));
+    }
+
+    /*!
+    \brief Remove a range of values from the container.
+
+    The same as rtree::remove(). The range is traversed twice.
+
+    \param first    The beginning of the range of values.
+    \param last     The end of the range of values.
+
+    \return The number of removed values.
+    */
+    template <typename Iterator>
+    inline size_type remove(Iterator first, Iterator last)
+    {
+        return modify(detail::rtree::concurrent_remove_range<rtree_type, Iterator>(first, last));
+    }
+
+    /*!
+    \brief Removes all values stored in the container.
+    */
+    inline void clear()
+    {
+        modify(detail::rtree::concurrent_clear<rtree_type>());
+    }
+
+    /*!
+    \brief Finds values meeting passed predicates.
+
+    The same as rtree::query(), performed on a snapshot.
+
+    \param predicates   Predicates.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of values found.
+    */
+    template <typename Predicates, typename OutIter>
+    inline size_type query(Predicates const& predicates, OutIter out_it) const
+    {
+        snapshot s(*this);
+        return s->query(predicates, out_it);
+    }
+
+    /*!
+    \brief Count Values or Indexables stored in the container.
+
+    The same as rtree::count(), performed on a snapshot.
+
+    \param vori The value or indexable which will be counted.
+
+    \return     The number of values found.
+    */
+    template <typename ValueOrIndexable>
+    inline size_type count(ValueOrIndexable const& vori) const
+    {
+        snapshot s(*this);
+        return s->count(vori);
+    }
+
+    /*!
+    \brief Returns the number of stored values.
+
+    \return         The number of stored values.
+    */
+    inline size_type size() const
+    {
+        snapshot s(*this);
+        return s->size();
+    }
+
+    /*!
+    \brief Query if the container is empty.
+
+    \return         true if the container is empty.
+    */
+    inline bool empty() const
+    {
+        snapshot s(*this);
+        return s->empty();
+    }
+
+    /*!
+    \brief Returns the box able to contain all values stored in the container.
+
+    \return     The box able to contain all values stored in the container or an invalid box if
+                there are no values in the container.
+    */
+    inline bounds_type bounds() const
+    {
+        snapshot s(*this);
+        return s->bounds();
+    }
+
+private:
+    rtree_type & instance(std::size_t i) { return i == 0 ? m_tree0 : m_tree1; }
+    rtree_type const& instance(std::size_t i) const { return i == 0 ? m_tree0 : m_tree1; }
+
+    // Applies the modification to the instance not used by the readers, switches
+    // the readers to it and then applies the modification to the other instance
+    template <typename Modify>
+    inline size_type modify(Modify const& modify_fun)
+    {
+        detail::left_right_writer_lock lock(m_control);
+
+        std::size_t const first = m_control.write_instance();
+        std::size_t const second = 1 - first;
+
+        size_type result = 0;
+
+        BOOST_TRY
+        {
+            result = modify_fun(instance(first));                                   // MAY THROW
+        }
+        BOOST_CATCH(...)
+        {
+            instance(first) = instance(second);                                     // MAY THROW, BASIC
+            BOOST_RETHROW
+        }
+        BOOST_CATCH_END
+
+        m_control.publish();
+
+        BOOST_TRY
+        {
+            modify_fun(instance(second));                                           // MAY THROW
+        }
+        BOOST_CATCH(...)
+        {
+            instance(second) = instance(first);                                     // MAY THROW, BASIC
+            BOOST_RETHROW
+        }
+        BOOST_CATCH_END
+
+        return result;
+    }
+
+    rtree_type m_tree0;
+    rtree_type m_tree1;
+    mutable detail::left_right m_control;
+};
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_CONCURRENT_RTREE_HPP
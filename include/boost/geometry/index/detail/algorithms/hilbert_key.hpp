@@ -0,0 +1,233 @@
+// Boost.Geometry Index
+//
+// n-dimensional Hilbert and Z-order curves keys of a box's center
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_ALGORITHMS_HILBERT_KEY_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_ALGORITHMS_HILBERT_KEY_HPP
+
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail {
+
+typedef boost::uint64_t hilbert_key_type;
+
+// The number of bits per dimension, the key of all dimensions fits in 64 bits
+template <std::size_t Dimension>
+struct hilbert_bits
+{
+    BOOST_STATIC_ASSERT(0 < Dimension && Dimension <= 64);
+    static const std::size_t value = 64 / Dimension < 32 ? 64 / Dimension : 32;
+};
+
+// Quantizes the coordinates of the center of Box in the Space
+template <typename Box, typename Space, std::size_t I, std::size_t N>
+struct hilbert_coords
+{
+    static inline void apply(Box const& b, Space const& s, boost::uint32_t * coords)
+    {
+        static const double max_coord = double((boost::uint64_t(1) << hilbert_bits<N>::value) - 1);
+
+        double const min_s = double(geometry::get<min_corner, I>(s));
+        double const max_s = double(geometry::get<max_corner, I>(s));
+        double const c = (double(geometry::get<min_corner, I>(b)) + double(geometry::get<max_corner, I>(b))) / 2;
+
+        double q = min_s < max_s ? (c - min_s) / (max_s - min_s) * max_coord : 0;
+        q = q < 0 ? 0 : (max_coord < q ? max_coord : q);
+        coords[I] = static_cast<boost::uint32_t>(q);
+
+        hilbert_coords<Box, Space, I + 1, N>::apply(b, s, coords);
+    }
+};
+
+template <typename Box, typename Space, std::size_t N>
+struct hilbert_coords<Box, Space, N, N>
+{
+    static inline void apply(Box const& , Space const& , boost::uint32_t * ) {}
+};
+
+// Transforms the coordinates to the Hilbert index stored in transposed form,
+// see J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707, 2004
+// The branches depending on the bits of the coordinates are replaced with masks
+// because they are mispredicted for most of the bits.
+template <std::size_t N, std::size_t Bits>
+inline void hilbert_axes_to_transpose(boost::uint32_t * x)
+{
+    boost::uint32_t const m = boost::uint32_t(1) << (Bits - 1);
+
+    // inverse undo
+    for ( boost::uint32_t q = m ; q > 1 ; q >>= 1 )
+    {
+        boost::uint32_t const p = q - 1;
+        for ( std::size_t i = 0 ; i < N ; ++i )
+        {
+            // invert if the bit is set, exchange otherwise
+            boost::uint32_t const invert = p & (boost::uint32_t(0) - boost::uint32_t((x[i] & q) != 0));
+            boost::uint32_t const t = (x[0] ^ x[i]) & p & ~invert;
+            x[0] ^= invert ^ t;
+            x[i] ^= t;
+        }
+    }
+
+    // gray encode
+    for ( std::size_t i = 1 ; i < N ; ++i )
+        x[i] ^= x[i - 1];
+
+    boost::uint32_t t = 0;
+    for ( boost::uint32_t q = m ; q > 1 ; q >>= 1 )
+    {
+        t ^= (q - 1) & (boost::uint32_t(0) - boost::uint32_t((x[N - 1] & q) != 0));
+    }
+
+    for ( std::size_t i = 0 ; i < N ; ++i )
+        x[i] ^= t;
+}
+
+// Interleaves the bits of the coordinates, the most significant first
+template <std::size_t N>
+struct interleave_bits
+{
+    static inline hilbert_key_type apply(boost::uint32_t const* x)
+    {
+        hilbert_key_type result = 0;
+        for ( std::size_t j = hilbert_bits<N>::value ; j > 0 ; --j )
+        {
+            for ( std::size_t i = 0 ; i < N ; ++i )
+            {
+                result = (result << 1) | ((x[i] >> (j - 1)) & 1);
+            }
+        }
+        return result;
+    }
+};
+
+template <>
+struct interleave_bits<2>
+{
+    static inline hilbert_key_type spread(boost::uint32_t c)
+    {
+        hilbert_key_type v = c;
+        v = (v | (v << 16)) & UINT64_C(0x0000FFFF0000FFFF);
+        v = (v | (v << 8))  & UINT64_C(0x00FF00FF00FF00FF);
+        v = (v | (v << 4))  & UINT64_C(0x0F0F0F0F0F0F0F0F);
+        v = (v | (v << 2))  & UINT64_C(0x3333333333333333);
+        v = (v | (v << 1))  & UINT64_C(0x5555555555555555);
+        return v;
+    }
+
+    static inline hilbert_key_type apply(boost::uint32_t const* x)
+    {
+        return (spread(x[0]) << 1) | spread(x[1]);
+    }
+};
+
+template <>
+struct interleave_bits<3>
+{
+    static inline hilbert_key_type spread(boost::uint32_t c)
+    {
+        hilbert_key_type v = c & 0x1FFFFFu;
+        v = (v | (v << 32)) & UINT64_C(0x001F00000000FFFF);
+        v = (v | (v << 16)) & UINT64_C(0x001F0000FF0000FF);
+        v = (v | (v << 8))  & UINT64_C(0x100F00F00F00F00F);
+        v = (v | (v << 4))  & UINT64_C(0x10C30C30C30C30C3);
+        v = (v | (v << 2))  & UINT64_C(0x1249249249249249);
+        return v;
+    }
+
+    static inline hilbert_key_type apply(boost::uint32_t const* x)
+    {
+        return (spread(x[0]) << 2) | (spread(x[1]) << 1) | spread(x[2]);
+    }
+};
+
+// Calculates the Hilbert index of the quantized coordinates
+template <std::size_t N>
+struct hilbert_index
+{
+    static inline hilbert_key_type apply(boost::uint32_t * x)
+    {
+        hilbert_axes_to_transpose<N, hilbert_bits<N>::value>(x);
+        return interleave_bits<N>::apply(x);
+    }
+};
+
+// In 2d the states of the curve for all of the bits are calculated at once with
+// the parallel prefix scan instead of iterating over the bits, see the state
+// machine of the curve in H. S. Warren, "Hacker's Delight", 2nd ed., ch. 16
+template <>
+struct hilbert_index<2>
+{
+    static inline hilbert_key_type apply(boost::uint32_t * xy)
+    {
+        boost::uint32_t const ones = 0xFFFFFFFFu;
+        boost::uint32_t const x = xy[0];
+        boost::uint32_t const y = xy[1];
+
+        boost::uint32_t A, B, C, D;
+        {
+            boost::uint32_t const a = x ^ y;
+            boost::uint32_t const b = ones ^ a;
+            boost::uint32_t const c = ones ^ (x | y);
+            boost::uint32_t const d = x & (y ^ ones);
+            A = a | (b >> 1);
+            B = (a >> 1) ^ a;
+            C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+            D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+        }
+
+        for ( std::size_t s = 2 ; s < 32 ; s <<= 1 )
+        {
+            boost::uint32_t const a = A, b = B, c = C, d = D;
+            A = (a & (a >> s)) ^ (b & (b >> s));
+            B = (a & (b >> s)) ^ (b & ((a ^ b) >> s));
+            C ^= (a & (c >> s)) ^ (b & (d >> s));
+            D ^= (b & (c >> s)) ^ ((a ^ b) & (d >> s));
+        }
+
+        boost::uint32_t const a = C ^ (C >> 1);
+        boost::uint32_t const b = D ^ (D >> 1);
+
+        // the bits of the index
+        boost::uint32_t const i0 = x ^ y;
+        boost::uint32_t const i1 = b | (ones ^ (i0 | a));
+
+        boost::uint32_t const i[2] = { i1, i0 };
+        return interleave_bits<2>::apply(i);
+    }
+};
+
+// Returns the position of the center of the box on the Hilbert curve filling the space
+template <typename Box, typename Space>
+inline hilbert_key_type hilbert_key(Box const& b, Space const& space)
+{
+    static const std::size_t dimension = geometry::dimension<Box>::value;
+
+    boost::uint32_t x[dimension];
+    hilbert_coords<Box, Space, 0, dimension>::apply(b, space, x);
+
+    return hilbert_index<dimension>::apply(x);
+}
+
+// Returns the position of the center of the box on the Z-order (Morton) curve filling the space
+template <typename Box, typename Space>
+inline hilbert_key_type morton_key(Box const& b, Space const& space)
+{
+    static const std::size_t dimension = geometry::dimension<Box>::value;
+
+    boost::uint32_t x[dimension];
+    hilbert_coords<Box, Space, 0, dimension>::apply(b, space, x);
+
+    return interleave_bits<dimension>::apply(x);
+}
+
+}}}} // namespace boost::geometry::index::detail
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_ALGORITHMS_HILBERT_KEY_HPP
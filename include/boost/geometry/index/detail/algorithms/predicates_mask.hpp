@@ -0,0 +1,288 @@
+// Boost.Geometry Index
+//
+// Spatial predicates of many indexables and a box computed at once
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_ALGORITHMS_PREDICATES_MASK_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_ALGORITHMS_PREDICATES_MASK_HPP
+
+#include <cstddef>
+
+// SIMD instructions are used if the compiler targets the instruction set and
+// the user didn't disable them explicitly by defining BOOST_GEOMETRY_INDEX_NO_SIMD.
+// Otherwise the predicates are computed with the scalar loops.
+#if ! defined(BOOST_GEOMETRY_INDEX_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) \
+ || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOOST_GEOMETRY_INDEX_DETAIL_SIMD_SSE2
+#endif
+#if defined(__AVX2__)
+#define BOOST_GEOMETRY_INDEX_DETAIL_SIMD_AVX2
+#endif
+#endif
+
+#ifdef BOOST_GEOMETRY_INDEX_DETAIL_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef BOOST_GEOMETRY_INDEX_DETAIL_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+namespace boost { namespace geometry { namespace index { namespace detail {
+
+namespace predicates_mask {
+
+// The predicates for one coordinate of an indexable described by min and max
+// coordinates and a box described by query min and max coordinates. The
+// conditions are the same as in the cartesian strategies, also for NaNs.
+// For points the max coordinate is the same as the min coordinate.
+
+// intersects(point, box), covered_by(point, box)
+struct point_covered_by
+{
+    template <typename T, typename QT>
+    static inline bool apply(T const& v, T const& , QT const& qmin, QT const& qmax)
+    {
+        return v >= qmin && v <= qmax;
+    }
+
+    template <typename Ops>
+    static inline typename Ops::vector_type apply_simd(typename Ops::vector_type const& v,
+                                                       typename Ops::vector_type const& ,
+                                                       typename Ops::vector_type const& qmin,
+                                                       typename Ops::vector_type const& qmax)
+    {
+        return Ops::and_(Ops::ge(v, qmin), Ops::le(v, qmax));
+    }
+};
+
+// within(point, box)
+struct point_within
+{
+    template <typename T, typename QT>
+    static inline bool apply(T const& v, T const& , QT const& qmin, QT const& qmax)
+    {
+        return v > qmin && v < qmax;
+    }
+
+    template <typename Ops>
+    static inline typename Ops::vector_type apply_simd(typename Ops::vector_type const& v,
+                                                       typename Ops::vector_type const& ,
+                                                       typename Ops::vector_type const& qmin,
+                                                       typename Ops::vector_type const& qmax)
+    {
+        return Ops::and_(Ops::gt(v, qmin), Ops::lt(v, qmax));
+    }
+};
+
+// intersects(box, box)
+struct box_intersects
+{
+    template <typename T, typename QT>
+    static inline bool apply(T const& min, T const& max, QT const& qmin, QT const& qmax)
+    {
+        return ! (max < qmin) && ! (min > qmax);
+    }
+
+    template <typename Ops>
+    static inline typename Ops::vector_type apply_simd(typename Ops::vector_type const& min,
+                                                       typename Ops::vector_type const& max,
+                                                       typename Ops::vector_type const& qmin,
+                                                       typename Ops::vector_type const& qmax)
+    {
+        return Ops::and_(Ops::nlt(max, qmin), Ops::ngt(min, qmax));
+    }
+};
+
+// within(box, box)
+struct box_within
+{
+    template <typename T, typename QT>
+    static inline bool apply(T const& min, T const& max, QT const& qmin, QT const& qmax)
+    {
+        return qmin <= min && max <= qmax && min < max;
+    }
+
+    template <typename Ops>
+    static inline typename Ops::vector_type apply_simd(typename Ops::vector_type const& min,
+                                                       typename Ops::vector_type const& max,
+                                                       typename Ops::vector_type const& qmin,
+                                                       typename Ops::vector_type const& qmax)
+    {
+        return Ops::and_(Ops::and_(Ops::le(qmin, min), Ops::le(max, qmax)), Ops::lt(min, max));
+    }
+};
+
+// covered_by(box, box)
+struct box_covered_by
+{
+    template <typename T, typename QT>
+    static inline bool apply(T const& min, T const& max, QT const& qmin, QT const& qmax)
+    {
+        return min >= qmin && max <= qmax;
+    }
+
+    template <typename Ops>
+    static inline typename Ops::vector_type apply_simd(typename Ops::vector_type const& min,
+                                                       typename Ops::vector_type const& max,
+                                                       typename Ops::vector_type const& qmin,
+                                                       typename Ops::vector_type const& qmax)
+    {
+        return Ops::and_(Ops::ge(min, qmin), Ops::le(max, qmax));
+    }
+};
+
+// SIMD operations
+
+#ifdef BOOST_GEOMETRY_INDEX_DETAIL_SIMD_SSE2
+
+struct sse2_double
+{
+    typedef __m128d vector_type;
+    static const std::size_t size = 2;
+
+    static inline vector_type load(double const* p) { return _mm_loadu_pd(p); }
+    static inline vector_type set(double v) { return _mm_set1_pd(v); }
+    static inline vector_type lt(vector_type a, vector_type b) { return _mm_cmplt_pd(a, b); }
+    static inline vector_type le(vector_type a, vector_type b) { return _mm_cmple_pd(a, b); }
+    static inline vector_type gt(vector_type a, vector_type b) { return _mm_cmpgt_pd(a, b); }
+    static inline vector_type ge(vector_type a, vector_type b) { return _mm_cmpge_pd(a, b); }
+    static inline vector_type nlt(vector_type a, vector_type b) { return _mm_cmpnlt_pd(a, b); }
+    static inline vector_type ngt(vector_type a, vector_type b) { return _mm_cmpngt_pd(a, b); }
+    static inline vector_type and_(vector_type a, vector_type b) { return _mm_and_pd(a, b); }
+    static inline int mask(vector_type a) { return _mm_movemask_pd(a); }
+};
+
+struct sse2_float
+{
+    typedef __m128 vector_type;
+    static const std::size_t size = 4;
+
+    static inline vector_type load(float const* p) { return _mm_loadu_ps(p); }
+    static inline vector_type set(float v) { return _mm_set1_ps(v); }
+    static inline vector_type lt(vector_type a, vector_type b) { return _mm_cmplt_ps(a, b); }
+    static inline vector_type le(vector_type a, vector_type b) { return _mm_cmple_ps(a, b); }
+    static inline vector_type gt(vector_type a, vector_type b) { return _mm_cmpgt_ps(a, b); }
+    static inline vector_type ge(vector_type a, vector_type b) { return _mm_cmpge_ps(a, b); }
+    static inline vector_type nlt(vector_type a, vector_type b) { return _mm_cmpnlt_ps(a, b); }
+    static inline vector_type ngt(vector_type a, vector_type b) { return _mm_cmpngt_ps(a, b); }
+    static inline vector_type and_(vector_type a, vector_type b) { return _mm_and_ps(a, b); }
+    static inline int mask(vector_type a) { return _mm_movemask_ps(a); }
+};
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_SIMD_SSE2
+
+#ifdef BOOST_GEOMETRY_INDEX_DETAIL_SIMD_AVX2
+
+struct avx2_double
+{
+    typedef __m256d vector_type;
+    static const std::size_t size = 4;
+
+    static inline vector_type load(double const* p) { return _mm256_loadu_pd(p); }
+    static inline vector_type set(double v) { return _mm256_set1_pd(v); }
+    static inline vector_type lt(vector_type a, vector_type b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static inline vector_type le(vector_type a, vector_type b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static inline vector_type gt(vector_type a, vector_type b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static inline vector_type ge(vector_type a, vector_type b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+    static inline vector_type nlt(vector_type a, vector_type b) { return _mm256_cmp_pd(a, b, _CMP_NLT_UQ); }
+    static inline vector_type ngt(vector_type a, vector_type b) { return _mm256_cmp_pd(a, b, _CMP_NGT_UQ); }
+    static inline vector_type and_(vector_type a, vector_type b) { return _mm256_and_pd(a, b); }
+    static inline int mask(vector_type a) { return _mm256_movemask_pd(a); }
+};
+
+struct avx2_float
+{
+    typedef __m256 vector_type;
+    static const std::size_t size = 8;
+
+    static inline vector_type load(float const* p) { return _mm256_loadu_ps(p); }
+    static inline vector_type set(float v) { return _mm256_set1_ps(v); }
+    static inline vector_type lt(vector_type a, vector_type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static inline vector_type le(vector_type a, vector_type b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static inline vector_type gt(vector_type a, vector_type b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static inline vector_type ge(vector_type a, vector_type b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static inline vector_type nlt(vector_type a, vector_type b) { return _mm256_cmp_ps(a, b, _CMP_NLT_UQ); }
+    static inline vector_type ngt(vector_type a, vector_type b) { return _mm256_cmp_ps(a, b, _CMP_NGT_UQ); }
+    static inline vector_type and_(vector_type a, vector_type b) { return _mm256_and_ps(a, b); }
+    static inline int mask(vector_type a) { return _mm256_movemask_ps(a); }
+};
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_SIMD_AVX2
+
+// The widest SIMD operations available for the coordinates of the indexables
+// and of the query box, void if the scalar loop must be used. The coordinates
+// must have the same type, otherwise a conversion could change the result.
+template <typename T, typename QT>
+struct simd_ops
+{
+    typedef void type;
+};
+
+#if defined(BOOST_GEOMETRY_INDEX_DETAIL_SIMD_AVX2)
+template <> struct simd_ops<double, double> { typedef avx2_double type; };
+template <> struct simd_ops<float, float> { typedef avx2_float type; };
+#elif defined(BOOST_GEOMETRY_INDEX_DETAIL_SIMD_SSE2)
+template <> struct simd_ops<double, double> { typedef sse2_double type; };
+template <> struct simd_ops<float, float> { typedef sse2_float type; };
+#endif
+
+template <typename Predicate, typename T, typename QT, typename Ops = typename simd_ops<T, QT>::type>
+struct dimension_mask
+{
+    static inline void apply(T const* mins, T const* maxs, QT const& qmin, QT const& qmax,
+                             std::size_t count, unsigned char * flags)
+    {
+        typedef typename Ops::vector_type vector_type;
+
+        vector_type const vqmin = Ops::set(qmin);
+        vector_type const vqmax = Ops::set(qmax);
+
+        std::size_t i = 0;
+        for ( ; i + Ops::size <= count ; i += Ops::size )
+        {
+            int const bits = Ops::mask(Predicate::template apply_simd<Ops>(Ops::load(mins + i), Ops::load(maxs + i),
+                                                                           vqmin, vqmax));
+            for ( std::size_t j = 0 ; j < Ops::size ; ++j )
+                flags[i + j] &= static_cast<unsigned char>((bits >> j) & 1);
+        }
+        for ( ; i < count ; ++i )
+        {
+            flags[i] &= static_cast<unsigned char>(Predicate::apply(mins[i], maxs[i], qmin, qmax));
+        }
+    }
+};
+
+template <typename Predicate, typename T, typename QT>
+struct dimension_mask<Predicate, T, QT, void>
+{
+    static inline void apply(T const* mins, T const* maxs, QT const& qmin, QT const& qmax,
+                             std::size_t count, unsigned char * flags)
+    {
+        for ( std::size_t i = 0 ; i < count ; ++i )
+        {
+            flags[i] &= static_cast<unsigned char>(Predicate::apply(mins[i], maxs[i], qmin, qmax));
+        }
+    }
+};
+
+} // namespace predicates_mask
+
+// Computes the Predicate of count indexables and a box for one dimension.
+// The min and max coordinates of the indexables are stored in separate arrays,
+// the result is stored in flags with logical and so the same flags may be passed
+// for all dimensions.
+template <typename Predicate, typename T, typename QT>
+inline void predicate_dimension_mask(T const* mins, T const* maxs,
+                                     QT const& qmin, QT const& qmax,
+                                     std::size_t count, unsigned char * flags)
+{
+    predicates_mask::dimension_mask<Predicate, T, QT>::apply(mins, maxs, qmin, qmax, count, flags);
+}
+
+}}}} // namespace boost::geometry::index::detail
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_ALGORITHMS_PREDICATES_MASK_HPP
@@ -0,0 +1,183 @@
+// Boost.Geometry Index
+//
+// Left-Right concurrency control
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_LEFT_RIGHT_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_LEFT_RIGHT_HPP
+
+#include <cstddef>
+
+#include <boost/geometry/util/parallel.hpp>
+
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+#include <functional>
+#endif
+
+namespace boost { namespace geometry { namespace index { namespace detail {
+
+// The Left-Right technique, see P. Ramalhete, A. Correia, "Left-Right: A Concurrency
+// Control Technique with Wait-Free Population Oblivious Reads", 2015.
+//
+// Two instances of the data structure are stored. The readers use the one
+// pointed by the left_right index and never wait. The writer modifies the other
+// instance, switches the readers to it, waits until all of the readers which
+// could use the previous instance finish and then modifies the previous one.
+// So each reader sees a consistent state of the data structure, the same for
+// the whole duration of the read.
+
+struct left_right_token
+{
+    std::size_t version;
+    std::size_t slot;
+};
+
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+
+// The number of readers using one version of the left_right index. The counter
+// is divided into slots stored in separate cache lines and chosen by the id
+// of the thread so the readers running concurrently rarely modify the same memory.
+class left_right_read_indicator
+{
+    left_right_read_indicator(left_right_read_indicator const&);
+    left_right_read_indicator & operator=(left_right_read_indicator const&);
+
+public:
+    static const std::size_t slots_count = 32;
+
+    left_right_read_indicator()
+    {
+        for ( std::size_t i = 0 ; i < slots_count ; ++i )
+            m_slots[i].count.store(0);
+    }
+
+    static std::size_t slot()
+    {
+        return std::hash<std::thread::id>()(std::this_thread::get_id()) % slots_count;
+    }
+
+    void arrive(std::size_t s) { m_slots[s].count.fetch_add(1); }
+    void depart(std::size_t s) { m_slots[s].count.fetch_sub(1); }
+
+    bool is_empty() const
+    {
+        for ( std::size_t i = 0 ; i < slots_count ; ++i )
+        {
+            if ( m_slots[i].count.load() != 0 )
+                return false;
+        }
+        return true;
+    }
+
+private:
+    struct counter
+    {
+        std::atomic<std::size_t> count;
+        char padding[64 - sizeof(std::atomic<std::size_t>)];
+    };
+
+    counter m_slots[slots_count];
+};
+
+class left_right
+{
+    left_right(left_right const&);
+    left_right & operator=(left_right const&);
+
+public:
+    left_right()
+        : m_left_right(0), m_version(0)
+    {}
+
+    // Registers the reader, the instance it may use is returned by read_instance()
+    left_right_token arrive()
+    {
+        left_right_token token;
+        token.version = m_version.load();
+        token.slot = left_right_read_indicator::slot();
+        m_readers[token.version].arrive(token.slot);
+        return token;
+    }
+
+    std::size_t read_instance() const
+    {
+        return m_left_right.load();
+    }
+
+    void depart(left_right_token const& token)
+    {
+        m_readers[token.version].depart(token.slot);
+    }
+
+    // Must be called by the writer holding the writer's mutex
+    std::mutex & writer_mutex() { return m_writer_mutex; }
+
+    // The instance which is not used by the readers
+    std::size_t write_instance() const
+    {
+        return 1 - m_left_right.load();
+    }
+
+    // Switches the readers to the write_instance(), when the function returns
+    // the previous instance isn't used by any reader
+    void publish()
+    {
+        m_left_right.store(1 - m_left_right.load());
+
+        std::size_t const prev = m_version.load();
+        std::size_t const next = 1 - prev;
+
+        wait_for_readers(next);
+        m_version.store(next);
+        wait_for_readers(prev);
+    }
+
+private:
+    void wait_for_readers(std::size_t version) const
+    {
+        while ( !m_readers[version].is_empty() )
+            std::this_thread::yield();
+    }
+
+    std::atomic<std::size_t> m_left_right;
+    std::atomic<std::size_t> m_version;
+    left_right_read_indicator m_readers[2];
+    std::mutex m_writer_mutex;
+};
+
+struct left_right_writer_lock
+{
+    explicit left_right_writer_lock(left_right & lr)
+        : lock(lr.writer_mutex())
+    {}
+
+    std::lock_guard<std::mutex> lock;
+};
+
+#else // BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+
+// Single-threaded version, the readers always use the first instance
+class left_right
+{
+public:
+    left_right_token arrive() { left_right_token t = { 0, 0 }; return t; }
+    std::size_t read_instance() const { return 0; }
+    void depart(left_right_token const& ) {}
+
+    std::size_t write_instance() const { return 1; }
+    void publish() {}
+};
+
+struct left_right_writer_lock
+{
+    explicit left_right_writer_lock(left_right & ) {}
+};
+
+#endif // BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+
+}}}} // namespace boost::geometry::index::detail
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_LEFT_RIGHT_HPP
@@ -72,6 +72,10 @@ struct spatial_predicate
     Geometry geometry;
 };
 
+// the relationship of the values of two joined rtrees
+template <typename Tag, bool Negated>
+struct spatial_join_predicate {};
+
 // ------------------------------------------------------------------ //
 
 // CONSIDER: separated nearest<> and path<> may be replaced by
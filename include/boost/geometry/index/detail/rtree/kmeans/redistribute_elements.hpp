@@ -0,0 +1,289 @@
+// Boost.Geometry Index
+//
+// R-tree k-means split algorithm implementation
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_KMEANS_REDISTRIBUTE_ELEMENTS_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_KMEANS_REDISTRIBUTE_ELEMENTS_HPP
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <boost/geometry/index/detail/rtree/node/node.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/insert.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+namespace kmeans {
+
+// The maximum number of iterations of the Lloyd's algorithm
+static const size_t max_iterations = 16;
+
+template <size_t Dimension>
+struct center
+{
+    double coords[Dimension];
+};
+
+template <typename Box, size_t I, size_t D>
+struct box_center
+{
+    static inline void apply(Box const& b, double * c)
+    {
+        c[I] = ( double(geometry::get<min_corner, I>(b)) + double(geometry::get<max_corner, I>(b)) ) / 2;
+        box_center<Box, I + 1, D>::apply(b, c);
+    }
+};
+
+template <typename Box, size_t D>
+struct box_center<Box, D, D>
+{
+    static inline void apply(Box const& , double * ) {}
+};
+
+template <size_t D>
+inline double comparable_distance(center<D> const& c1, center<D> const& c2)
+{
+    double result = 0;
+    for ( size_t i = 0 ; i < D ; ++i )
+    {
+        double const d = c1.coords[i] - c2.coords[i];
+        result += d * d;
+    }
+    return result;
+}
+
+// The difference of the distances to the means, negative if the center is closer to the first one.
+// It's linear WRT the center so the groups are separated by a hyperplane.
+template <size_t D>
+inline double distances_difference(center<D> const& c, center<D> const& mean1, center<D> const& mean2)
+{
+    return comparable_distance(c, mean1) - comparable_distance(c, mean2);
+}
+
+template <typename Centers, size_t D>
+inline bool calculate_means(Centers const& centers, std::vector<bool> const& in_first,
+                            center<D> & mean1, center<D> & mean2)
+{
+    size_t count1 = 0, count2 = 0;
+    for ( size_t i = 0 ; i < D ; ++i )
+    {
+        mean1.coords[i] = 0;
+        mean2.coords[i] = 0;
+    }
+
+    for ( size_t j = 0 ; j < centers.size() ; ++j )
+    {
+        center<D> & mean = in_first[j] ? mean1 : mean2;
+        ( in_first[j] ? count1 : count2 )++;
+        for ( size_t i = 0 ; i < D ; ++i )
+            mean.coords[i] += centers[j].coords[i];
+    }
+
+    if ( count1 == 0 || count2 == 0 )
+        return false;
+
+    for ( size_t i = 0 ; i < D ; ++i )
+    {
+        mean1.coords[i] /= double(count1);
+        mean2.coords[i] /= double(count2);
+    }
+
+    return true;
+}
+
+// Divides the centers into two clusters with the Lloyd's algorithm. The initial
+// means are the center furthest from the mean of all of the centers and the
+// center furthest from the first one.
+template <typename Centers, size_t D>
+inline bool find_means(Centers const& centers, center<D> & mean1, center<D> & mean2)
+{
+    size_t const count = centers.size();
+
+    center<D> mean;
+    for ( size_t i = 0 ; i < D ; ++i )
+    {
+        mean.coords[i] = 0;
+        for ( size_t j = 0 ; j < count ; ++j )
+            mean.coords[i] += centers[j].coords[i];
+        mean.coords[i] /= double(count);
+    }
+
+    size_t seed1 = 0;
+    double greatest_distance = -1;
+    for ( size_t j = 0 ; j < count ; ++j )
+    {
+        double const d = comparable_distance(centers[j], mean);
+        if ( greatest_distance < d )
+        {
+            greatest_distance = d;
+            seed1 = j;
+        }
+    }
+
+    size_t seed2 = seed1;
+    greatest_distance = 0;
+    for ( size_t j = 0 ; j < count ; ++j )
+    {
+        double const d = comparable_distance(centers[j], centers[seed1]);
+        if ( greatest_distance < d )
+        {
+            greatest_distance = d;
+            seed2 = j;
+        }
+    }
+
+    // all of the centers are equal
+    if ( seed1 == seed2 )
+        return false;
+
+    mean1 = centers[seed1];
+    mean2 = centers[seed2];
+
+    std::vector<bool> in_first(count, false);
+    for ( size_t iteration = 0 ; iteration < max_iterations ; ++iteration )
+    {
+        bool changed = iteration == 0;
+        for ( size_t j = 0 ; j < count ; ++j )
+        {
+            bool const first = distances_difference(centers[j], mean1, mean2) <= 0;
+            if ( first != in_first[j] )
+            {
+                in_first[j] = first;
+                changed = true;
+            }
+        }
+
+        if ( !changed )
+            break;
+
+        center<D> new_mean1, new_mean2;
+        if ( !calculate_means(centers, in_first, new_mean1, new_mean2) )
+            break;
+
+        mean1 = new_mean1;
+        mean2 = new_mean2;
+    }
+
+    return true;
+}
+
+} // namespace kmeans
+
+template <typename Value, typename Options, typename Translator, typename Box, typename Allocators>
+struct redistribute_elements<Value, Options, Translator, Box, Allocators, kmeans_tag>
+{
+    typedef typename Options::parameters_type parameters_type;
+
+    typedef typename rtree::node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type node;
+    typedef typename rtree::internal_node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    static const size_t dimension = geometry::dimension<Box>::value;
+
+    template <typename Node>
+    static inline void apply(Node & n,
+                             Node & second_node,
+                             Box & box1,
+                             Box & box2,
+                             parameters_type const& parameters,
+                             Translator const& translator,
+                             Allocators & allocators)
+    {
+        typedef typename rtree::elements_type<Node>::type elements_type;
+        typedef typename elements_type::value_type element_type;
+
+        elements_type & elements1 = rtree::elements(n);
+        elements_type & elements2 = rtree::elements(second_node);
+        const size_t elements1_count = parameters.get_max_elements() + 1;
+        const size_t min_elements = parameters.get_min_elements();
+
+        BOOST_GEOMETRY_INDEX_ASSERT(elements1.size() == elements1_count, "unexpected number of elements");
+        BOOST_GEOMETRY_INDEX_ASSERT(2 * min_elements <= elements1_count, "unexpected number of elements");
+
+        // the centers of the elements' bounds
+        typedef typename rtree::container_from_elements_type<elements_type, kmeans::center<dimension> >::type
+            centers_type;
+        centers_type centers(elements1_count);                                                              // MAY THROW, STRONG (alloc)
+        for ( size_t i = 0 ; i < elements1_count ; ++i )
+        {
+            Box b;
+            detail::bounds(rtree::element_indexable(elements1[i], translator), b);
+            kmeans::box_center<Box, 0, dimension>::apply(b, centers[i].coords);
+        }
+
+        // order the elements by the differences of the distances to the means of the clusters,
+        // the elements closer to the first mean are first
+        typedef typename rtree::container_from_elements_type<elements_type, std::pair<double, size_t> >::type
+            order_type;
+        order_type order(elements1_count);                                                                  // MAY THROW, STRONG (alloc)
+
+        kmeans::center<dimension> mean1, mean2;
+        bool const found = kmeans::find_means(centers, mean1, mean2);                                      // MAY THROW, STRONG (alloc)
+        size_t split_index = 0;
+        for ( size_t i = 0 ; i < elements1_count ; ++i )
+        {
+            order[i].first = found ? kmeans::distances_difference(centers[i], mean1, mean2) : 0;
+            order[i].second = i;
+            if ( order[i].first <= 0 )
+                ++split_index;
+        }
+        std::sort(order.begin(), order.end());
+
+        // both nodes must contain at least min elements, the boundary elements are moved
+        if ( !found )
+            split_index = elements1_count / 2;
+        if ( elements1_count < split_index + min_elements )
+            split_index = elements1_count - min_elements;
+        if ( split_index < min_elements )
+            split_index = min_elements;
+
+        // copy original elements - use in-memory storage (std::allocator)
+        // TODO: move if noexcept
+        typedef typename rtree::container_from_elements_type<elements_type, element_type>::type
+            container_type;
+        container_type elements_copy(elements1.begin(), elements1.end());                                   // MAY THROW, STRONG (alloc, copy)
+
+        // prepare nodes' elements containers
+        elements1.clear();
+        BOOST_GEOMETRY_INDEX_ASSERT(elements2.empty(), "unexpected container state");
+
+        BOOST_TRY
+        {
+            for ( size_t i = 0 ; i < elements1_count ; ++i )
+            {
+                element_type const& elem = elements_copy[order[i].second];
+                if ( i < split_index )
+                    elements1.push_back(elem);                                                              // MAY THROW, STRONG (copy)
+                else
+                    elements2.push_back(elem);                                                              // MAY THROW, STRONG (alloc, copy)
+            }
+
+            box1 = rtree::elements_box<Box>(elements1.begin(), elements1.end(), translator);
+            box2 = rtree::elements_box<Box>(elements2.begin(), elements2.end(), translator);
+        }
+        BOOST_CATCH(...)
+        {
+            elements1.clear();
+            elements2.clear();
+
+            rtree::destroy_elements<Value, Options, Translator, Box, Allocators>::apply(elements_copy, allocators);
+            //elements_copy.clear();
+
+            BOOST_RETHROW                                                                                     // RETHROW, BASIC
+        }
+        BOOST_CATCH_END
+    }
+};
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_KMEANS_REDISTRIBUTE_ELEMENTS_HPP
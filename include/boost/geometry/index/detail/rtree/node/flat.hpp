@@ -0,0 +1,215 @@
+// Boost.Geometry Index
+//
+// R-tree read-only nodes stored in a contiguous, relocatable memory block
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_FLAT_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_FLAT_HPP
+
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <boost/geometry/index/detail/rtree/node/concept.hpp>
+#include <boost/geometry/index/detail/rtree/node/pairs.hpp>
+#include <boost/geometry/index/detail/rtree/options.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+// The nodes are never created nor destroyed, they're only accessed in a memory block
+// created by visitors::flatten. All offsets are relative so the block may be mapped
+// at any address.
+
+template <typename Element>
+inline std::size_t flat_align(std::size_t offset)
+{
+    std::size_t const a = boost::alignment_of<Element>::value;
+    return (offset + a - 1) / a * a;
+}
+
+// Pointer storing an offset relative to its own address, 0 means null.
+// Copies store the offset relative to their own addresses.
+template <typename T>
+class flat_pointer
+{
+public:
+    explicit flat_pointer(T const* ptr = 0)
+        : m_offset(offset_to(ptr))
+    {}
+
+    flat_pointer(flat_pointer const& other)
+        : m_offset(offset_to(other.get()))
+    {}
+
+    flat_pointer & operator=(flat_pointer const& other)
+    {
+        m_offset = offset_to(other.get());
+        return *this;
+    }
+
+    T const* get() const
+    {
+        return m_offset == 0 ? 0 : reinterpret_cast<T const*>(address() + m_offset);
+    }
+
+    operator T const*() const { return get(); }
+    T const& operator*() const { return *get(); }
+    T const* operator->() const { return get(); }
+
+private:
+    char const* address() const
+    {
+        return reinterpret_cast<char const*>(this);
+    }
+
+    boost::int64_t offset_to(T const* ptr) const
+    {
+        return ptr == 0 ? 0 : reinterpret_cast<char const*>(ptr) - address();
+    }
+
+    boost::int64_t m_offset;
+};
+
+// The number of elements, the elements are stored directly after it.
+template <typename Element>
+class flat_elements
+{
+public:
+    typedef Element value_type;
+    typedef Element const& const_reference;
+    typedef Element const* const_iterator;
+    typedef std::size_t size_type;
+
+    explicit flat_elements(size_type size) : m_size(size) {}
+
+    // Elements offset calculated from the offset or address of this object
+    static std::size_t elements_offset(std::size_t this_offset)
+    {
+        return flat_align<Element>(this_offset + sizeof(flat_elements));
+    }
+
+    const_iterator begin() const
+    {
+        char const* const base = reinterpret_cast<char const*>(this);
+        std::size_t const this_address = reinterpret_cast<std::size_t>(base);
+        return reinterpret_cast<Element const*>(base + elements_offset(this_address) - this_address);
+    }
+
+    const_iterator end() const { return begin() + m_size; }
+    size_type size() const { return static_cast<size_type>(m_size); }
+    bool empty() const { return m_size == 0; }
+    const_reference operator[](size_type i) const { return begin()[i]; }
+
+private:
+    boost::uint64_t m_size;
+};
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct flat_node
+{
+    explicit flat_node(bool is_leaf) : m_is_leaf(is_leaf ? 1 : 0) {}
+
+    bool is_leaf() const { return m_is_leaf != 0; }
+
+private:
+    boost::uint64_t m_is_leaf;
+};
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct flat_internal_node
+    : public flat_node<Value, Parameters, Box, Allocators>
+{
+    typedef flat_elements<
+        rtree::ptr_pair<Box, flat_pointer< flat_node<Value, Parameters, Box, Allocators> > >
+    > elements_type;
+
+    explicit flat_internal_node(std::size_t count)
+        : flat_node<Value, Parameters, Box, Allocators>(false)
+        , elements(count)
+    {}
+
+    elements_type elements;
+};
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct flat_leaf
+    : public flat_node<Value, Parameters, Box, Allocators>
+{
+    typedef flat_elements<Value> elements_type;
+
+    explicit flat_leaf(std::size_t count)
+        : flat_node<Value, Parameters, Box, Allocators>(true)
+        , elements(count)
+    {}
+
+    elements_type elements;
+};
+
+template <typename Value, typename Parameters, typename Box, typename Allocators, bool IsVisitableConst>
+struct flat_visitor {};
+
+// nodes traits
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct node<Value, Parameters, Box, Allocators, node_flat_tag>
+{
+    typedef flat_node<Value, Parameters, Box, Allocators> type;
+};
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct internal_node<Value, Parameters, Box, Allocators, node_flat_tag>
+{
+    typedef flat_internal_node<Value, Parameters, Box, Allocators> type;
+};
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct leaf<Value, Parameters, Box, Allocators, node_flat_tag>
+{
+    typedef flat_leaf<Value, Parameters, Box, Allocators> type;
+};
+
+template <typename Value, typename Parameters, typename Box, typename Allocators, bool IsVisitableConst>
+struct visitor<Value, Parameters, Box, Allocators, node_flat_tag, IsVisitableConst>
+{
+    typedef flat_visitor<Value, Parameters, Box, Allocators, IsVisitableConst> type;
+};
+
+// apply visitor
+
+template <typename Visitor, typename Value, typename Parameters, typename Box, typename Allocators>
+inline void apply_visitor(Visitor & v, flat_node<Value, Parameters, Box, Allocators> const& n)
+{
+    if ( n.is_leaf() )
+        v(static_cast<flat_leaf<Value, Parameters, Box, Allocators> const&>(n));
+    else
+        v(static_cast<flat_internal_node<Value, Parameters, Box, Allocators> const&>(n));
+}
+
+// allocators
+// Nothing is allocated, only the types used by the visitors are defined.
+
+template <typename Value, typename Parameters, typename Box>
+struct flat_allocators
+{
+    typedef flat_node<Value, Parameters, Box, flat_allocators> const* node_pointer;
+
+    typedef Value value_type;
+    typedef Value const& reference;
+    typedef Value const& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value const* pointer;
+    typedef Value const* const_pointer;
+};
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_FLAT_HPP
@@ -26,6 +26,9 @@
 #include <boost/geometry/index/detail/rtree/node/variant_visitor.hpp>
 #include <boost/geometry/index/detail/rtree/node/variant_dynamic.hpp>
 #include <boost/geometry/index/detail/rtree/node/variant_static.hpp>
+#include <boost/geometry/index/detail/rtree/node/variant_soa.hpp>
+
+#include <boost/geometry/index/detail/rtree/node/flat.hpp>
 
 #include <boost/geometry/index/detail/rtree/node/subtree_destroyer.hpp>
 
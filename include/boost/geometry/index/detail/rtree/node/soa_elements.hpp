@@ -0,0 +1,549 @@
+// Boost.Geometry Index
+//
+// R-tree internal node elements stored in structure-of-arrays layout
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_SOA_ELEMENTS_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_SOA_ELEMENTS_HPP
+
+#include <cstddef>
+
+#include <boost/core/ignore_unused.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/cs.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/index/detail/assert.hpp>
+#include <boost/geometry/index/detail/algorithms/predicates_mask.hpp>
+#include <boost/geometry/index/detail/varray.hpp>
+#include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
+#include <boost/geometry/index/detail/rtree/node/pairs.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+// The elements of internal nodes stored as separate arrays of coordinates of the
+// children boxes and an array of pointers to the children nodes. The boxes of all
+// children may be tested in simple loops over contiguous coordinates.
+//
+// The container emulates varray<ptr_pair<Box, Pointer>, Capacity>. It's references
+// and iterators are proxies, the box of the element is represented by soa_box_ref
+// which is adapted to the Box concept so it may be passed to the algorithms directly.
+
+template <typename Container, bool IsConst>
+class soa_box_ref
+{
+    typedef typename boost::mpl::if_c<IsConst, Container const*, Container*>::type container_pointer;
+
+public:
+    typedef typename Container::box_type box_type;
+    typedef typename Container::size_type size_type;
+    typedef typename Container::coordinate_type coordinate_type;
+
+    soa_box_ref(container_pointer c, size_type i)
+        : m_container(c), m_index(i)
+    {}
+
+    template <bool IsConst2>
+    soa_box_ref(soa_box_ref<Container, IsConst2> const& other)
+        : m_container(other.container()), m_index(other.index())
+    {}
+
+    // Assignments copy the coordinates, the reference isn't rebound
+    soa_box_ref & operator=(soa_box_ref const& other)
+    {
+        m_container->assign_box(m_index, other.m_container->get_box(other.m_index));
+        return *this;
+    }
+
+    template <bool IsConst2>
+    soa_box_ref & operator=(soa_box_ref<Container, IsConst2> const& other)
+    {
+        m_container->assign_box(m_index, other.container()->get_box(other.index()));
+        return *this;
+    }
+
+    soa_box_ref & operator=(box_type const& b)
+    {
+        m_container->assign_box(m_index, b);
+        return *this;
+    }
+
+    operator box_type() const
+    {
+        return m_container->get_box(m_index);
+    }
+
+    template <std::size_t Corner, std::size_t Dimension>
+    coordinate_type get() const
+    {
+        return m_container->template coord<Corner, Dimension>(m_index);
+    }
+
+    template <std::size_t Corner, std::size_t Dimension>
+    void set(coordinate_type const& value) const
+    {
+        m_container->template coord<Corner, Dimension>(m_index) = value;
+    }
+
+    container_pointer container() const { return m_container; }
+    size_type index() const { return m_index; }
+
+private:
+    container_pointer m_container;
+    size_type m_index;
+};
+
+template <typename Container, bool IsConst>
+class soa_element_ref
+{
+    typedef typename boost::mpl::if_c<IsConst, Container const*, Container*>::type container_pointer;
+    typedef typename Container::pointer_type pointer_type;
+
+public:
+    typedef typename Container::value_type value_type;
+    typedef soa_box_ref<Container, IsConst> first_type;
+    typedef typename boost::mpl::if_c<IsConst, pointer_type const&, pointer_type&>::type second_type;
+
+    soa_element_ref(container_pointer c, typename Container::size_type i)
+        : first(c, i), second(c->child(i))
+    {}
+
+    template <bool IsConst2>
+    soa_element_ref(soa_element_ref<Container, IsConst2> const& other)
+        : first(other.first), second(other.second)
+    {}
+
+    // Assignments copy the values, the reference isn't rebound
+    soa_element_ref & operator=(soa_element_ref const& other)
+    {
+        first = other.first;
+        second = other.second;
+        return *this;
+    }
+
+    template <bool IsConst2>
+    soa_element_ref & operator=(soa_element_ref<Container, IsConst2> const& other)
+    {
+        first = other.first;
+        second = other.second;
+        return *this;
+    }
+
+    soa_element_ref & operator=(value_type const& v)
+    {
+        first = v.first;
+        second = v.second;
+        return *this;
+    }
+
+    operator value_type() const
+    {
+        return value_type(first, second);
+    }
+
+    first_type first;
+    second_type second;
+};
+
+template <typename Container, bool IsConst>
+class soa_iterator
+    : public boost::iterator_facade
+        <
+            soa_iterator<Container, IsConst>,
+            typename Container::value_type,
+            boost::random_access_traversal_tag,
+            soa_element_ref<Container, IsConst>,
+            std::ptrdiff_t
+        >
+{
+    typedef typename boost::mpl::if_c<IsConst, Container const*, Container*>::type container_pointer;
+
+public:
+    soa_iterator()
+        : m_container(0), m_index(0)
+    {}
+
+    soa_iterator(container_pointer c, typename Container::size_type i)
+        : m_container(c), m_index(i)
+    {}
+
+    template <bool IsConst2>
+    soa_iterator(soa_iterator<Container, IsConst2> const& other)
+        : m_container(other.container()), m_index(other.index())
+    {}
+
+    container_pointer container() const { return m_container; }
+    typename Container::size_type index() const { return m_index; }
+
+private:
+    friend class boost::iterator_core_access;
+
+    soa_element_ref<Container, IsConst> dereference() const
+    {
+        return soa_element_ref<Container, IsConst>(m_container, m_index);
+    }
+
+    template <bool IsConst2>
+    bool equal(soa_iterator<Container, IsConst2> const& other) const
+    {
+        return m_index == other.index();
+    }
+
+    void increment() { ++m_index; }
+    void decrement() { --m_index; }
+    void advance(std::ptrdiff_t n) { m_index += n; }
+
+    template <bool IsConst2>
+    std::ptrdiff_t distance_to(soa_iterator<Container, IsConst2> const& other) const
+    {
+        return std::ptrdiff_t(other.index()) - std::ptrdiff_t(m_index);
+    }
+
+    container_pointer m_container;
+    typename Container::size_type m_index;
+};
+
+template <std::size_t Corner, std::size_t Dimension, std::size_t DimensionCount>
+struct soa_coords
+{
+    template <typename Container, typename Box>
+    static inline void get(Container const& c, typename Container::size_type i, Box & b)
+    {
+        geometry::set<Corner, Dimension>(b, c.template coord<Corner, Dimension>(i));
+        soa_coords<Corner, Dimension + 1, DimensionCount>::get(c, i, b);
+    }
+
+    template <typename Container, typename Box>
+    static inline void set(Container & c, typename Container::size_type i, Box const& b)
+    {
+        c.template coord<Corner, Dimension>(i) = geometry::get<Corner, Dimension>(b);
+        soa_coords<Corner, Dimension + 1, DimensionCount>::set(c, i, b);
+    }
+};
+
+template <std::size_t Corner, std::size_t DimensionCount>
+struct soa_coords<Corner, DimensionCount, DimensionCount>
+{
+    template <typename Container, typename Box>
+    static inline void get(Container const& , typename Container::size_type , Box & ) {}
+    template <typename Container, typename Box>
+    static inline void set(Container & , typename Container::size_type , Box const& ) {}
+};
+
+template <typename Box, typename Pointer, std::size_t Capacity>
+class soa_elements
+{
+public:
+    typedef Box box_type;
+    typedef Pointer pointer_type;
+    typedef typename geometry::coordinate_type<Box>::type coordinate_type;
+    static const std::size_t dimension = geometry::dimension<Box>::value;
+    static const std::size_t static_capacity = Capacity;
+
+    typedef rtree::ptr_pair<Box, Pointer> value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef soa_element_ref<soa_elements, false> reference;
+    typedef soa_element_ref<soa_elements, true> const_reference;
+    typedef soa_iterator<soa_elements, false> iterator;
+    typedef soa_iterator<soa_elements, true> const_iterator;
+
+    soa_elements()
+        : m_size(0)
+    {}
+
+    soa_elements(soa_elements const& other)
+        : m_size(0)
+    {
+        assign(other.begin(), other.end());
+    }
+
+    soa_elements & operator=(soa_elements const& other)
+    {
+        if ( this != &other )
+            assign(other.begin(), other.end());
+        return *this;
+    }
+
+    template <typename It>
+    void assign(It first, It last)
+    {
+        m_size = 0;
+        for ( ; first != last ; ++first )
+            push_back(*first);
+    }
+
+    void push_back(value_type const& v)
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(m_size < Capacity, "size too big");
+        assign_box(m_size, v.first);
+        m_children[m_size] = v.second;
+        ++m_size;
+    }
+
+    template <bool IsConst>
+    void push_back(soa_element_ref<soa_elements, IsConst> const& r)
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(m_size < Capacity, "size too big");
+        assign_box(m_size, r.first.container()->get_box(r.first.index()));
+        m_children[m_size] = r.second;
+        ++m_size;
+    }
+
+    void reserve(size_type n)
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(n <= Capacity, "size too big");
+        ::boost::ignore_unused(n);
+    }
+
+    void pop_back()
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(0 < m_size, "there are no elements in the container");
+        --m_size;
+    }
+
+    iterator erase(iterator position)
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(position.index() < m_size, "invalid iterator");
+        for ( size_type i = position.index() + 1 ; i < m_size ; ++i )
+            (*this)[i - 1] = (*this)[i];
+        --m_size;
+        return position;
+    }
+
+    void clear() { m_size = 0; }
+
+    void swap(soa_elements & other)
+    {
+        soa_elements temp(other);
+        other = *this;
+        *this = temp;
+    }
+
+    size_type size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    static size_type capacity() { return Capacity; }
+    static size_type max_size() { return Capacity; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_size); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_size); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    reference operator[](size_type i)
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(i < m_size, "index out of bounds");
+        return reference(this, i);
+    }
+
+    const_reference operator[](size_type i) const
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(i < m_size, "index out of bounds");
+        return const_reference(this, i);
+    }
+
+    reference front() { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+    reference back() { return (*this)[m_size - 1]; }
+    const_reference back() const { return (*this)[m_size - 1]; }
+
+    // Direct access to the arrays
+
+    template <std::size_t Corner, std::size_t Dimension>
+    coordinate_type & coord(size_type i)
+    {
+        return Corner == min_corner ? m_min[Dimension][i] : m_max[Dimension][i];
+    }
+
+    template <std::size_t Corner, std::size_t Dimension>
+    coordinate_type const& coord(size_type i) const
+    {
+        return Corner == min_corner ? m_min[Dimension][i] : m_max[Dimension][i];
+    }
+
+    coordinate_type const* min_coords(std::size_t d) const { return m_min[d]; }
+    coordinate_type const* max_coords(std::size_t d) const { return m_max[d]; }
+
+    Pointer & child(size_type i) { return m_children[i]; }
+    Pointer const& child(size_type i) const { return m_children[i]; }
+
+    Box get_box(size_type i) const
+    {
+        Box result;
+        soa_coords<min_corner, 0, dimension>::get(*this, i, result);
+        soa_coords<max_corner, 0, dimension>::get(*this, i, result);
+        return result;
+    }
+
+    void assign_box(size_type i, Box const& b)
+    {
+        soa_coords<min_corner, 0, dimension>::set(*this, i, b);
+        soa_coords<max_corner, 0, dimension>::set(*this, i, b);
+    }
+
+private:
+    coordinate_type m_min[dimension][Capacity];
+    coordinate_type m_max[dimension][Capacity];
+    Pointer m_children[Capacity];
+    size_type m_size;
+};
+
+// element's indexable getter
+
+template <typename Container, bool IsConst, typename Translator>
+inline soa_box_ref<Container, true>
+element_indexable(soa_element_ref<Container, IsConst> const& el, Translator const& /*tr*/)
+{
+    return el.first;
+}
+
+// intersection of the children boxes with a cartesian point or box
+
+// The tests of all children are performed dimension by dimension over the
+// contiguous coordinates, with SIMD instructions if they're available.
+// The conditions are the same as in the cartesian disjoint strategies.
+
+template <typename Geometry, typename Tag = typename geometry::tag<Geometry>::type>
+struct soa_geometry_bounds
+{};
+
+template <typename Point>
+struct soa_geometry_bounds<Point, point_tag>
+{
+    typedef typename geometry::coordinate_type<Point>::type coordinate_type;
+
+    template <std::size_t Dimension>
+    static inline coordinate_type get_min(Point const& p) { return geometry::get<Dimension>(p); }
+    template <std::size_t Dimension>
+    static inline coordinate_type get_max(Point const& p) { return geometry::get<Dimension>(p); }
+};
+
+template <typename Box>
+struct soa_geometry_bounds<Box, box_tag>
+{
+    typedef typename geometry::coordinate_type<Box>::type coordinate_type;
+
+    template <std::size_t Dimension>
+    static inline coordinate_type get_min(Box const& b) { return geometry::get<min_corner, Dimension>(b); }
+    template <std::size_t Dimension>
+    static inline coordinate_type get_max(Box const& b) { return geometry::get<max_corner, Dimension>(b); }
+};
+
+template <typename Elements, typename Geometry>
+struct soa_intersects_enabled
+{
+    static const bool value =
+        (boost::is_same<typename geometry::tag<Geometry>::type, point_tag>::value
+            || boost::is_same<typename geometry::tag<Geometry>::type, box_tag>::value)
+        && boost::is_same<typename geometry::cs_tag<Geometry>::type, cartesian_tag>::value
+        && boost::is_same<typename geometry::cs_tag<typename Elements::box_type>::type, cartesian_tag>::value
+        && geometry::dimension<Geometry>::value == Elements::dimension;
+};
+
+template <std::size_t Dimension, std::size_t DimensionCount>
+struct soa_intersects_dimension
+{
+    template <typename Elements, typename Geometry>
+    static inline void apply(Elements const& elements, Geometry const& g, unsigned char * flags)
+    {
+        typedef soa_geometry_bounds<Geometry> bounds;
+
+        index::detail::predicate_dimension_mask<index::detail::predicates_mask::box_intersects>(
+            elements.min_coords(Dimension), elements.max_coords(Dimension),
+            bounds::template get_min<Dimension>(g), bounds::template get_max<Dimension>(g),
+            elements.size(), flags);
+
+        soa_intersects_dimension<Dimension + 1, DimensionCount>::apply(elements, g, flags);
+    }
+};
+
+template <std::size_t DimensionCount>
+struct soa_intersects_dimension<DimensionCount, DimensionCount>
+{
+    template <typename Elements, typename Geometry>
+    static inline void apply(Elements const& , Geometry const& , unsigned char * ) {}
+};
+
+// flags must point to at least elements.size() values
+template <typename Box, typename Pointer, std::size_t Capacity, typename Geometry>
+inline void soa_intersects(soa_elements<Box, Pointer, Capacity> const& elements,
+                           Geometry const& g,
+                           unsigned char * flags)
+{
+    typedef soa_elements<Box, Pointer, Capacity> elements_type;
+
+    BOOST_MPL_ASSERT_MSG((soa_intersects_enabled<elements_type, Geometry>::value),
+                         NOT_IMPLEMENTED_FOR_THIS_GEOMETRY,
+                         (Geometry));
+
+    std::size_t const size = elements.size();
+    for ( std::size_t i = 0 ; i < size ; ++i )
+        flags[i] = 1;
+
+    soa_intersects_dimension<0, elements_type::dimension>::apply(elements, g, flags);
+}
+
+// elements derived type
+
+template <typename Box, typename Pointer, std::size_t Capacity, typename NewValue>
+struct container_from_elements_type<soa_elements<Box, Pointer, Capacity>, NewValue>
+{
+    typedef detail::varray<NewValue, Capacity> type;
+};
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#ifndef DOXYGEN_NO_TRAITS_SPECIALIZATIONS
+namespace boost { namespace geometry { namespace traits {
+
+template <typename Container, bool IsConst>
+struct tag< index::detail::rtree::soa_box_ref<Container, IsConst> >
+{
+    typedef box_tag type;
+};
+
+template <typename Container, bool IsConst>
+struct point_type< index::detail::rtree::soa_box_ref<Container, IsConst> >
+{
+    typedef typename geometry::point_type<typename Container::box_type>::type type;
+};
+
+template <typename Container, bool IsConst, std::size_t Corner, std::size_t Dimension>
+struct indexed_access< index::detail::rtree::soa_box_ref<Container, IsConst>, Corner, Dimension >
+{
+    typedef index::detail::rtree::soa_box_ref<Container, IsConst> box_ref;
+    typedef typename Container::coordinate_type coordinate_type;
+
+    static inline coordinate_type get(box_ref const& b)
+    {
+        return b.template get<Corner, Dimension>();
+    }
+
+    static inline void set(box_ref & b, coordinate_type const& value)
+    {
+        b.template set<Corner, Dimension>(value);
+    }
+};
+
+}}} // namespace boost::geometry::traits
+#endif // DOXYGEN_NO_TRAITS_SPECIALIZATIONS
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_SOA_ELEMENTS_HPP
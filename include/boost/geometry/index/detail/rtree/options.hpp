@@ -27,18 +27,20 @@ struct choose_by_overlap_diff_tag {};
 
 // SplitTag
 struct split_default_tag {};
-//struct split_kmeans_tag {};
 
 // RedistributeTag
 struct linear_tag {};
 struct quadratic_tag {};
 struct rstar_tag {};
+struct kmeans_tag {};
 
 // NodeTag
 struct node_variant_dynamic_tag {};
 struct node_variant_static_tag {};
+struct node_variant_soa_tag {};
 //struct node_weak_dynamic_tag {};
 //struct node_weak_static_tag {};
+struct node_flat_tag {};
 
 template <typename Parameters, typename InsertTag, typename ChooseNextNodeTag, typename SplitTag, typename RedistributeTag, typename NodeTag>
 struct options
@@ -96,18 +98,33 @@ struct options_type< index::rstar<MaxElements, MinElements, OverlapCostThreshold
     > type;
 };
 
-//template <size_t MaxElements, size_t MinElements>
-//struct options_type< kmeans<MaxElements, MinElements> >
-//{
-//    typedef options<
-//        kmeans<MaxElements, MinElements>,
-//        insert_default_tag,
-//        choose_by_content_diff_tag, // change it?
-//        split_kmeans_tag,
-//        int, // dummy tag - not used for now
-//        node_variant_static_tag
-//    > type;
-//};
+template <size_t MaxElements, size_t MinElements>
+struct options_type< index::kmeans<MaxElements, MinElements> >
+{
+    typedef options<
+        index::kmeans<MaxElements, MinElements>,
+        insert_default_tag,
+        choose_by_content_diff_tag,
+        split_default_tag,
+        kmeans_tag,
+        node_variant_static_tag
+    > type;
+};
+
+template <typename Parameters>
+struct options_type< index::soa_nodes<Parameters> >
+{
+    typedef typename options_type<Parameters>::type options_base;
+
+    typedef options<
+        index::soa_nodes<Parameters>,
+        typename options_base::insert_tag,
+        typename options_base::choose_next_node_tag,
+        typename options_base::split_tag,
+        typename options_base::redistribute_tag,
+        node_variant_soa_tag
+    > type;
+};
 
 template <>
 struct options_type< index::dynamic_linear >
@@ -135,6 +152,19 @@ struct options_type< index::dynamic_quadratic >
     > type;
 };
 
+template <>
+struct options_type< index::dynamic_kmeans >
+{
+    typedef options<
+        index::dynamic_kmeans,
+        insert_default_tag,
+        choose_by_content_diff_tag,
+        split_default_tag,
+        kmeans_tag,
+        node_variant_dynamic_tag
+    > type;
+};
+
 template <>
 struct options_type< index::dynamic_rstar >
 {
@@ -11,13 +11,19 @@
 #ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_CREATE_HPP
 #define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_CREATE_HPP
 
+#include <algorithm>
+#include <vector>
+
 #include <boost/core/ignore_unused.hpp>
 
 #include <boost/geometry/algorithms/expand.hpp>
 #include <boost/geometry/index/detail/algorithms/bounds.hpp>
+#include <boost/geometry/index/detail/algorithms/hilbert_key.hpp>
 #include <boost/geometry/index/detail/algorithms/nth_element.hpp>
+#include <boost/geometry/index/packing.hpp>
 
 #include <boost/geometry/algorithms/detail/expand_by_epsilon.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree {
 
@@ -93,6 +99,15 @@ struct nth_element_and_half_boxes<Dimension, Dimension>
     static inline void apply(EIt , EIt , EIt , Box const& , Box & , Box & , std::size_t ) {}
 };
 
+struct curve_entries_comparer
+{
+    template <typename CurveEntry>
+    bool operator()(CurveEntry const& e1, CurveEntry const& e2) const
+    {
+        return e1.first < e2.first;
+    }
+};
+
 } // namespace pack_utils
 
 // STR leafs number are calculated as rcount/max
@@ -152,6 +167,17 @@ public:
     template <typename InIt> inline static
     node_pointer apply(InIt first, InIt last, size_type & values_count, size_type & leafs_level,
                        parameters_type const& parameters, Translator const& translator, Allocators & allocators)
+    {
+        return apply(first, last, values_count, leafs_level, parameters, translator, allocators,
+                     index::parallel_packing(1));
+    }
+
+    // Arbitrary iterators, subtrees of upper levels may be created in separate threads
+    // The structure of the tree is the same as the one created sequentially
+    template <typename InIt> inline static
+    node_pointer apply(InIt first, InIt last, size_type & values_count, size_type & leafs_level,
+                       parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                       index::parallel_packing const& packing)
     {
         typedef typename std::iterator_traits<InIt>::difference_type diff_type;
             
@@ -188,11 +214,115 @@ public:
 
         subtree_elements_counts subtree_counts = calculate_subtree_elements_counts(values_count, parameters, leafs_level);
         internal_element el = per_level(entries.begin(), entries.end(), hint_box.get(), values_count, subtree_counts,
-                                        parameters, translator, allocators);
+                                        parameters, translator, allocators,
+                                        threads_info(packing.get_threads(), packing.get_min_subtree_values()));
 
         return el.second;
     }
 
+    // Arbitrary iterators, values sorted by the keys of the space-filling curve
+    // The nodes of each level are filled sequentially, only the last two nodes
+    // of a level may contain less than max elements
+    template <typename InIt> inline static
+    node_pointer apply(InIt first, InIt last, size_type & values_count, size_type & leafs_level,
+                       parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                       index::curve_packing const& packing)
+    {
+        typedef typename std::iterator_traits<InIt>::difference_type diff_type;
+
+        diff_type diff = std::distance(first, last);
+        if ( diff <= 0 )
+            return node_pointer(0);
+
+        typedef std::pair<index::detail::hilbert_key_type, InIt> entry_type;
+        std::vector<entry_type> entries;
+
+        values_count = static_cast<size_type>(diff);
+        entries.reserve(values_count);
+
+        expandable_box<Box> hint_box;
+        for ( ; first != last ; ++first )
+        {
+            typename std::iterator_traits<InIt>::reference in_ref = *first;
+            typename Translator::result_type indexable = translator(in_ref);
+
+            // NOTE: added for consistency with insert()
+            BOOST_GEOMETRY_INDEX_ASSERT(detail::is_valid(indexable), "Indexable is invalid");
+
+            hint_box.expand(indexable);
+            entries.push_back(std::make_pair(index::detail::hilbert_key_type(0), first));
+        }
+
+        // the keys of the centers of the bounds of indexables in the space of all of the values
+        for ( typename std::vector<entry_type>::iterator it = entries.begin() ; it != entries.end() ; ++it )
+        {
+            Box b;
+            detail::bounds(translator(*(it->second)), b);
+            it->first = packing.get_curve() == index::z_order_curve ?
+                        index::detail::morton_key(b, hint_box.get()) :
+                        index::detail::hilbert_key(b, hint_box.get());
+        }
+
+        std::sort(entries.begin(), entries.end(), pack_utils::curve_entries_comparer());
+
+        // leafs
+        typedef std::vector<internal_element> level_elements_type;
+        level_elements_type level_elements;
+        elements_destroyer<level_elements_type> level_remover(level_elements, allocators);
+
+        std::size_t nodes_count = sequential_nodes_count(values_count, parameters);
+        level_elements.reserve(nodes_count);                                                                // MAY THROW (A)
+        typename std::vector<entry_type>::iterator entries_first = entries.begin();
+        for ( std::size_t i = 0 ; i < nodes_count ; ++i )
+        {
+            std::size_t const count = sequential_node_size(i, nodes_count, values_count, parameters);
+            level_elements.push_back(create_leaf(entries_first, entries_first + count, count,
+                                                 translator, allocators));                                  // MAY THROW (A,C)
+            entries_first += count;
+        }
+
+        // internal nodes, level by level up to the root
+        leafs_level = 0;
+        while ( 1 < level_elements.size() )
+        {
+            level_elements_type upper_elements;
+            elements_destroyer<level_elements_type> upper_remover(upper_elements, allocators);
+
+            std::size_t const elements_count = level_elements.size();
+            nodes_count = sequential_nodes_count(elements_count, parameters);
+            upper_elements.reserve(nodes_count);                                                            // MAY THROW (A)
+
+            std::size_t j = 0;
+            for ( std::size_t i = 0 ; i < nodes_count ; ++i )
+            {
+                std::size_t const count = sequential_node_size(i, nodes_count, elements_count, parameters);
+
+                node_pointer n = rtree::create_node<Allocators, internal_node>::apply(allocators);          // MAY THROW (A)
+                subtree_destroyer auto_remover(n, allocators);
+                internal_node & in = rtree::get<internal_node>(*n);
+
+                rtree::elements(in).reserve(count);                                                         // MAY THROW (A)
+                expandable_box<Box> elements_box;
+                for ( std::size_t const j_end = j + count ; j < j_end ; ++j )
+                {
+                    rtree::elements(in).push_back(level_elements[j]);                                       // MAY THROW (A?,C)
+                    level_elements[j].second = 0;
+                    elements_box.expand(level_elements[j].first);
+                }
+
+                upper_elements.push_back(internal_element(elements_box.get(), n));                        // MAY THROW (A?,C)
+                auto_remover.release();
+            }
+
+            level_elements.swap(upper_elements);
+            ++leafs_level;
+        }
+
+        node_pointer root = level_elements.front().second;
+        level_elements.front().second = 0;
+        return root;
+    }
+
 private:
     template <typename BoxType>
     class expandable_box
@@ -249,9 +379,127 @@ private:
         std::size_t minc;
     };
 
+    struct threads_info
+    {
+        threads_info(std::size_t c, std::size_t m) : count(c), min_values(m) {}
+        std::size_t count;
+        std::size_t min_values;
+    };
+
+    // Destroys subtrees stored in a temporary container, null pointers are skipped
+    template <typename Elements>
+    class elements_destroyer
+    {
+        elements_destroyer(elements_destroyer const&);
+        elements_destroyer & operator=(elements_destroyer const&);
+
+    public:
+        elements_destroyer(Elements & elements, Allocators & allocators)
+            : m_elements(elements)
+            , m_allocators(allocators)
+        {}
+
+        ~elements_destroyer()
+        {
+            for ( typename Elements::iterator it = m_elements.begin() ; it != m_elements.end() ; ++it )
+            {
+                subtree_destroyer dummy(it->second, m_allocators);
+                it->second = 0;
+            }
+        }
+
+    private:
+        Elements & m_elements;
+        Allocators & m_allocators;
+    };
+
+    // Calls per_level_packets(), used to execute it in a separate thread
+    template <typename EIt, typename Elements, typename ExpandableBox>
+    struct packets_task
+    {
+        packets_task(EIt f, EIt l, Box const& hb, std::size_t vc,
+                     subtree_elements_counts const& sc, subtree_elements_counts const& nsc,
+                     Elements & els, ExpandableBox & elsb,
+                     parameters_type const& p, Translator const& t, Allocators & a,
+                     threads_info const& ti)
+            : first(f), last(l), hint_box(hb), values_count(vc)
+            , subtree_counts(sc), next_subtree_counts(nsc)
+            , elements(els), elements_box(elsb)
+            , parameters(p), translator(t), allocators(a)
+            , threads(ti)
+        {}
+
+        void operator()()
+        {
+            per_level_packets(first, last, hint_box, values_count, subtree_counts, next_subtree_counts,
+                              elements, elements_box,
+                              parameters, translator, allocators, threads);
+        }
+
+        EIt first, last;
+        Box const& hint_box;
+        std::size_t values_count;
+        subtree_elements_counts const& subtree_counts;
+        subtree_elements_counts const& next_subtree_counts;
+        Elements & elements;
+        ExpandableBox & elements_box;
+        parameters_type const& parameters;
+        Translator const& translator;
+        Allocators & allocators;
+        threads_info threads;
+    };
+
+    // Creates the leaf containing the values pointed by the iterators stored in the entries
+    template <typename EIt> inline static
+    internal_element create_leaf(EIt first, EIt last, std::size_t values_count,
+                                 Translator const& translator, Allocators & allocators)
+    {
+        // create new leaf node
+        node_pointer n = rtree::create_node<Allocators, leaf>::apply(allocators);                       // MAY THROW (A)
+        subtree_destroyer auto_remover(n, allocators);
+        leaf & l = rtree::get<leaf>(*n);
+
+        // reserve space for values
+        rtree::elements(l).reserve(values_count);                                                       // MAY THROW (A)
+
+        // calculate values box and copy values
+        //   initialize the box explicitly to avoid GCC-4.4 uninitialized variable warnings with O2
+        expandable_box<Box> elements_box(translator(*(first->second)));
+        rtree::elements(l).push_back(*(first->second));                                                 // MAY THROW (A?,C)
+        for ( ++first ; first != last ; ++first )
+        {
+            // NOTE: push_back() must be called at the end in order to support move_iterator.
+            //       The iterator is dereferenced 2x (no temporary reference) to support
+            //       non-true reference types and move_iterator without boost::forward<>.
+            elements_box.expand(translator(*(first->second)));
+            rtree::elements(l).push_back(*(first->second));                                             // MAY THROW (A?,C)
+        }
+
+#ifdef BOOST_GEOMETRY_INDEX_EXPERIMENTAL_ENLARGE_BY_EPSILON
+        // Enlarge bounds of a leaf node.
+        // It's because Points and Segments are compared WRT machine epsilon
+        // This ensures that leafs bounds correspond to the stored elements
+        // NOTE: this is done only if the Indexable is a different kind of Geometry
+        //   than the bounds (only Box for now). Spatial predicates are checked
+        //   the same way for Geometry of the same kind.
+        if ( BOOST_GEOMETRY_CONDITION((
+                ! index::detail::is_bounding_geometry
+                    <
+                        typename indexable_type<Translator>::type
+                    >::value )) )
+        {
+            elements_box.expand_by_epsilon();
+        }
+#endif
+
+        auto_remover.release();
+        return internal_element(elements_box.get(), n);
+    }
+
     template <typename EIt> inline static
     internal_element per_level(EIt first, EIt last, Box const& hint_box, std::size_t values_count, subtree_elements_counts const& subtree_counts,
-                               parameters_type const& parameters, Translator const& translator, Allocators & allocators)
+                               parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                               threads_info const& threads)
     {
         BOOST_GEOMETRY_INDEX_ASSERT(0 < std::distance(first, last) && static_cast<std::size_t>(std::distance(first, last)) == values_count,
                                     "unexpected parameters");
@@ -263,46 +511,7 @@ private:
                                         "too big number of elements");
             // if !root check m_parameters.get_min_elements() <= count
 
-            // create new leaf node
-            node_pointer n = rtree::create_node<Allocators, leaf>::apply(allocators);                       // MAY THROW (A)
-            subtree_destroyer auto_remover(n, allocators);
-            leaf & l = rtree::get<leaf>(*n);
-
-            // reserve space for values
-            rtree::elements(l).reserve(values_count);                                                       // MAY THROW (A)
-
-            // calculate values box and copy values
-            //   initialize the box explicitly to avoid GCC-4.4 uninitialized variable warnings with O2
-            expandable_box<Box> elements_box(translator(*(first->second)));
-            rtree::elements(l).push_back(*(first->second));                                                 // MAY THROW (A?,C)
-            for ( ++first ; first != last ; ++first )
-            {
-                // NOTE: push_back() must be called at the end in order to support move_iterator.
-                //       The iterator is dereferenced 2x (no temporary reference) to support
-                //       non-true reference types and move_iterator without boost::forward<>.
-                elements_box.expand(translator(*(first->second)));
-                rtree::elements(l).push_back(*(first->second));                                             // MAY THROW (A?,C)
-            }
-
-#ifdef BOOST_GEOMETRY_INDEX_EXPERIMENTAL_ENLARGE_BY_EPSILON
-            // Enlarge bounds of a leaf node.
-            // It's because Points and Segments are compared WRT machine epsilon
-            // This ensures that leafs bounds correspond to the stored elements
-            // NOTE: this is done only if the Indexable is a different kind of Geometry
-            //   than the bounds (only Box for now). Spatial predicates are checked
-            //   the same way for Geometry of the same kind.
-            if ( BOOST_GEOMETRY_CONDITION((
-                    ! index::detail::is_bounding_geometry
-                        <
-                            typename indexable_type<Translator>::type
-                        >::value )) )
-            {
-                elements_box.expand_by_epsilon();
-            }
-#endif
-
-            auto_remover.release();
-            return internal_element(elements_box.get(), n);
+            return create_leaf(first, last, values_count, translator, allocators);
         }
 
         // calculate next max and min subtree counts
@@ -323,19 +532,20 @@ private:
         
         per_level_packets(first, last, hint_box, values_count, subtree_counts, next_subtree_counts,
                           rtree::elements(in), elements_box,
-                          parameters, translator, allocators);
+                          parameters, translator, allocators, threads);
 
         auto_remover.release();
         return internal_element(elements_box.get(), n);
     }
 
-    template <typename EIt, typename ExpandableBox> inline static
+    template <typename EIt, typename Elements, typename ExpandableBox> inline static
     void per_level_packets(EIt first, EIt last, Box const& hint_box,
                            std::size_t values_count,
                            subtree_elements_counts const& subtree_counts,
                            subtree_elements_counts const& next_subtree_counts,
-                           internal_elements & elements, ExpandableBox & elements_box,
-                           parameters_type const& parameters, Translator const& translator, Allocators & allocators)
+                           Elements & elements, ExpandableBox & elements_box,
+                           parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                           threads_info const& threads)
     {
         BOOST_GEOMETRY_INDEX_ASSERT(0 < std::distance(first, last) && static_cast<std::size_t>(std::distance(first, last)) == values_count,
                                     "unexpected parameters");
@@ -348,7 +558,7 @@ private:
         {
             // the end, move to the next level
             internal_element el = per_level(first, last, hint_box, values_count, next_subtree_counts,
-                                            parameters, translator, allocators);
+                                            parameters, translator, allocators, threads);
 
             // in case if push_back() do throw here
             // and even if this is not probable (previously reserved memory, nonthrowing pairs copy)
@@ -372,14 +582,68 @@ private:
         pack_utils::nth_element_and_half_boxes<0, dimension>
             ::apply(first, median, last, hint_box, left, right, greatest_dim_index);
         
+        if ( 1 < threads.count && threads.min_values <= values_count - median_count )
+        {
+            per_level_packets_parallel(first, median, last, left, right,
+                                       values_count, median_count, subtree_counts, next_subtree_counts,
+                                       elements, elements_box,
+                                       parameters, translator, allocators, threads);
+            return;
+        }
+
         per_level_packets(first, median, left,
                           median_count, subtree_counts, next_subtree_counts,
                           elements, elements_box,
-                          parameters, translator, allocators);
+                          parameters, translator, allocators, threads);
         per_level_packets(median, last, right,
                           values_count - median_count, subtree_counts, next_subtree_counts,
                           elements, elements_box,
-                          parameters, translator, allocators);
+                          parameters, translator, allocators, threads);
+    }
+
+    // The left packets are created in the calling thread and the right ones in a separate thread.
+    // The right subtrees are stored in a temporary container and then appended to elements
+    // so the order of elements is the same as if the packets were created sequentially.
+    template <typename EIt, typename Elements, typename ExpandableBox> inline static
+    void per_level_packets_parallel(EIt first, EIt median, EIt last, Box const& left, Box const& right,
+                                    std::size_t values_count, std::size_t median_count,
+                                    subtree_elements_counts const& subtree_counts,
+                                    subtree_elements_counts const& next_subtree_counts,
+                                    Elements & elements, ExpandableBox & elements_box,
+                                    parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                                    threads_info const& threads)
+    {
+        typedef std::vector<internal_element> right_elements_type;
+
+        std::size_t const right_threads_count = threads.count / 2;
+        threads_info const left_threads(threads.count - right_threads_count, threads.min_values);
+        threads_info const right_threads(right_threads_count, threads.min_values);
+
+        right_elements_type right_elements;
+        expandable_box<Box> right_elements_box;
+        elements_destroyer<right_elements_type> right_remover(right_elements, allocators);
+
+        packets_task<EIt, Elements, ExpandableBox>
+            left_task(first, median, left,
+                      median_count, subtree_counts, next_subtree_counts,
+                      elements, elements_box,
+                      parameters, translator, allocators, left_threads);
+        packets_task<EIt, right_elements_type, expandable_box<Box> >
+            right_task(median, last, right,
+                       values_count - median_count, subtree_counts, next_subtree_counts,
+                       right_elements, right_elements_box,
+                       parameters, translator, allocators, right_threads);
+
+        geometry::detail::parallel::invoke(right_task, left_task);                  // MAY THROW (A?,C)
+
+        for ( typename right_elements_type::iterator it = right_elements.begin() ; it != right_elements.end() ; ++it )
+        {
+            // elements should have memory allocated, reserve() called in per_level()
+            elements.push_back(*it);                                                // MAY THROW (A?,C) - however in normal conditions shouldn't
+            it->second = 0;
+        }
+
+        elements_box.expand(right_elements_box.get());
     }
 
     inline static
@@ -420,6 +684,39 @@ private:
         return n;
     }
 
+    // The number of nodes of a level filled sequentially
+    inline static
+    std::size_t sequential_nodes_count(std::size_t count, parameters_type const& parameters)
+    {
+        std::size_t const max_elements = parameters.get_max_elements();
+        return (count + max_elements - 1) / max_elements;
+    }
+
+    // The number of elements of the i-th node of a level filled sequentially,
+    // e.g. for max = 5, min = 2 and count = 16 the nodes contain 5, 5, 4, 2 elements
+    inline static
+    std::size_t sequential_node_size(std::size_t i, std::size_t nodes_count, std::size_t count,
+                                     parameters_type const& parameters)
+    {
+        std::size_t const max_elements = parameters.get_max_elements();
+        std::size_t const min_elements = parameters.get_min_elements();
+        std::size_t const last_count = count - (nodes_count - 1) * max_elements;
+
+        if ( 1 < nodes_count && last_count < min_elements )
+        {
+            if ( i + 1 == nodes_count )
+                return min_elements;
+            else if ( i + 2 == nodes_count )
+                return max_elements + last_count - min_elements;
+        }
+        else if ( i + 1 == nodes_count )
+        {
+            return last_count;
+        }
+
+        return max_elements;
+    }
+
     inline static
     std::size_t calculate_median_count(std::size_t count,
                                        subtree_elements_counts const& subtree_counts)
@@ -0,0 +1,57 @@
+// Boost.Geometry Index
+//
+// R-tree counters of the work done by queries
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_QUERY_COUNTERS_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_QUERY_COUNTERS_HPP
+
+#include <cstddef>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree {
+
+// Updates the Statistics, e.g. index::query_statistics, while the nodes are
+// visited by a query. For void Statistics nothing is done so the queries
+// without statistics are not affected.
+
+template <typename Statistics>
+class query_counters
+{
+public:
+    explicit query_counters(Statistics * statistics)
+        : m_statistics(statistics)
+    {}
+
+    inline void internal_node(std::size_t elements_count) const
+    {
+        ++m_statistics->nodes;
+        m_statistics->predicates_checks += elements_count;
+    }
+
+    inline void leaf(std::size_t values_count) const
+    {
+        ++m_statistics->nodes;
+        ++m_statistics->leaves;
+        m_statistics->predicates_checks += values_count;
+    }
+
+private:
+    Statistics * m_statistics;
+};
+
+template <>
+class query_counters<void>
+{
+public:
+    explicit query_counters(void *) {}
+
+    inline void internal_node(std::size_t ) const {}
+    inline void leaf(std::size_t ) const {}
+};
+
+}}}}} // namespace boost::geometry::index::detail::rtree
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_QUERY_COUNTERS_HPP
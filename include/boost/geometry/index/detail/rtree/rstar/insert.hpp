@@ -188,8 +188,9 @@ struct level_insert_base
                              parameters_type const& parameters,
                              Translator const& translator,
                              Allocators & allocators,
-                             size_type relative_level)
-        : base(root, leafs_level, element, parameters, translator, allocators, relative_level)
+                             size_type relative_level,
+                             index::insert_statistics * statistics)
+        : base(root, leafs_level, element, parameters, translator, allocators, relative_level, statistics)
         , result_relative_level(0)
     {}
 
@@ -279,8 +280,9 @@ struct level_insert
                         parameters_type const& parameters,
                         Translator const& translator,
                         Allocators & allocators,
-                        size_type relative_level)
-        : base(root, leafs_level, element, parameters, translator, allocators, relative_level)
+                        size_type relative_level,
+                        index::insert_statistics * statistics)
+        : base(root, leafs_level, element, parameters, translator, allocators, relative_level, statistics)
     {}
 
     inline void operator()(internal_node & n)
@@ -365,8 +367,9 @@ struct level_insert<InsertIndex, Value, Value, Options, Translator, Box, Allocat
                         parameters_type const& parameters,
                         Translator const& translator,
                         Allocators & allocators,
-                        size_type relative_level)
-        : base(root, leafs_level, v, parameters, translator, allocators, relative_level)
+                        size_type relative_level,
+                        index::insert_statistics * statistics)
+        : base(root, leafs_level, v, parameters, translator, allocators, relative_level, statistics)
     {}
 
     inline void operator()(internal_node & n)
@@ -421,8 +424,9 @@ struct level_insert<0, Value, Value, Options, Translator, Box, Allocators>
                         parameters_type const& parameters,
                         Translator const& translator,
                         Allocators & allocators,
-                        size_type relative_level)
-        : base(root, leafs_level, v, parameters, translator, allocators, relative_level)
+                        size_type relative_level,
+                        index::insert_statistics * statistics)
+        : base(root, leafs_level, v, parameters, translator, allocators, relative_level, statistics)
     {}
 
     inline void operator()(internal_node & n)
@@ -480,10 +484,12 @@ public:
                   parameters_type const& parameters,
                   Translator const& translator,
                   Allocators & allocators,
-                  size_type relative_level = 0)
+                  size_type relative_level = 0,
+                  index::insert_statistics * statistics = 0)
         : m_root(root), m_leafs_level(leafs_level), m_element(element)
         , m_parameters(parameters), m_translator(translator)
         , m_relative_level(relative_level), m_allocators(allocators)
+        , m_statistics(statistics)
     {}
 
     inline void operator()(internal_node & n)
@@ -495,7 +501,7 @@ public:
         if ( m_parameters.get_reinserted_elements() > 0 )
         {
             rstar::level_insert<0, Element, Value, Options, Translator, Box, Allocators> lins_v(
-                m_root, m_leafs_level, m_element, m_parameters, m_translator, m_allocators, m_relative_level);
+                m_root, m_leafs_level, m_element, m_parameters, m_translator, m_allocators, m_relative_level, m_statistics);
 
             rtree::apply_visitor(lins_v, *m_root);                                                              // MAY THROW (V, E: alloc, copy, N: alloc)
 
@@ -507,7 +513,7 @@ public:
         else
         {
             visitors::insert<Element, Value, Options, Translator, Box, Allocators, insert_default_tag> ins_v(
-                m_root, m_leafs_level, m_element, m_parameters, m_translator, m_allocators, m_relative_level);
+                m_root, m_leafs_level, m_element, m_parameters, m_translator, m_allocators, m_relative_level, m_statistics);
 
             rtree::apply_visitor(ins_v, *m_root); 
         }
@@ -522,7 +528,7 @@ public:
         if ( m_parameters.get_reinserted_elements() > 0 )
         {
             rstar::level_insert<0, Element, Value, Options, Translator, Box, Allocators> lins_v(
-                m_root, m_leafs_level, m_element, m_parameters, m_translator, m_allocators, m_relative_level);
+                m_root, m_leafs_level, m_element, m_parameters, m_translator, m_allocators, m_relative_level, m_statistics);
 
             rtree::apply_visitor(lins_v, *m_root);                                                              // MAY THROW (V, E: alloc, copy, N: alloc)
 
@@ -532,7 +538,7 @@ public:
         else
         {
             visitors::insert<Element, Value, Options, Translator, Box, Allocators, insert_default_tag> ins_v(
-                m_root, m_leafs_level, m_element, m_parameters, m_translator, m_allocators, m_relative_level);
+                m_root, m_leafs_level, m_element, m_parameters, m_translator, m_allocators, m_relative_level, m_statistics);
 
             rtree::apply_visitor(ins_v, *m_root); 
         }
@@ -544,12 +550,15 @@ private:
     {
         typedef typename Elements::value_type element_type;
 
+        if ( m_statistics )
+            m_statistics->reinserts += elements.size();
+
         // reinsert children starting from the minimum distance
         typename Elements::reverse_iterator it = elements.rbegin();
         for ( ; it != elements.rend() ; ++it)
         {
             rstar::level_insert<1, element_type, Value, Options, Translator, Box, Allocators> lins_v(
-                m_root, m_leafs_level, *it, m_parameters, m_translator, m_allocators, relative_level);
+                m_root, m_leafs_level, *it, m_parameters, m_translator, m_allocators, relative_level, m_statistics);
 
             BOOST_TRY
             {
@@ -584,6 +593,8 @@ private:
     size_type m_relative_level;
 
     Allocators & m_allocators;
+
+    index::insert_statistics * m_statistics;
 };
 
 }}} // namespace detail::rtree::visitors
@@ -50,7 +50,7 @@ public:
             // for exception safety
             subtree_destroyer auto_result(result, m_allocators);
 
-            elements_dst.push_back( rtree::make_ptr_pair(it->first, result) );                          // MAY THROW, STRONG (E: alloc, copy)
+            elements_dst.push_back( rtree::make_ptr_pair<Box>(it->first, result) );                          // MAY THROW, STRONG (E: alloc, copy)
 
             auto_result.release();
         }
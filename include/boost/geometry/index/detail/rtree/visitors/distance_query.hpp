@@ -11,6 +11,8 @@
 #ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_DISTANCE_QUERY_HPP
 #define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_DISTANCE_QUERY_HPP
 
+#include <boost/geometry/index/detail/rtree/query_counters.hpp>
+
 namespace boost { namespace geometry { namespace index {
 
 namespace detail { namespace rtree { namespace visitors {
@@ -97,7 +99,8 @@ template <
     typename Allocators,
     typename Predicates,
     unsigned DistancePredicateIndex,
-    typename OutIter
+    typename OutIter,
+    typename Statistics = void
 >
 class distance_query
     : public rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, true>::type
@@ -120,10 +123,12 @@ public:
 
     static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
 
-    inline distance_query(parameters_type const& parameters, Translator const& translator, Predicates const& pred, OutIter out_it)
+    inline distance_query(parameters_type const& parameters, Translator const& translator, Predicates const& pred, OutIter out_it,
+                          Statistics * statistics = 0)
         : m_parameters(parameters), m_translator(translator)
         , m_pred(pred)
         , m_result(nearest_predicate_access::get(m_pred).count, out_it)
+        , m_counters(statistics)
     {}
 
     inline void operator()(internal_node const& n)
@@ -141,6 +146,8 @@ public:
         
         elements_type const& elements = rtree::elements(n);
 
+        m_counters.internal_node(elements.size());
+
         // fill array of nodes meeting predicates
         for (typename elements_type::const_iterator it = elements.begin();
             it != elements.end(); ++it)
@@ -220,7 +227,9 @@ public:
     {
         typedef typename rtree::elements_type<leaf>::type elements_type;
         elements_type const& elements = rtree::elements(n);
-        
+
+        m_counters.leaf(elements.size());
+
         // search leaf for closest value meeting predicates
         for (typename elements_type::const_iterator it = elements.begin();
             it != elements.end(); ++it)
@@ -276,6 +285,8 @@ private:
 
     Predicates m_pred;
     distance_query_result<Value, Translator, value_distance_type, OutIter> m_result;
+
+    rtree::query_counters<Statistics> m_counters;
 };
 
 template <
@@ -0,0 +1,303 @@
+// Boost.Geometry Index
+//
+// R-tree batched knn query visitor implementation
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_DISTANCE_QUERY_BATCH_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_DISTANCE_QUERY_BATCH_HPP
+
+#include <boost/geometry/index/detail/algorithms/hilbert_key.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree { namespace visitors {
+
+// Performs subsequent knn queries, the buffers are reused by all of them.
+// The queries are expected to be ordered so the subsequent ones are close
+// to each other. The neighbors found by the previous query are used to
+// calculate the initial bound of the distance of the current query so the
+// nodes further than this bound are pruned from the beginning.
+template <
+    typename Value,
+    typename Options,
+    typename Translator,
+    typename Box,
+    typename Allocators,
+    typename Predicates,
+    unsigned DistancePredicateIndex
+>
+class distance_query_batch
+    : public rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, true>::type
+{
+public:
+    typedef typename Options::parameters_type parameters_type;
+
+    typedef typename rtree::node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type node;
+    typedef typename rtree::internal_node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    typedef index::detail::predicates_element<DistancePredicateIndex, Predicates> nearest_predicate_access;
+    typedef typename nearest_predicate_access::type nearest_predicate_type;
+    typedef typename indexable_type<Translator>::type indexable_type;
+
+    typedef index::detail::calculate_distance<nearest_predicate_type, indexable_type, value_tag> calculate_value_distance;
+    typedef index::detail::calculate_distance<nearest_predicate_type, Box, bounds_tag> calculate_node_distance;
+    typedef typename calculate_value_distance::result_type value_distance_type;
+    typedef typename calculate_node_distance::result_type node_distance_type;
+
+    typedef typename Allocators::size_type size_type;
+
+    static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
+
+    inline distance_query_batch(parameters_type const& parameters, Translator const& translator)
+        : m_parameters(parameters), m_translator(translator)
+        , m_pred(0), m_count(0), m_bound(), m_has_bound(false)
+    {}
+
+    template <typename OutIter>
+    inline size_type apply(node const& root, Predicates const& pred, OutIter out_it)
+    {
+        m_pred = &pred;
+        m_count = nearest_predicate_access::get(pred).count;
+        m_neighbors.clear();
+        m_neighbors.reserve(m_count);
+
+        BOOST_GEOMETRY_INDEX_ASSERT(0 < m_count, "Number of neighbors should be greater than 0");
+
+        init_bound();
+
+        rtree::apply_visitor(*this, root);
+
+        // write the result and keep it for the next query
+        m_previous.clear();
+        typedef typename std::vector< std::pair<value_distance_type, Value> >::const_iterator neighbors_iterator;
+        for ( neighbors_iterator it = m_neighbors.begin() ; it != m_neighbors.end() ; ++it, ++out_it )
+        {
+            *out_it = it->second;
+            m_previous.push_back(it->second);
+        }
+
+        return m_neighbors.size();
+    }
+
+    inline void operator()(internal_node const& n)
+    {
+        typedef typename rtree::elements_type<internal_node>::type elements_type;
+
+        // array of active nodes
+        typedef typename index::detail::rtree::container_from_elements_type<
+            elements_type,
+            std::pair<node_distance_type, typename Allocators::node_pointer>
+        >::type active_branch_list_type;
+
+        active_branch_list_type active_branch_list;
+        active_branch_list.reserve(m_parameters.get_max_elements());
+
+        elements_type const& elements = rtree::elements(n);
+
+        // fill array of nodes meeting predicates
+        for (typename elements_type::const_iterator it = elements.begin();
+            it != elements.end(); ++it)
+        {
+            // 0 - dummy value
+            if ( index::detail::predicates_check<index::detail::bounds_tag, 0, predicates_len>(*m_pred, 0, it->first) )
+            {
+                node_distance_type node_distance;
+                if ( !calculate_node_distance::apply(predicate(), it->first, node_distance) )
+                    continue;
+
+                if ( is_node_prunable(node_distance) )
+                    continue;
+
+                active_branch_list.push_back( std::make_pair(node_distance, it->second) );
+            }
+        }
+
+        if ( active_branch_list.empty() )
+            return;
+
+        std::sort(active_branch_list.begin(), active_branch_list.end(), abl_less);
+
+        for ( typename active_branch_list_type::const_iterator it = active_branch_list.begin();
+              it != active_branch_list.end() ; ++it )
+        {
+            // if current node is further than furthest neighbor, the rest of nodes also will be further
+            if ( is_node_prunable(it->first) )
+                break;
+
+            rtree::apply_visitor(*this, *(it->second));
+        }
+    }
+
+    inline void operator()(leaf const& n)
+    {
+        typedef typename rtree::elements_type<leaf>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        for (typename elements_type::const_iterator it = elements.begin();
+            it != elements.end(); ++it)
+        {
+            if ( index::detail::predicates_check<index::detail::value_tag, 0, predicates_len>(*m_pred, *it, m_translator(*it)) )
+            {
+                value_distance_type value_distance;
+                if ( calculate_value_distance::apply(predicate(), m_translator(*it), value_distance) )
+                {
+                    store(*it, value_distance);
+                }
+            }
+        }
+    }
+
+private:
+    // The previous neighbors meeting the predicates are values stored in the tree.
+    // If there is enough of them none of the values further than the furthest one
+    // can be in the result.
+    inline void init_bound()
+    {
+        m_has_bound = false;
+
+        if ( m_previous.size() < m_count )
+            return;
+
+        m_bound_distances.clear();
+        typedef typename std::vector<Value>::const_iterator previous_iterator;
+        for ( previous_iterator it = m_previous.begin() ; it != m_previous.end() ; ++it )
+        {
+            if ( index::detail::predicates_check<index::detail::value_tag, 0, predicates_len>(*m_pred, *it, m_translator(*it)) )
+            {
+                value_distance_type value_distance;
+                if ( calculate_value_distance::apply(predicate(), m_translator(*it), value_distance) )
+                {
+                    m_bound_distances.push_back(value_distance);
+                }
+            }
+        }
+
+        if ( m_bound_distances.size() < m_count )
+            return;
+
+        std::nth_element(m_bound_distances.begin(),
+                         m_bound_distances.begin() + (m_count - 1),
+                         m_bound_distances.end());
+        m_bound = m_bound_distances[m_count - 1];
+        m_has_bound = true;
+    }
+
+    inline void store(Value const& val, value_distance_type const& curr_comp_dist)
+    {
+        if ( m_neighbors.size() < m_count )
+        {
+            m_neighbors.push_back(std::make_pair(curr_comp_dist, val));
+
+            if ( m_neighbors.size() == m_count )
+                std::make_heap(m_neighbors.begin(), m_neighbors.end(), neighbors_less);
+        }
+        else if ( curr_comp_dist < m_neighbors.front().first )
+        {
+            std::pop_heap(m_neighbors.begin(), m_neighbors.end(), neighbors_less);
+            m_neighbors.back().first = curr_comp_dist;
+            m_neighbors.back().second = val;
+            std::push_heap(m_neighbors.begin(), m_neighbors.end(), neighbors_less);
+        }
+    }
+
+    inline bool is_node_prunable(node_distance_type const& d) const
+    {
+        // the nodes exactly at the bound may contain the values found by the previous query
+        return ( m_count <= m_neighbors.size() && m_neighbors.front().first <= d )
+            || ( m_has_bound && m_bound < d );
+    }
+
+    static inline bool abl_less(
+        std::pair<node_distance_type, typename Allocators::node_pointer> const& p1,
+        std::pair<node_distance_type, typename Allocators::node_pointer> const& p2)
+    {
+        return p1.first < p2.first;
+    }
+
+    static inline bool neighbors_less(
+        std::pair<value_distance_type, Value> const& p1,
+        std::pair<value_distance_type, Value> const& p2)
+    {
+        return p1.first < p2.first;
+    }
+
+    nearest_predicate_type const& predicate() const
+    {
+        return nearest_predicate_access::get(*m_pred);
+    }
+
+    parameters_type const& m_parameters;
+    Translator const& m_translator;
+
+    Predicates const* m_pred;
+    std::size_t m_count;
+    std::vector< std::pair<value_distance_type, Value> > m_neighbors;
+
+    std::vector<Value> m_previous;
+    std::vector<value_distance_type> m_bound_distances;
+    value_distance_type m_bound;
+    bool m_has_bound;
+};
+
+// Returns the Hilbert key of the geometry passed into the nearest predicate
+template <typename PointOrRelation, typename Box>
+inline index::detail::hilbert_key_type
+distance_query_batch_key(index::detail::predicates::nearest<PointOrRelation> const& p, Box const& space)
+{
+    Box b;
+    index::detail::bounds(index::detail::relation<PointOrRelation>::value(p.point_or_relation), b);
+    return index::detail::hilbert_key(b, space);
+}
+
+// Performs the subsequent queries of a chunk, may be executed in a separate thread
+template <typename Visitor, typename Node, typename PredicatesIt, typename OutIterIt, typename Order>
+struct distance_query_batch_task
+{
+    typedef typename Visitor::parameters_type parameters_type;
+    typedef typename Visitor::size_type size_type;
+
+    template <typename Translator>
+    distance_query_batch_task(parameters_type const& parameters, Translator const& translator,
+                              Node const& root, PredicatesIt preds, OutIterIt out_its,
+                              Order const& order, std::size_t chunk_size,
+                              std::vector<size_type> & found)
+        : visitor(parameters, translator)
+        , root(root), preds(preds), out_its(out_its)
+        , order(order), chunk_size(chunk_size), found(found)
+    {}
+
+    void operator()(std::size_t chunk)
+    {
+        std::size_t const first = chunk * chunk_size;
+        std::size_t const last = (std::min)(first + chunk_size, order.size());
+
+        Visitor v(visitor);
+        size_type result = 0;
+
+        for ( std::size_t i = first ; i < last ; ++i )
+        {
+            std::size_t const q = order[i].second;
+            result += v.apply(root, *(preds + q), *(out_its + q));
+        }
+
+        found[chunk] = result;
+    }
+
+    Visitor const visitor; // an empty visitor copied for each chunk
+    Node const& root;
+    PredicatesIt preds;
+    OutIterIt out_its;
+    Order const& order;
+    std::size_t chunk_size;
+    std::vector<size_type> & found;
+};
+
+}}} // namespace detail::rtree::visitors
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_DISTANCE_QUERY_BATCH_HPP
@@ -0,0 +1,131 @@
+// Boost.Geometry Index
+//
+// R-tree visitor storing nodes in a contiguous, relocatable memory block
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_FLATTEN_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_FLATTEN_HPP
+
+#include <new>
+
+#include <boost/geometry/index/detail/rtree/node/flat.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree { namespace visitors {
+
+// Nodes are stored in depth-first order, starting at offset passed to the constructor.
+// If the data pointer is null only the offsets are calculated, in order to get the size
+// of the memory block. Offsets are aligned WRT the beginning of the block so it must
+// be aligned for all of the stored types.
+template <typename Value, typename Options, typename Box, typename Allocators, typename FlatAllocators>
+class flatten
+    : public rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, true>::type
+{
+    typedef typename Options::parameters_type parameters_type;
+
+    typedef typename rtree::internal_node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+public:
+    typedef typename rtree::node<Value, parameters_type, Box, FlatAllocators, node_flat_tag>::type flat_node;
+    typedef typename rtree::internal_node<Value, parameters_type, Box, FlatAllocators, node_flat_tag>::type flat_internal_node;
+    typedef typename rtree::leaf<Value, parameters_type, Box, FlatAllocators, node_flat_tag>::type flat_leaf;
+
+private:
+    typedef typename flat_internal_node::elements_type flat_internal_elements;
+    typedef typename flat_internal_elements::value_type flat_internal_element;
+    typedef typename flat_leaf::elements_type flat_leaf_elements;
+
+public:
+    inline flatten(char * data, std::size_t offset)
+        : m_data(data)
+        , m_offset(offset)
+        , m_node_offset(0)
+    {}
+
+    inline void operator()(internal_node const& n)
+    {
+        typedef typename rtree::elements_type<internal_node>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        std::size_t const node_offset = flat_align<flat_internal_node>(m_offset);
+        std::size_t const elements_offset = flat_internal_elements::elements_offset(
+            node_offset + members_offset<flat_internal_node>());
+        m_offset = elements_offset + elements.size() * sizeof(flat_internal_element);
+
+        if ( m_data )
+        {
+            new (m_data + node_offset) flat_internal_node(elements.size());
+        }
+
+        std::size_t i = 0;
+        for ( typename elements_type::const_iterator it = elements.begin() ;
+              it != elements.end() ; ++it, ++i )
+        {
+            rtree::apply_visitor(*this, *it->second);
+
+            if ( m_data )
+            {
+                flat_node const* child = reinterpret_cast<flat_node const*>(m_data + m_node_offset);
+                new (m_data + elements_offset + i * sizeof(flat_internal_element))
+                    flat_internal_element(it->first, flat_pointer<flat_node>(child));
+            }
+        }
+
+        m_node_offset = node_offset;
+    }
+
+    inline void operator()(leaf const& n)
+    {
+        typedef typename rtree::elements_type<leaf>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        std::size_t const node_offset = flat_align<flat_leaf>(m_offset);
+        std::size_t const elements_offset = flat_leaf_elements::elements_offset(
+            node_offset + members_offset<flat_leaf>());
+        m_offset = elements_offset + elements.size() * sizeof(Value);
+
+        if ( m_data )
+        {
+            new (m_data + node_offset) flat_leaf(elements.size());
+
+            std::size_t i = 0;
+            for ( typename elements_type::const_iterator it = elements.begin() ;
+                  it != elements.end() ; ++it, ++i )
+            {
+                new (m_data + elements_offset + i * sizeof(Value)) Value(*it);
+            }
+        }
+
+        m_node_offset = node_offset;
+    }
+
+    // The end of the last stored node
+    std::size_t end_offset() const { return m_offset; }
+
+    // The offset of the last visited node, after visiting the root it's the offset of the root
+    std::size_t node_offset() const { return m_node_offset; }
+
+private:
+    // The offset of elements container member in a node
+    template <typename FlatNode>
+    static inline std::size_t members_offset()
+    {
+        FlatNode const dummy(0);
+        return reinterpret_cast<char const*>(&dummy.elements) - reinterpret_cast<char const*>(&dummy);
+    }
+
+    char * m_data;
+    std::size_t m_offset;
+    std::size_t m_node_offset;
+};
+
+}}} // namespace detail::rtree::visitors
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_FLATTEN_HPP
@@ -18,6 +18,8 @@
 
 #include <boost/geometry/index/detail/algorithms/content.hpp>
 
+#include <boost/geometry/index/statistics.hpp>
+
 namespace boost { namespace geometry { namespace index {
 
 namespace detail { namespace rtree {
@@ -188,6 +190,7 @@ struct insert_traverse_data
 {
     typedef typename rtree::elements_type<InternalNode>::type elements_type;
     typedef typename elements_type::value_type element_type;
+    typedef typename elements_type::reference element_reference;
     typedef typename elements_type::size_type elements_size_type;
     typedef SizeType size_type;
 
@@ -214,7 +217,7 @@ struct insert_traverse_data
         return rtree::elements(*parent);
     }
 
-    element_type & current_element() const
+    element_reference current_element() const
     {
         BOOST_GEOMETRY_INDEX_ASSERT(parent, "null pointer");
         return rtree::elements(*parent)[current_child_index];
@@ -250,7 +253,8 @@ protected:
                   parameters_type const& parameters,
                   Translator const& translator,
                   Allocators & allocators,
-                  size_type relative_level = 0
+                  size_type relative_level = 0,
+                  index::insert_statistics * statistics = 0
     )
         : m_element(element)
         , m_parameters(parameters)
@@ -261,6 +265,7 @@ protected:
         , m_leafs_level(leafs_level)
         , m_traverse_data()
         , m_allocators(allocators)
+        , m_statistics(statistics)
     {
         BOOST_GEOMETRY_INDEX_ASSERT(m_relative_level <= leafs_level, "unexpected level value");
         BOOST_GEOMETRY_INDEX_ASSERT(m_level <= m_leafs_level, "unexpected level value");
@@ -300,8 +305,10 @@ protected:
             apply(n, rtree::element_indexable(m_element, m_translator), m_parameters, m_leafs_level - m_traverse_data.current_level);
 
         // expand the node to contain value
+        typename rtree::elements_type<internal_node>::type::reference
+            choosen_element = rtree::elements(n)[choosen_node_index];
         geometry::expand(
-            rtree::elements(n)[choosen_node_index].first,
+            choosen_element.first,
             m_element_bounds
             /*rtree::element_indexable(m_element, m_translator)*/);
 
@@ -356,6 +363,9 @@ protected:
 
         split_algo::apply(additional_nodes, n, n_box, m_parameters, m_translator, m_allocators);                // MAY THROW (V, E: alloc, copy, N:alloc)
 
+        if ( m_statistics )
+            ++m_statistics->splits;
+
         BOOST_GEOMETRY_INDEX_ASSERT(additional_nodes.size() == 1, "unexpected number of additional nodes");
 
         // TODO add all additional nodes
@@ -441,6 +451,8 @@ protected:
     insert_traverse_data<internal_node, internal_node_pointer, size_type> m_traverse_data;
 
     Allocators & m_allocators;
+
+    index::insert_statistics * m_statistics;
 };
 
 } // namespace detail
@@ -473,9 +485,10 @@ public:
                   parameters_type const& parameters,
                   Translator const& translator,
                   Allocators & allocators,
-                  size_type relative_level = 0
+                  size_type relative_level = 0,
+                  index::insert_statistics * statistics = 0
     )
-        : base(root, leafs_level, element, parameters, translator, allocators, relative_level)
+        : base(root, leafs_level, element, parameters, translator, allocators, relative_level, statistics)
     {}
 
     inline void operator()(internal_node & n)
@@ -538,9 +551,10 @@ public:
                   parameters_type const& parameters,
                   Translator const& translator,
                   Allocators & allocators,
-                  size_type relative_level = 0
+                  size_type relative_level = 0,
+                  index::insert_statistics * statistics = 0
     )
-        : base(root, leafs_level, value, parameters, translator, allocators, relative_level)
+        : base(root, leafs_level, value, parameters, translator, allocators, relative_level, statistics)
     {}
 
     inline void operator()(internal_node & n)
@@ -294,12 +294,15 @@ private:
         {
             for ( ; it != elements.end() ; ++it )
             {
+                // the element must outlive the visitor, the iterator may return a proxy
+                typename elements_type::value_type const& element = *it;
+
                 visitors::insert<
                     typename elements_type::value_type,
                     Value, Options, Translator, Box, Allocators,
                     typename Options::insert_tag
                 > insert_v(
-                    m_root_node, m_leafs_level, *it,
+                    m_root_node, m_leafs_level, element,
                     m_parameters, m_translator, m_allocators,
                     node_relative_level - 1);
 
@@ -0,0 +1,484 @@
+// Boost.Geometry Index
+//
+// R-tree spatial join implementation
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_JOIN_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_JOIN_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/geometry/index/detail/algorithms/bounds.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree { namespace visitors {
+
+// The relationship of the values of the joined trees. If the predicate is
+// prunable the values may be in relation only if their bounds intersect,
+// otherwise all of the pairs of nodes have to be traversed.
+template <typename Predicate>
+struct spatial_join_predicate_check
+{
+    BOOST_MPL_ASSERT_MSG(false, NOT_IMPLEMENTED_FOR_THIS_PREDICATE, (Predicate));
+};
+
+template <typename Tag>
+struct spatial_join_predicate_check<index::detail::predicates::spatial_join_predicate<Tag, false> >
+{
+    static const bool is_prunable = true;
+
+    template <typename Indexable1, typename Indexable2>
+    static inline bool apply(Indexable1 const& i1, Indexable2 const& i2)
+    {
+        return index::detail::spatial_predicate_call<Tag>::apply(i1, i2);
+    }
+};
+
+template <typename Tag>
+struct spatial_join_predicate_check<index::detail::predicates::spatial_join_predicate<Tag, true> >
+{
+    static const bool is_prunable = false;
+
+    template <typename Indexable1, typename Indexable2>
+    static inline bool apply(Indexable1 const& i1, Indexable2 const& i2)
+    {
+        return !index::detail::spatial_predicate_call<Tag>::apply(i1, i2);
+    }
+};
+
+template <>
+struct spatial_join_predicate_check<index::detail::predicates::spatial_join_predicate<index::detail::predicates::disjoint_tag, false> >
+{
+    static const bool is_prunable = false;
+
+    template <typename Indexable1, typename Indexable2>
+    static inline bool apply(Indexable1 const& i1, Indexable2 const& i2)
+    {
+        return geometry::disjoint(i1, i2);
+    }
+};
+
+template <>
+struct spatial_join_predicate_check<index::detail::predicates::spatial_join_predicate<index::detail::predicates::disjoint_tag, true> >
+{
+    static const bool is_prunable = true;
+
+    template <typename Indexable1, typename Indexable2>
+    static inline bool apply(Indexable1 const& i1, Indexable2 const& i2)
+    {
+        return !geometry::disjoint(i1, i2);
+    }
+};
+
+// The pair of subtrees of the joined trees, processed separately by the parallel join
+template <typename NodePointer1, typename Box1, typename NodePointer2, typename Box2>
+struct spatial_join_subtrees
+{
+    spatial_join_subtrees(NodePointer1 n1, Box1 const& b1, NodePointer2 n2, Box2 const& b2)
+        : node1(n1), box1(b1), node2(n2), box2(b2)
+    {}
+
+    NodePointer1 node1;
+    Box1 box1;
+    NodePointer2 node2;
+    Box2 box2;
+};
+
+struct spatial_join_entry_less
+{
+    template <typename Entry>
+    inline bool operator()(Entry const& e1, Entry const& e2) const
+    {
+        return geometry::get<min_corner, 0>(e1.first) < geometry::get<min_corner, 0>(e2.first);
+    }
+};
+
+template <typename Join, typename Node2> class spatial_join_visit_first;
+template <typename Join, typename Node1> class spatial_join_visit_second;
+template <typename Join> class spatial_join_visit_both;
+
+// Traverses both trees at the same time. The pairs of nodes are visited in
+// depth-first order. The children of both nodes are checked against the box
+// of the other node, then the pairs of children having intersecting boxes
+// are found with the plane-sweep along the first axis. The trees may have
+// different heights, in this case only the higher one is traversed after
+// reaching the level of leafs of the lower one.
+template
+<
+    typename Value1, typename Options1, typename Translator1, typename Box1, typename Allocators1,
+    typename Value2, typename Options2, typename Translator2, typename Box2, typename Allocators2,
+    typename Predicate, typename OutIter
+>
+class spatial_join
+{
+public:
+    typedef typename rtree::node<Value1, typename Options1::parameters_type, Box1, Allocators1, typename Options1::node_tag>::type node1;
+    typedef typename rtree::internal_node<Value1, typename Options1::parameters_type, Box1, Allocators1, typename Options1::node_tag>::type internal_node1;
+    typedef typename rtree::leaf<Value1, typename Options1::parameters_type, Box1, Allocators1, typename Options1::node_tag>::type leaf1;
+    typedef typename rtree::visitor<Value1, typename Options1::parameters_type, Box1, Allocators1, typename Options1::node_tag, true>::type visitor1;
+
+    typedef typename rtree::node<Value2, typename Options2::parameters_type, Box2, Allocators2, typename Options2::node_tag>::type node2;
+    typedef typename rtree::internal_node<Value2, typename Options2::parameters_type, Box2, Allocators2, typename Options2::node_tag>::type internal_node2;
+    typedef typename rtree::leaf<Value2, typename Options2::parameters_type, Box2, Allocators2, typename Options2::node_tag>::type leaf2;
+    typedef typename rtree::visitor<Value2, typename Options2::parameters_type, Box2, Allocators2, typename Options2::node_tag, true>::type visitor2;
+
+    typedef spatial_join_subtrees
+        <
+            typename Allocators1::node_pointer, Box1,
+            typename Allocators2::node_pointer, Box2
+        > subtrees_type;
+
+    typedef Box1 box1_type;
+    typedef Box2 box2_type;
+    typedef typename Allocators1::size_type size_type;
+
+    typedef spatial_join_predicate_check<Predicate> check;
+
+    inline spatial_join(Translator1 const& t1, Translator2 const& t2, OutIter out_it)
+        : m_tr1(t1), m_tr2(t2), m_out_iter(out_it), m_found_count(0)
+        , m_level(0), m_collect_level(0), m_collected(0)
+    {}
+
+    // Instead of traversing the pairs of children of the nodes at collect_level
+    // store them in the container.
+    inline void collect(size_type collect_level, std::vector<subtrees_type> & collected)
+    {
+        m_collect_level = collect_level;
+        m_collected = &collected;
+    }
+
+    // Joins the subtrees. The level is the level of the nodes counting from the root.
+    inline void apply(node1 const& n1, Box1 const& b1, node2 const& n2, Box2 const& b2, size_type level)
+    {
+        spatial_join_visit_both<spatial_join> v(*this, n1, b1, b2);
+        m_level = level;
+        rtree::apply_visitor(v, n2);
+    }
+
+    // Joins the trees, the root of the second tree is visited by the view
+    template <typename View2>
+    inline void apply(node1 const& root1, Box1 const& b1, View2 const& view2, Box2 const& b2)
+    {
+        spatial_join_visit_both<spatial_join> v(*this, root1, b1, b2);
+        m_level = 0;
+        view2.apply_visitor(v);
+    }
+
+    inline void join(internal_node1 const& n1, Box1 const& b1, internal_node2 const& n2, Box2 const& b2)
+    {
+        join_elements(n1, b1, n2, b2);
+    }
+
+    inline void join(leaf1 const& n1, Box1 const& b1, leaf2 const& n2, Box2 const& b2)
+    {
+        join_elements(n1, b1, n2, b2);
+    }
+
+    // the second tree is lower
+    inline void join(internal_node1 const& n1, Box1 const& , leaf2 const& n2, Box2 const& b2)
+    {
+        typedef typename rtree::elements_type<internal_node1>::type elements_type;
+        elements_type const& elements = rtree::elements(n1);
+
+        for ( typename elements_type::const_iterator it = elements.begin();
+              it != elements.end() ; ++it )
+        {
+            if ( !check::is_prunable || geometry::intersects(it->first, b2) )
+            {
+                spatial_join_visit_first<spatial_join, leaf2> v(*this, it->first, n2, b2);
+                rtree::apply_visitor(v, *it->second);
+            }
+        }
+    }
+
+    // the first tree is lower
+    inline void join(leaf1 const& n1, Box1 const& b1, internal_node2 const& n2, Box2 const& )
+    {
+        typedef typename rtree::elements_type<internal_node2>::type elements_type;
+        elements_type const& elements = rtree::elements(n2);
+
+        for ( typename elements_type::const_iterator it = elements.begin();
+              it != elements.end() ; ++it )
+        {
+            if ( !check::is_prunable || geometry::intersects(b1, it->first) )
+            {
+                spatial_join_visit_second<spatial_join, leaf1> v(*this, n1, b1, it->first);
+                rtree::apply_visitor(v, *it->second);
+            }
+        }
+    }
+
+    inline size_type found_count() const { return m_found_count; }
+    inline OutIter out_iter() const { return m_out_iter; }
+
+private:
+    template <typename Node1, typename Node2>
+    inline void join_elements(Node1 const& n1, Box1 const& b1, Node2 const& n2, Box2 const& b2)
+    {
+        typedef typename rtree::elements_type<Node1>::type elements1_type;
+        typedef typename rtree::elements_type<Node2>::type elements2_type;
+        typedef typename index::detail::rtree::container_from_elements_type<
+            elements1_type, std::pair<Box1, std::size_t>
+        >::type entries1_type;
+        typedef typename index::detail::rtree::container_from_elements_type<
+            elements2_type, std::pair<Box2, std::size_t>
+        >::type entries2_type;
+
+        elements1_type const& elements1 = rtree::elements(n1);
+        elements2_type const& elements2 = rtree::elements(n2);
+
+        if ( !check::is_prunable )
+        {
+            for ( std::size_t i = 0 ; i < elements1.size() ; ++i )
+                for ( std::size_t j = 0 ; j < elements2.size() ; ++j )
+                    join_pair(n1, i, n2, j);
+            return;
+        }
+
+        // the elements intersecting the other node
+        entries1_type entries1;
+        entries1.reserve(elements1.size());
+        for ( std::size_t i = 0 ; i < elements1.size() ; ++i )
+        {
+            std::pair<Box1, std::size_t> e;
+            element_box(elements1[i], e.first, m_tr1);
+            if ( geometry::intersects(e.first, b2) )
+            {
+                e.second = i;
+                entries1.push_back(e);
+            }
+        }
+
+        if ( entries1.empty() )
+            return;
+
+        entries2_type entries2;
+        entries2.reserve(elements2.size());
+        for ( std::size_t j = 0 ; j < elements2.size() ; ++j )
+        {
+            std::pair<Box2, std::size_t> e;
+            element_box(elements2[j], e.first, m_tr2);
+            if ( geometry::intersects(b1, e.first) )
+            {
+                e.second = j;
+                entries2.push_back(e);
+            }
+        }
+
+        if ( entries2.empty() )
+            return;
+
+        std::sort(entries1.begin(), entries1.end(), spatial_join_entry_less());
+        std::sort(entries2.begin(), entries2.end(), spatial_join_entry_less());
+
+        // plane-sweep
+        std::size_t i = 0, j = 0;
+        while ( i < entries1.size() && j < entries2.size() )
+        {
+            if ( geometry::get<min_corner, 0>(entries1[i].first) <= geometry::get<min_corner, 0>(entries2[j].first) )
+            {
+                for ( std::size_t k = j ; k < entries2.size()
+                        && geometry::get<min_corner, 0>(entries2[k].first) <= geometry::get<max_corner, 0>(entries1[i].first) ; ++k )
+                {
+                    if ( geometry::intersects(entries1[i].first, entries2[k].first) )
+                        join_pair(n1, entries1[i].second, n2, entries2[k].second);
+                }
+                ++i;
+            }
+            else
+            {
+                for ( std::size_t k = i ; k < entries1.size()
+                        && geometry::get<min_corner, 0>(entries1[k].first) <= geometry::get<max_corner, 0>(entries2[j].first) ; ++k )
+                {
+                    if ( geometry::intersects(entries1[k].first, entries2[j].first) )
+                        join_pair(n1, entries1[k].second, n2, entries2[j].second);
+                }
+                ++j;
+            }
+        }
+    }
+
+    template <typename Element, typename Box, typename Translator>
+    static inline void element_box(Element const& el, Box & b, Translator const& tr)
+    {
+        index::detail::bounds(element_indexable(el, tr), b);
+    }
+
+    inline void join_pair(internal_node1 const& n1, std::size_t i, internal_node2 const& n2, std::size_t j)
+    {
+        typename rtree::elements_type<internal_node1>::type::value_type const& el1 = rtree::elements(n1)[i];
+        typename rtree::elements_type<internal_node2>::type::value_type const& el2 = rtree::elements(n2)[j];
+
+        if ( m_collected && m_level == m_collect_level )
+        {
+            m_collected->push_back(subtrees_type(el1.second, el1.first, el2.second, el2.first));
+            return;
+        }
+
+        size_type const level_backup = m_level;
+        ++m_level;
+
+        spatial_join_visit_both<spatial_join> v(*this, *el1.second, el1.first, el2.first);
+        rtree::apply_visitor(v, *el2.second);
+
+        m_level = level_backup;
+    }
+
+    inline void join_pair(leaf1 const& n1, std::size_t i, leaf2 const& n2, std::size_t j)
+    {
+        Value1 const& v1 = rtree::elements(n1)[i];
+        Value2 const& v2 = rtree::elements(n2)[j];
+
+        if ( check::apply(m_tr1(v1), m_tr2(v2)) )
+        {
+            *m_out_iter = std::pair<Value1, Value2>(v1, v2);
+            ++m_out_iter;
+            ++m_found_count;
+        }
+    }
+
+    Translator1 const& m_tr1;
+    Translator2 const& m_tr2;
+    OutIter m_out_iter;
+    size_type m_found_count;
+
+    size_type m_level;
+    size_type m_collect_level;
+    std::vector<subtrees_type> * m_collected;
+};
+
+// Visits the node of the first tree, the node of the second tree is known
+template <typename Join, typename Node2>
+class spatial_join_visit_first
+    : public Join::visitor1
+{
+public:
+    inline spatial_join_visit_first(Join & join, typename Join::box1_type const& b1,
+                                    Node2 const& n2, typename Join::box2_type const& b2)
+        : m_join(join), m_box1(b1), m_node2(n2), m_box2(b2)
+    {}
+
+    inline void operator()(typename Join::internal_node1 const& n1)
+    {
+        m_join.join(n1, m_box1, m_node2, m_box2);
+    }
+
+    inline void operator()(typename Join::leaf1 const& n1)
+    {
+        m_join.join(n1, m_box1, m_node2, m_box2);
+    }
+
+private:
+    Join & m_join;
+    typename Join::box1_type const& m_box1;
+    Node2 const& m_node2;
+    typename Join::box2_type const& m_box2;
+};
+
+// Visits the node of the second tree, the node of the first tree is known
+template <typename Join, typename Node1>
+class spatial_join_visit_second
+    : public Join::visitor2
+{
+public:
+    inline spatial_join_visit_second(Join & join, Node1 const& n1,
+                                     typename Join::box1_type const& b1,
+                                     typename Join::box2_type const& b2)
+        : m_join(join), m_node1(n1), m_box1(b1), m_box2(b2)
+    {}
+
+    inline void operator()(typename Join::internal_node2 const& n2)
+    {
+        m_join.join(m_node1, m_box1, n2, m_box2);
+    }
+
+    inline void operator()(typename Join::leaf2 const& n2)
+    {
+        m_join.join(m_node1, m_box1, n2, m_box2);
+    }
+
+private:
+    Join & m_join;
+    Node1 const& m_node1;
+    typename Join::box1_type const& m_box1;
+    typename Join::box2_type const& m_box2;
+};
+
+// Visits the node of the second tree, then the node of the first tree
+template <typename Join>
+class spatial_join_visit_both
+    : public Join::visitor2
+{
+public:
+    inline spatial_join_visit_both(Join & join, typename Join::node1 const& n1,
+                                   typename Join::box1_type const& b1,
+                                   typename Join::box2_type const& b2)
+        : m_join(join), m_node1(n1), m_box1(b1), m_box2(b2)
+    {}
+
+    inline void operator()(typename Join::internal_node2 const& n2)
+    {
+        spatial_join_visit_first<Join, typename Join::internal_node2> v(m_join, m_box1, n2, m_box2);
+        rtree::apply_visitor(v, m_node1);
+    }
+
+    inline void operator()(typename Join::leaf2 const& n2)
+    {
+        spatial_join_visit_first<Join, typename Join::leaf2> v(m_join, m_box1, n2, m_box2);
+        rtree::apply_visitor(v, m_node1);
+    }
+
+private:
+    Join & m_join;
+    typename Join::node1 const& m_node1;
+    typename Join::box1_type const& m_box1;
+    typename Join::box2_type const& m_box2;
+};
+
+// Joins the chunk of subsequent pairs of subtrees, may be executed in a separate thread
+template <typename Join, typename Translator1, typename Translator2, typename Buffer>
+struct spatial_join_task
+{
+    typedef typename Join::subtrees_type subtrees_type;
+    typedef typename Join::size_type size_type;
+
+    spatial_join_task(Translator1 const& t1, Translator2 const& t2,
+                      std::vector<subtrees_type> const& subtrees, size_type level,
+                      std::size_t chunk_size, std::vector<Buffer> & buffers)
+        : tr1(t1), tr2(t2), subtrees(subtrees), level(level)
+        , chunk_size(chunk_size), buffers(buffers)
+    {}
+
+    void operator()(std::size_t chunk)
+    {
+        std::size_t const first = chunk * chunk_size;
+        std::size_t const last = (std::min)(first + chunk_size, subtrees.size());
+
+        Join join(tr1, tr2, std::back_inserter(buffers[chunk]));
+        for ( std::size_t i = first ; i < last ; ++i )
+        {
+            subtrees_type const& s = subtrees[i];
+            join.apply(*s.node1, s.box1, *s.node2, s.box2, level);
+        }
+    }
+
+    Translator1 const& tr1;
+    Translator2 const& tr2;
+    std::vector<subtrees_type> const& subtrees;
+    size_type level;
+    std::size_t chunk_size;
+    std::vector<Buffer> & buffers;
+};
+
+}}} // namespace detail::rtree::visitors
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_JOIN_HPP
@@ -11,49 +11,236 @@
 #ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_QUERY_HPP
 #define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_QUERY_HPP
 
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/index/detail/algorithms/predicates_mask.hpp>
+#include <boost/geometry/index/detail/rtree/query_counters.hpp>
+
 namespace boost { namespace geometry { namespace index {
 
 namespace detail { namespace rtree { namespace visitors {
 
-template <typename Value, typename Options, typename Translator, typename Box, typename Allocators, typename Predicates, typename OutIter>
-struct spatial_query
-    : public rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, true>::type
+// Spatial predicates checked for the bounds with intersects(), see predicates.hpp
+
+template <typename Tag>
+struct is_intersects_for_bounds
 {
-    typedef typename rtree::node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type node;
-    typedef typename rtree::internal_node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
-    typedef typename rtree::leaf<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+    static const bool value = ! boost::is_same<Tag, predicates::contains_tag>::value
+                           && ! boost::is_same<Tag, predicates::covers_tag>::value
+                           && ! boost::is_same<Tag, predicates::disjoint_tag>::value;
+};
 
-    typedef typename Allocators::size_type size_type;
+template <typename Predicates, typename Elements>
+struct is_soa_intersects_query
+{
+    static const bool value = false;
+};
 
-    static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
+template <typename Geometry, typename Tag, typename Box, typename Pointer, std::size_t Capacity>
+struct is_soa_intersects_query
+    <
+        predicates::spatial_predicate<Geometry, Tag, false>,
+        rtree::soa_elements<Box, Pointer, Capacity>
+    >
+{
+    static const bool value = is_intersects_for_bounds<Tag>::value
+                           && rtree::soa_intersects_enabled<rtree::soa_elements<Box, Pointer, Capacity>, Geometry>::value;
+};
 
-    inline spatial_query(Translator const& t, Predicates const& p, OutIter out_it)
-        : tr(t), pred(p), out_iter(out_it), found_count(0)
-    {}
+// Traverses the children of an internal node meeting predicates
 
-    inline void operator()(internal_node const& n)
-    {
-        typedef typename rtree::elements_type<internal_node>::type elements_type;
-        elements_type const& elements = rtree::elements(n);
+template
+<
+    typename Predicates,
+    typename Elements,
+    bool IsSoaIntersects = is_soa_intersects_query<Predicates, Elements>::value
+>
+struct spatial_query_children
+{
+    static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
 
-        // traverse nodes meeting predicates
-        for (typename elements_type::const_iterator it = elements.begin();
+    template <typename Visitor>
+    static inline void apply(Visitor & visitor, Predicates const& pred, Elements const& elements)
+    {
+        for (typename Elements::const_iterator it = elements.begin();
             it != elements.end(); ++it)
         {
             // if node meets predicates
             // 0 - dummy value
             if ( index::detail::predicates_check<index::detail::bounds_tag, 0, predicates_len>(pred, 0, it->first) )
-                rtree::apply_visitor(*this, *it->second);
+                rtree::apply_visitor(visitor, *it->second);
         }
     }
+};
 
-    inline void operator()(leaf const& n)
+// The children stored in structure-of-arrays layout are tested all at once
+
+template <typename Predicates, typename Elements>
+struct spatial_query_children<Predicates, Elements, true>
+{
+    template <typename Visitor>
+    static inline void apply(Visitor & visitor, Predicates const& pred, Elements const& elements)
     {
-        typedef typename rtree::elements_type<leaf>::type elements_type;
-        elements_type const& elements = rtree::elements(n);
+        unsigned char flags[Elements::static_capacity];
+        rtree::soa_intersects(elements, pred.geometry, flags);
 
-        // get all values meeting predicates
-        for (typename elements_type::const_iterator it = elements.begin();
+        for ( std::size_t i = 0 ; i < elements.size() ; ++i )
+        {
+            if ( flags[i] )
+                rtree::apply_visitor(visitor, *elements.child(i));
+        }
+    }
+};
+
+// Spatial predicates of the values computed for cartesian points and boxes at once
+
+template <typename Tag, typename IndexableTag>
+struct values_mask_predicate
+{
+    typedef void type;
+};
+
+template <>
+struct values_mask_predicate<predicates::intersects_tag, point_tag>
+{
+    typedef index::detail::predicates_mask::point_covered_by type;
+};
+
+template <>
+struct values_mask_predicate<predicates::covered_by_tag, point_tag>
+{
+    typedef index::detail::predicates_mask::point_covered_by type;
+};
+
+template <>
+struct values_mask_predicate<predicates::within_tag, point_tag>
+{
+    typedef index::detail::predicates_mask::point_within type;
+};
+
+template <>
+struct values_mask_predicate<predicates::intersects_tag, box_tag>
+{
+    typedef index::detail::predicates_mask::box_intersects type;
+};
+
+template <>
+struct values_mask_predicate<predicates::covered_by_tag, box_tag>
+{
+    typedef index::detail::predicates_mask::box_covered_by type;
+};
+
+template <>
+struct values_mask_predicate<predicates::within_tag, box_tag>
+{
+    typedef index::detail::predicates_mask::box_within type;
+};
+
+template <typename Predicates, typename Indexable>
+struct is_values_mask_query
+{
+    static const bool value = false;
+};
+
+template <typename Geometry, typename Tag, typename Indexable>
+struct is_values_mask_query<predicates::spatial_predicate<Geometry, Tag, false>, Indexable>
+{
+    static const bool value =
+        ! boost::is_same<typename values_mask_predicate<Tag, typename geometry::tag<Indexable>::type>::type, void>::value
+        && boost::is_same<typename geometry::tag<Geometry>::type, box_tag>::value
+        && boost::is_same<typename geometry::cs_tag<Geometry>::type, cartesian_tag>::value
+        && boost::is_same<typename geometry::cs_tag<Indexable>::type, cartesian_tag>::value
+        && geometry::dimension<Geometry>::value == geometry::dimension<Indexable>::value
+        && boost::is_arithmetic<typename geometry::coordinate_type<Geometry>::type>::value
+        && boost::is_arithmetic<typename geometry::coordinate_type<Indexable>::type>::value;
+};
+
+// Copies the coordinates of the indexables to the arrays of coordinates, for
+// points only the min coordinates are stored
+template <typename Indexable, std::size_t Dimension, std::size_t DimensionCount,
+          typename Tag = typename geometry::tag<Indexable>::type>
+struct values_mask_coords
+{
+    template <typename T, std::size_t Size, std::size_t MaxSize>
+    static inline void apply(Indexable const& i, std::size_t index, T (&mins)[DimensionCount][Size], T (&maxs)[DimensionCount][MaxSize])
+    {
+        mins[Dimension][index] = geometry::get<min_corner, Dimension>(i);
+        maxs[Dimension][index] = geometry::get<max_corner, Dimension>(i);
+        values_mask_coords<Indexable, Dimension + 1, DimensionCount>::apply(i, index, mins, maxs);
+    }
+};
+
+template <typename Indexable, std::size_t Dimension, std::size_t DimensionCount>
+struct values_mask_coords<Indexable, Dimension, DimensionCount, point_tag>
+{
+    template <typename T, std::size_t Size, std::size_t MaxSize>
+    static inline void apply(Indexable const& i, std::size_t index, T (&mins)[DimensionCount][Size], T (&maxs)[DimensionCount][MaxSize])
+    {
+        mins[Dimension][index] = geometry::get<Dimension>(i);
+        values_mask_coords<Indexable, Dimension + 1, DimensionCount>::apply(i, index, mins, maxs);
+    }
+};
+
+template <typename Indexable, std::size_t DimensionCount>
+struct values_mask_coords<Indexable, DimensionCount, DimensionCount, box_tag>
+{
+    template <typename T, std::size_t Size, std::size_t MaxSize>
+    static inline void apply(Indexable const& , std::size_t , T (&)[DimensionCount][Size], T (&)[DimensionCount][MaxSize])
+    {}
+};
+
+template <typename Indexable, std::size_t DimensionCount>
+struct values_mask_coords<Indexable, DimensionCount, DimensionCount, point_tag>
+{
+    template <typename T, std::size_t Size, std::size_t MaxSize>
+    static inline void apply(Indexable const& , std::size_t , T (&)[DimensionCount][Size], T (&)[DimensionCount][MaxSize])
+    {}
+};
+
+template <typename Predicate, typename Box, std::size_t Dimension, std::size_t DimensionCount, bool IsPoint>
+struct values_mask_dimensions
+{
+    template <typename T, std::size_t Size, std::size_t MaxSize>
+    static inline void apply(T (&mins)[DimensionCount][Size], T (&maxs)[DimensionCount][MaxSize],
+                             Box const& b, std::size_t count, unsigned char * flags)
+    {
+        index::detail::predicate_dimension_mask<Predicate>(
+            mins[Dimension], IsPoint ? mins[Dimension] : maxs[Dimension],
+            geometry::get<min_corner, Dimension>(b), geometry::get<max_corner, Dimension>(b),
+            count, flags);
+
+        values_mask_dimensions<Predicate, Box, Dimension + 1, DimensionCount, IsPoint>::apply(mins, maxs, b, count, flags);
+    }
+};
+
+template <typename Predicate, typename Box, std::size_t DimensionCount, bool IsPoint>
+struct values_mask_dimensions<Predicate, Box, DimensionCount, DimensionCount, IsPoint>
+{
+    template <typename T, std::size_t Size, std::size_t MaxSize>
+    static inline void apply(T (&)[DimensionCount][Size], T (&)[DimensionCount][MaxSize],
+                             Box const& , std::size_t , unsigned char * )
+    {}
+};
+
+// Stores the values of a leaf meeting predicates
+
+template
+<
+    typename Predicates,
+    typename Translator,
+    typename Elements,
+    bool IsValuesMask = is_values_mask_query<Predicates, typename indexable_type<Translator>::type>::value
+>
+struct spatial_query_values
+{
+    static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
+
+    template <typename OutIter, typename SizeType>
+    static inline void apply(Predicates const& pred, Translator const& tr, Elements const& elements,
+                             OutIter & out_iter, SizeType & found_count)
+    {
+        for (typename Elements::const_iterator it = elements.begin();
             it != elements.end(); ++it)
         {
             // if value meets predicates
@@ -66,6 +253,97 @@ struct spatial_query
             }
         }
     }
+};
+
+// The coordinates of the values are copied to arrays in chunks and the
+// predicate is computed for the whole chunk, see predicates_mask.hpp
+
+template <typename Geometry, typename Tag, typename Translator, typename Elements>
+struct spatial_query_values<predicates::spatial_predicate<Geometry, Tag, false>, Translator, Elements, true>
+{
+    typedef predicates::spatial_predicate<Geometry, Tag, false> predicates_type;
+    typedef typename indexable_type<Translator>::type indexable_type;
+    typedef typename geometry::coordinate_type<indexable_type>::type coordinate_type;
+    typedef typename geometry::tag<indexable_type>::type indexable_tag;
+    typedef typename values_mask_predicate<Tag, indexable_tag>::type predicate_type;
+
+    static const std::size_t dimension = geometry::dimension<indexable_type>::value;
+    static const bool is_point = boost::is_same<indexable_tag, point_tag>::value;
+    static const std::size_t chunk_size = 64;
+
+    template <typename OutIter, typename SizeType>
+    static inline void apply(predicates_type const& pred, Translator const& tr, Elements const& elements,
+                             OutIter & out_iter, SizeType & found_count)
+    {
+        coordinate_type mins[dimension][chunk_size];
+        coordinate_type maxs[dimension][is_point ? 1 : chunk_size];
+        unsigned char flags[chunk_size];
+
+        typename Elements::const_iterator it = elements.begin();
+        while ( it != elements.end() )
+        {
+            typename Elements::const_iterator const first = it;
+
+            std::size_t count = 0;
+            for ( ; it != elements.end() && count < chunk_size ; ++it, ++count )
+            {
+                values_mask_coords<indexable_type, 0, dimension>::apply(tr(*it), count, mins, maxs);
+                flags[count] = 1;
+            }
+
+            values_mask_dimensions<predicate_type, Geometry, 0, dimension, is_point>
+                ::apply(mins, maxs, pred.geometry, count, flags);
+
+            std::size_t i = 0;
+            for ( it = first ; i < count ; ++it, ++i )
+            {
+                if ( flags[i] )
+                {
+                    *out_iter = *it;
+                    ++out_iter;
+
+                    ++found_count;
+                }
+            }
+        }
+    }
+};
+
+template <typename Value, typename Options, typename Translator, typename Box, typename Allocators, typename Predicates, typename OutIter, typename Statistics = void>
+struct spatial_query
+    : public rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, true>::type
+{
+    typedef typename rtree::node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type node;
+    typedef typename rtree::internal_node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    typedef typename Allocators::size_type size_type;
+
+    static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
+
+    inline spatial_query(Translator const& t, Predicates const& p, OutIter out_it, Statistics * statistics = 0)
+        : tr(t), pred(p), out_iter(out_it), found_count(0), counters(statistics)
+    {}
+
+    inline void operator()(internal_node const& n)
+    {
+        typedef typename rtree::elements_type<internal_node>::type elements_type;
+
+        counters.internal_node(rtree::elements(n).size());
+
+        // traverse nodes meeting predicates
+        spatial_query_children<Predicates, elements_type>::apply(*this, pred, rtree::elements(n));
+    }
+
+    inline void operator()(leaf const& n)
+    {
+        typedef typename rtree::elements_type<leaf>::type elements_type;
+
+        counters.leaf(rtree::elements(n).size());
+
+        // get all values meeting predicates
+        spatial_query_values<Predicates, Translator, elements_type>::apply(pred, tr, rtree::elements(n), out_iter, found_count);
+    }
 
     Translator const& tr;
 
@@ -73,6 +351,8 @@ struct spatial_query
 
     OutIter out_iter;
     size_type found_count;
+
+    rtree::query_counters<Statistics> counters;
 };
 
 template <typename Value, typename Options, typename Translator, typename Box, typename Allocators, typename Predicates>
@@ -0,0 +1,533 @@
+// Boost.Geometry Index
+//
+// Read-only R-tree stored in a contiguous, relocatable memory block
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_FLAT_RTREE_HPP
+#define BOOST_GEOMETRY_INDEX_FLAT_RTREE_HPP
+
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+#include <boost/core/ignore_unused.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/geometry/index/detail/rtree/node/flat.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/flatten.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+struct flat_header
+{
+    char magic[8];
+    boost::uint64_t version;
+    boost::uint64_t value_size;
+    boost::uint64_t box_size;
+    boost::uint64_t alignment;
+    boost::uint64_t max_elements;
+    boost::uint64_t min_elements;
+    boost::uint64_t values_count;
+    boost::uint64_t leafs_level;
+    boost::uint64_t root_offset; // 0 if the tree is empty
+    boost::uint64_t size;
+};
+
+inline char const* flat_magic()
+{
+    return "BGIFLAT";
+}
+
+static const boost::uint64_t flat_version = 1;
+
+template <typename Value, typename Parameters, typename Box>
+struct flat_traits
+{
+    typedef flat_allocators<Value, Parameters, Box> allocators_type;
+    typedef typename rtree::internal_node<Value, Parameters, Box, allocators_type, node_flat_tag>::type internal_node;
+    typedef typename rtree::elements_type<internal_node>::type::value_type internal_element;
+
+    static const std::size_t alignment_1 = boost::alignment_of<flat_header>::value;
+    static const std::size_t alignment_2 = boost::alignment_of<internal_element>::value;
+    static const std::size_t alignment_3 = boost::alignment_of<Value>::value;
+    static const std::size_t alignment_12 = alignment_1 < alignment_2 ? alignment_2 : alignment_1;
+
+    // The alignment required for the beginning of the memory block
+    static const std::size_t alignment = alignment_12 < alignment_3 ? alignment_3 : alignment_12;
+};
+
+template <typename Options, typename NodeTag>
+struct options_with_node_tag
+{
+    typedef options
+        <
+            typename Options::parameters_type,
+            typename Options::insert_tag,
+            typename Options::choose_next_node_tag,
+            typename Options::split_tag,
+            typename Options::redistribute_tag,
+            NodeTag
+        > type;
+};
+
+template <typename Rtree>
+inline std::size_t flatten(Rtree const& tree, char * data)
+{
+    typedef utilities::view<Rtree> RTV;
+    typedef typename RTV::value_type value_type;
+    typedef typename RTV::options_type options_type;
+    typedef typename RTV::box_type box_type;
+    typedef typename options_type::parameters_type parameters_type;
+    typedef flat_traits<value_type, parameters_type, box_type> traits;
+
+    BOOST_GEOMETRY_INDEX_ASSERT(reinterpret_cast<std::size_t>(data) % traits::alignment == 0,
+                                "the memory block is not aligned");
+
+    RTV rtv(tree);
+
+    visitors::flatten
+        <
+            value_type, options_type, box_type,
+            typename RTV::allocators_type, typename traits::allocators_type
+        > flatten_v(data, sizeof(flat_header));
+    rtv.apply_visitor(flatten_v);
+
+    std::size_t const root_offset = tree.empty() ? 0 : flatten_v.node_offset();
+    std::size_t const size = flatten_v.end_offset();
+
+    if ( data )
+    {
+        flat_header header;
+        std::memset(&header, 0, sizeof(flat_header));
+        std::strcpy(header.magic, flat_magic());
+        header.version = flat_version;
+        header.value_size = sizeof(value_type);
+        header.box_size = sizeof(box_type);
+        header.alignment = traits::alignment;
+        header.max_elements = tree.parameters().get_max_elements();
+        header.min_elements = tree.parameters().get_min_elements();
+        header.values_count = tree.size();
+        header.leafs_level = rtv.depth();
+        header.root_offset = root_offset;
+        header.size = size;
+        std::memcpy(data, &header, sizeof(flat_header));
+    }
+
+    return size;
+}
+
+}} // namespace detail::rtree
+
+/*!
+\brief The read-only R-tree stored in a contiguous memory block.
+
+The memory block is created from an rtree by write_flat(). It doesn't contain
+pointers so it may be stored in a file and then mapped into memory at any
+address, e.g. with Boost.Interprocess \c file_mapping and \c mapped_region.
+The queries are performed directly on the memory block without any
+deserialization. The object doesn't own the memory block, it must outlive it.
+
+\par
+Values are copied bitwise into the memory block so Value must be trivially copyable
+and can't contain pointers. The memory block may be used only by the program
+using the same Value, Parameters and data model.
+
+\tparam Value           The type of objects stored in the container.
+\tparam Parameters      Parameters of the rtree from which the memory block was created.
+\tparam IndexableGetter The function object extracting Indexable from Value.
+\tparam EqualTo         The function object comparing objects of type Value.
+*/
+template
+<
+    typename Value,
+    typename Parameters,
+    typename IndexableGetter = index::indexable<Value>,
+    typename EqualTo = index::equal_to<Value>
+>
+class flat_rtree
+{
+public:
+    /*! \brief The type of Value stored in the container. */
+    typedef Value value_type;
+    /*! \brief R-tree parameters type. */
+    typedef Parameters parameters_type;
+    /*! \brief The function object extracting Indexable from Value. */
+    typedef IndexableGetter indexable_getter;
+    /*! \brief The function object comparing objects of type Value. */
+    typedef EqualTo value_equal;
+
+    /*! \brief The Indexable type to which Value is translated. */
+    typedef typename rtree<Value, Parameters, IndexableGetter, EqualTo>::indexable_type indexable_type;
+    /*! \brief The Box type used by the R-tree. */
+    typedef typename rtree<Value, Parameters, IndexableGetter, EqualTo>::bounds_type bounds_type;
+
+private:
+    typedef detail::translator<IndexableGetter, EqualTo> translator_type;
+
+    typedef bounds_type box_type;
+    typedef typename detail::rtree::options_with_node_tag
+        <
+            typename detail::rtree::options_type<Parameters>::type,
+            detail::rtree::node_flat_tag
+        >::type options_type;
+    typedef detail::rtree::flat_traits<value_type, Parameters, box_type> traits;
+    typedef typename traits::allocators_type allocators_type;
+
+    typedef typename detail::rtree::node<value_type, Parameters, box_type, allocators_type, detail::rtree::node_flat_tag>::type node;
+    typedef typename allocators_type::node_pointer node_pointer;
+
+public:
+    /*! \brief Type of reference to const Value. */
+    typedef typename allocators_type::const_reference const_reference;
+    /*! \brief Unsigned integral type used by the container. */
+    typedef typename allocators_type::size_type size_type;
+
+    /*! \brief Type of const query iterator, category ForwardIterator. */
+    typedef index::detail::rtree::iterators::query_iterator
+        <
+            value_type, allocators_type
+        > const_query_iterator;
+
+    /*!
+    \brief The constructor.
+
+    \param data         The memory block created by write_flat(), aligned as returned by flat_alignment().
+    \param size         The size of the memory block.
+    \param parameters   The parameters object equal to the one of the rtree passed to write_flat().
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+
+    \par Throws
+    std::invalid_argument if the memory block is not valid or was created for different types.
+    */
+    inline flat_rtree(void const* data, std::size_t size,
+                      parameters_type const& parameters = parameters_type(),
+                      indexable_getter const& getter = indexable_getter(),
+                      value_equal const& equal = value_equal())
+        : m_translator(getter, equal)
+        , m_parameters(parameters)
+        , m_root(0)
+        , m_values_count(0)
+        , m_leafs_level(0)
+    {
+        char const* const bytes = static_cast<char const*>(data);
+
+        if ( bytes == 0 || size < sizeof(detail::rtree::flat_header) )
+            detail::throw_invalid_argument("flat rtree: memory block too small");
+        if ( reinterpret_cast<std::size_t>(bytes) % traits::alignment != 0 )
+            detail::throw_invalid_argument("flat rtree: memory block not aligned");
+
+        detail::rtree::flat_header header;
+        std::memcpy(&header, bytes, sizeof(detail::rtree::flat_header));
+
+        if ( std::strncmp(header.magic, detail::rtree::flat_magic(), sizeof(header.magic)) != 0
+          || header.version != detail::rtree::flat_version )
+            detail::throw_invalid_argument("flat rtree: invalid memory block");
+        if ( header.size > size || header.root_offset >= header.size )
+            detail::throw_invalid_argument("flat rtree: memory block truncated");
+        if ( header.value_size != sizeof(value_type)
+          || header.box_size != sizeof(box_type)
+          || header.alignment != traits::alignment )
+            detail::throw_invalid_argument("flat rtree: incompatible Value type");
+        if ( header.max_elements != m_parameters.get_max_elements()
+          || header.min_elements != m_parameters.get_min_elements() )
+            detail::throw_invalid_argument("flat rtree: incompatible parameters");
+
+        m_root = header.root_offset == 0 ? 0
+               : reinterpret_cast<node_pointer>(bytes + header.root_offset);
+        m_values_count = static_cast<size_type>(header.values_count);
+        m_leafs_level = static_cast<size_type>(header.leafs_level);
+    }
+
+    /*!
+    \brief Finds values meeting passed predicates e.g. nearest to some Point and/or intersecting some Box.
+
+    The same predicates as in the case of rtree::query() may be passed.
+
+    \param predicates   Predicates.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of values found.
+    */
+    template <typename Predicates, typename OutIter>
+    size_type query(Predicates const& predicates, OutIter out_it) const
+    {
+        if ( !m_root )
+            return 0;
+
+        static const unsigned distance_predicates_count = detail::predicates_count_distance<Predicates>::value;
+        static const bool is_distance_predicate = 0 < distance_predicates_count;
+        BOOST_MPL_ASSERT_MSG((distance_predicates_count <= 1), PASS_ONLY_ONE_DISTANCE_PREDICATE, (Predicates));
+
+        return query_dispatch(predicates, out_it, boost::mpl::bool_<is_distance_predicate>());
+    }
+
+    /*!
+    \brief Returns a query iterator pointing at the begin of the query range.
+
+    The same predicates as in the case of rtree::qbegin() may be passed.
+
+    \param predicates   Predicates.
+
+    \return             The iterator pointing at the begin of the query range.
+    */
+    template <typename Predicates>
+    const_query_iterator qbegin(Predicates const& predicates) const
+    {
+        return const_query_iterator(qbegin_(predicates));
+    }
+
+    /*!
+    \brief Returns a query iterator pointing at the end of the query range.
+
+    \return             The iterator pointing at the end of the query range.
+    */
+    const_query_iterator qend() const
+    {
+        return const_query_iterator();
+    }
+
+    /*!
+    \brief Returns the query iterator pointing at the begin of the query range.
+
+    The same as rtree::qbegin_().
+
+    \param predicates   Predicates.
+
+    \return             The iterator pointing at the begin of the query range.
+    */
+    template <typename Predicates>
+    typename boost::mpl::if_c<
+        detail::predicates_count_distance<Predicates>::value == 0,
+        detail::rtree::iterators::spatial_query_iterator<value_type, options_type, translator_type, box_type, allocators_type, Predicates>,
+        detail::rtree::iterators::distance_query_iterator<
+            value_type, options_type, translator_type, box_type, allocators_type, Predicates,
+            detail::predicates_find_distance<Predicates>::value
+        >
+    >::type
+    qbegin_(Predicates const& predicates) const
+    {
+        static const unsigned distance_predicates_count = detail::predicates_count_distance<Predicates>::value;
+        BOOST_MPL_ASSERT_MSG((distance_predicates_count <= 1), PASS_ONLY_ONE_DISTANCE_PREDICATE, (Predicates));
+
+        typedef typename boost::mpl::if_c<
+            detail::predicates_count_distance<Predicates>::value == 0,
+            detail::rtree::iterators::spatial_query_iterator<value_type, options_type, translator_type, box_type, allocators_type, Predicates>,
+            detail::rtree::iterators::distance_query_iterator<
+                value_type, options_type, translator_type, box_type, allocators_type, Predicates,
+                detail::predicates_find_distance<Predicates>::value
+            >
+        >::type iterator_type;
+
+        if ( !m_root )
+            return iterator_type(m_translator, predicates);
+
+        return iterator_type(m_root, m_translator, predicates);
+    }
+
+    /*!
+    \brief Returns the query iterator pointing at the end of the query range.
+
+    The same as rtree::qend_().
+
+    \return             The iterator pointing at the end of the query range.
+    */
+    detail::rtree::iterators::end_query_iterator<value_type, allocators_type>
+    qend_() const
+    {
+        return detail::rtree::iterators::end_query_iterator<value_type, allocators_type>();
+    }
+
+    /*!
+    \brief Returns the number of stored values.
+
+    \return         The number of stored values.
+    */
+    inline size_type size() const
+    {
+        return m_values_count;
+    }
+
+    /*!
+    \brief Query if the container is empty.
+
+    \return         true if the container is empty.
+    */
+    inline bool empty() const
+    {
+        return 0 == m_values_count;
+    }
+
+    /*!
+    \brief Returns the box able to contain all values stored in the container.
+
+    \return     The box able to contain all values stored in the container or an invalid box if
+                there are no values in the container.
+    */
+    inline bounds_type bounds() const
+    {
+        bounds_type result;
+        // in order to suppress the uninitialized variable warnings
+        geometry::assign_inverse(result);
+
+        if ( m_root )
+        {
+            detail::rtree::visitors::children_box<value_type, options_type, translator_type, box_type, allocators_type>
+                box_v(result, m_translator);
+            detail::rtree::apply_visitor(box_v, *m_root);
+        }
+
+        return result;
+    }
+
+    /*!
+    \brief Returns parameters.
+
+    \return     The parameters object.
+    */
+    inline parameters_type parameters() const
+    {
+        return m_parameters;
+    }
+
+    /*!
+    \brief Returns the depth of the R-tree.
+
+    \return     The depth of the R-tree.
+    */
+    inline size_type depth() const
+    {
+        return m_leafs_level;
+    }
+
+private:
+    template <typename Predicates, typename OutIter>
+    size_type query_dispatch(Predicates const& predicates, OutIter out_it, boost::mpl::bool_<false> const& /*is_distance_predicate*/) const
+    {
+        detail::rtree::visitors::spatial_query<value_type, options_type, translator_type, box_type, allocators_type, Predicates, OutIter>
+            find_v(m_translator, predicates, out_it);
+
+        detail::rtree::apply_visitor(find_v, *m_root);
+
+        return find_v.found_count;
+    }
+
+    template <typename Predicates, typename OutIter>
+    size_type query_dispatch(Predicates const& predicates, OutIter out_it, boost::mpl::bool_<true> const& /*is_distance_predicate*/) const
+    {
+        static const unsigned distance_predicate_index = detail::predicates_find_distance<Predicates>::value;
+        detail::rtree::visitors::distance_query<
+            value_type,
+            options_type,
+            translator_type,
+            box_type,
+            allocators_type,
+            Predicates,
+            distance_predicate_index,
+            OutIter
+        > distance_v(m_parameters, m_translator, predicates, out_it);
+
+        detail::rtree::apply_visitor(distance_v, *m_root);
+
+        return distance_v.finish();
+    }
+
+    translator_type m_translator;
+    Parameters m_parameters;
+    node_pointer m_root;
+    size_type m_values_count;
+    size_type m_leafs_level;
+};
+
+/*!
+\brief Returns the alignment required for the memory block of the flat_rtree.
+
+\ingroup rtree_functions
+
+\param tree The spatial index.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator>
+inline std::size_t flat_alignment(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree)
+{
+    boost::ignore_unused(tree);
+    typedef typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::bounds_type box_type;
+    return detail::rtree::flat_traits<Value, Parameters, box_type>::alignment;
+}
+
+/*!
+\brief Returns the size of the memory block required to store the rtree as flat_rtree.
+
+\ingroup rtree_functions
+
+\param tree The spatial index.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator>
+inline std::size_t flat_size(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree)
+{
+    return detail::rtree::flatten(tree, 0);
+}
+
+/*!
+\brief Stores the rtree in a memory block which may be used by flat_rtree.
+
+\ingroup rtree_functions
+
+\param tree The spatial index.
+\param data The memory block of size returned by flat_size() aligned as returned by flat_alignment().
+
+\return     The number of bytes written.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator>
+inline std::size_t write_flat(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
+                              void * data)
+{
+    if ( data == 0 )
+        detail::throw_invalid_argument("flat rtree: null memory block");
+    if ( reinterpret_cast<std::size_t>(data) % flat_alignment(tree) != 0 )
+        detail::throw_invalid_argument("flat rtree: memory block not aligned");
+
+    char * const bytes = static_cast<char *>(data);
+    std::size_t const size = flat_size(tree);
+    // zero the padding in order to write deterministic content
+    std::memset(bytes, 0, size);
+    return detail::rtree::flatten(tree, bytes);
+}
+
+/*!
+\brief Writes the rtree into a stream in a format which may be used by flat_rtree.
+
+The content of the stream, e.g. a file, may later be mapped into memory
+and passed to flat_rtree. The stream should be opened in binary mode.
+
+\ingroup rtree_functions
+
+\param tree The spatial index.
+\param os   The output stream.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator>
+inline void write_flat(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
+                       std::ostream & os)
+{
+    std::size_t const alignment = flat_alignment(tree);
+    std::size_t const size = flat_size(tree);
+
+    // over-allocate in order to align the beginning of the block
+    std::vector<char> buffer(size + alignment);
+    std::size_t const address = reinterpret_cast<std::size_t>(&buffer[0]);
+    char * const data = &buffer[0] + (alignment - address % alignment) % alignment;
+
+    write_flat(tree, data);
+    os.write(data, static_cast<std::streamsize>(size));
+}
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_FLAT_RTREE_HPP
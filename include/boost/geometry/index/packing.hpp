@@ -0,0 +1,99 @@
+// Boost.Geometry Index
+//
+// R-tree packing algorithm options
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_PACKING_HPP
+#define BOOST_GEOMETRY_INDEX_PACKING_HPP
+
+#include <cstddef>
+
+#include <boost/geometry/util/parallel.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief Parallel packing algorithm options.
+
+Passed to the packing constructor of the rtree in order to build the subtrees
+of the upper levels of the tree in separate threads. The resulting tree is the
+same as the one created by the packing constructor without this object.
+
+\par
+The allocator of the rtree is used concurrently by all of the threads so it
+must be safe to use it this way. The default allocator is. If threads are not
+available or are disabled by defining \c BOOST_GEOMETRY_NO_THREADS the tree is
+created in the calling thread.
+*/
+class parallel_packing
+{
+public:
+    /*!
+    \brief The constructor.
+
+    \param threads              The maximum number of threads, including the calling one.
+                                If 0 the number of hardware threads is used. Default: 0.
+    \param min_subtree_values   The minimum number of values a subtree must contain in order
+                                to be built in a separate thread. Default: 4096.
+    */
+    explicit parallel_packing(std::size_t threads = 0,
+                              std::size_t min_subtree_values = 4096)
+        : m_threads(geometry::detail::parallel::threads_count(threads))
+        , m_min_subtree_values(min_subtree_values)
+    {}
+
+    std::size_t get_threads() const { return m_threads; }
+    std::size_t get_min_subtree_values() const { return m_min_subtree_values; }
+
+private:
+    std::size_t m_threads;
+    std::size_t m_min_subtree_values;
+};
+
+/*!
+\brief The space-filling curves used by the curve packing algorithm.
+*/
+enum packing_curve
+{
+    hilbert_curve,  /*!< The Hilbert curve. */
+    z_order_curve   /*!< The Z-order (Morton) curve. */
+};
+
+/*!
+\brief Space-filling curve packing algorithm options.
+
+Passed to the packing constructor of the rtree in order to use an alternative
+packing algorithm. The Values are sorted by the positions of the centers of their
+Indexables on the space-filling curve and the nodes of each level are filled
+sequentially. All of the nodes are full except at most the last two ones of each
+level.
+
+\par
+The tree is created faster than by the default packing algorithm and the
+neighbouring nodes are stored close to each other. The nodes may overlap more,
+especially for the Z-order curve.
+*/
+class curve_packing
+{
+public:
+    /*!
+    \brief The constructor.
+
+    \param curve   The space-filling curve. Default: hilbert_curve.
+    */
+    explicit curve_packing(packing_curve curve = hilbert_curve)
+        : m_curve(curve)
+    {}
+
+    packing_curve get_curve() const { return m_curve; }
+
+private:
+    packing_curve m_curve;
+};
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_PACKING_HPP
@@ -143,12 +143,43 @@ struct rstar
     static size_t get_overlap_cost_threshold() { return OverlapCostThreshold; }
 };
 
-//template <size_t MaxElements, size_t MinElements>
-//struct kmeans
-//{
-//    static const size_t max_elements = MaxElements;
-//    static const size_t min_elements = MinElements;
-//};
+/*!
+\brief K-means r-tree creation algorithm parameters.
+
+The elements of an overflowing node are divided into two clusters of the
+nearest centers of their bounds. This algorithm should be used for clustered data.
+
+\tparam MaxElements     Maximum number of elements in nodes.
+\tparam MinElements     Minimum number of elements in nodes. Default: 0.3*Max.
+*/
+template <size_t MaxElements,
+          size_t MinElements = detail::default_min_elements_s<MaxElements>::value>
+struct kmeans
+{
+    BOOST_MPL_ASSERT_MSG((0 < MinElements && 2*MinElements <= MaxElements+1),
+                         INVALID_STATIC_MIN_MAX_PARAMETERS, (kmeans));
+
+    static const size_t max_elements = MaxElements;
+    static const size_t min_elements = MinElements;
+
+    static size_t get_max_elements() { return MaxElements; }
+    static size_t get_min_elements() { return MinElements; }
+};
+
+/*!
+\brief Compile-time parameters of the r-tree storing the children of internal nodes in structure-of-arrays layout.
+
+The coordinates of the boxes of the children are stored in separate arrays,
+e.g. min x, min y, max x and max y, so fewer cache lines are read while the
+boxes are tested during the queries and the tests may be vectorized by the compiler.
+The r-tree is created with the algorithm defined by the wrapped parameters.
+
+\tparam Parameters      Compile-time parameters, e.g. linear, quadratic, rstar or kmeans.
+*/
+template <typename Parameters>
+struct soa_nodes
+    : public Parameters
+{};
 
 /*!
 \brief Linear r-tree creation algorithm parameters - run-time version.
@@ -208,6 +239,35 @@ private:
     size_t m_min_elements;
 };
 
+/*!
+\brief K-means r-tree creation algorithm parameters - run-time version.
+*/
+class dynamic_kmeans
+{
+public:
+    /*!
+    \brief The constructor.
+
+    \param max_elements     Maximum number of elements in nodes.
+    \param min_elements     Minimum number of elements in nodes. Default: 0.3*Max.
+    */
+    explicit dynamic_kmeans(size_t max_elements,
+                            size_t min_elements = detail::default_min_elements_d())
+        : m_max_elements(max_elements)
+        , m_min_elements(detail::default_min_elements_d_calc(max_elements, min_elements))
+    {
+        if (!(0 < m_min_elements && 2*m_min_elements <= m_max_elements+1))
+            detail::throw_invalid_argument("invalid min or/and max parameters of dynamic_kmeans");
+    }
+
+    size_t get_max_elements() const { return m_max_elements; }
+    size_t get_min_elements() const { return m_min_elements; }
+
+private:
+    size_t m_max_elements;
+    size_t m_min_elements;
+};
+
 /*!
 \brief R*-tree creation algorithm parameters - run-time version.
 */
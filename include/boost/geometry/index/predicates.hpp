@@ -371,6 +371,182 @@ path(SegmentOrLinestring const& linestring, unsigned k)
 
 #endif // BOOST_GEOMETRY_INDEX_DETAIL_EXPERIMENTAL
 
+/*!
+\brief Generate \c contains() join predicate.
+
+Generate a predicate defining the relationship of the Values of two joined rtrees.
+With this predicate spatial_join() returns the pairs of Values in which the first
+Value contain the second one. A pair is returned if
+<tt>bg::within(Indexable2, Indexable1)</tt> returns <tt>true</tt>.
+
+\par Example
+\verbatim
+bgi::spatial_join(tree1, tree2, bgi::contains(), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+*/
+inline
+detail::predicates::spatial_join_predicate<detail::predicates::contains_tag, false>
+contains()
+{
+    return detail::predicates::spatial_join_predicate<detail::predicates::contains_tag, false>();
+}
+
+/*!
+\brief Generate \c covered_by() join predicate.
+
+Generate a predicate defining the relationship of the Values of two joined rtrees.
+With this predicate spatial_join() returns the pairs of Values in which the first
+Value are covered by the second one. A pair is returned if
+<tt>bg::covered_by(Indexable1, Indexable2)</tt> returns <tt>true</tt>.
+
+\par Example
+\verbatim
+bgi::spatial_join(tree1, tree2, bgi::covered_by(), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+*/
+inline
+detail::predicates::spatial_join_predicate<detail::predicates::covered_by_tag, false>
+covered_by()
+{
+    return detail::predicates::spatial_join_predicate<detail::predicates::covered_by_tag, false>();
+}
+
+/*!
+\brief Generate \c covers() join predicate.
+
+Generate a predicate defining the relationship of the Values of two joined rtrees.
+With this predicate spatial_join() returns the pairs of Values in which the first
+Value cover the second one. A pair is returned if
+<tt>bg::covered_by(Indexable2, Indexable1)</tt> returns <tt>true</tt>.
+
+\par Example
+\verbatim
+bgi::spatial_join(tree1, tree2, bgi::covers(), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+*/
+inline
+detail::predicates::spatial_join_predicate<detail::predicates::covers_tag, false>
+covers()
+{
+    return detail::predicates::spatial_join_predicate<detail::predicates::covers_tag, false>();
+}
+
+/*!
+\brief Generate \c disjoint() join predicate.
+
+Generate a predicate defining the relationship of the Values of two joined rtrees.
+With this predicate spatial_join() returns the pairs of Values in which the first
+Value are disjoint with the second one. A pair is returned if
+<tt>bg::disjoint(Indexable1, Indexable2)</tt> returns <tt>true</tt>.
+
+\par Example
+\verbatim
+bgi::spatial_join(tree1, tree2, bgi::disjoint(), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+*/
+inline
+detail::predicates::spatial_join_predicate<detail::predicates::disjoint_tag, false>
+disjoint()
+{
+    return detail::predicates::spatial_join_predicate<detail::predicates::disjoint_tag, false>();
+}
+
+/*!
+\brief Generate \c intersects() join predicate.
+
+Generate a predicate defining the relationship of the Values of two joined rtrees.
+With this predicate spatial_join() returns the pairs of Values in which the first
+Value intersect the second one. A pair is returned if
+<tt>bg::intersects(Indexable1, Indexable2)</tt> returns <tt>true</tt>.
+
+\par Example
+\verbatim
+bgi::spatial_join(tree1, tree2, bgi::intersects(), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+*/
+inline
+detail::predicates::spatial_join_predicate<detail::predicates::intersects_tag, false>
+intersects()
+{
+    return detail::predicates::spatial_join_predicate<detail::predicates::intersects_tag, false>();
+}
+
+/*!
+\brief Generate \c overlaps() join predicate.
+
+Generate a predicate defining the relationship of the Values of two joined rtrees.
+With this predicate spatial_join() returns the pairs of Values in which the first
+Value overlap the second one. A pair is returned if
+<tt>bg::overlaps(Indexable1, Indexable2)</tt> returns <tt>true</tt>.
+
+\par Example
+\verbatim
+bgi::spatial_join(tree1, tree2, bgi::overlaps(), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+*/
+inline
+detail::predicates::spatial_join_predicate<detail::predicates::overlaps_tag, false>
+overlaps()
+{
+    return detail::predicates::spatial_join_predicate<detail::predicates::overlaps_tag, false>();
+}
+
+/*!
+\brief Generate \c touches() join predicate.
+
+Generate a predicate defining the relationship of the Values of two joined rtrees.
+With this predicate spatial_join() returns the pairs of Values in which the first
+Value touch the second one. A pair is returned if
+<tt>bg::touches(Indexable1, Indexable2)</tt> returns <tt>true</tt>.
+
+\par Example
+\verbatim
+bgi::spatial_join(tree1, tree2, bgi::touches(), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+*/
+inline
+detail::predicates::spatial_join_predicate<detail::predicates::touches_tag, false>
+touches()
+{
+    return detail::predicates::spatial_join_predicate<detail::predicates::touches_tag, false>();
+}
+
+/*!
+\brief Generate \c within() join predicate.
+
+Generate a predicate defining the relationship of the Values of two joined rtrees.
+With this predicate spatial_join() returns the pairs of Values in which the first
+Value are within the second one. A pair is returned if
+<tt>bg::within(Indexable1, Indexable2)</tt> returns <tt>true</tt>.
+
+\par Example
+\verbatim
+bgi::spatial_join(tree1, tree2, bgi::within(), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+*/
+inline
+detail::predicates::spatial_join_predicate<detail::predicates::within_tag, false>
+within()
+{
+    return detail::predicates::spatial_join_predicate<detail::predicates::within_tag, false>();
+}
+
 namespace detail { namespace predicates {
 
 // operator! generators
@@ -389,6 +565,13 @@ operator!(spatial_predicate<Geometry, Tag, Negated> const& p)
     return spatial_predicate<Geometry, Tag, !Negated>(p.geometry);
 }
 
+template <typename Tag, bool Negated> inline
+spatial_join_predicate<Tag, !Negated>
+operator!(spatial_join_predicate<Tag, Negated> const& )
+{
+    return spatial_join_predicate<Tag, !Negated>();
+}
+
 // operator&& generators
 
 template <typename Pred1, typename Pred2> inline
@@ -17,6 +17,7 @@
 
 // Boost
 #include <boost/container/new_allocator.hpp>
+#include <boost/core/ignore_unused.hpp>
 #include <boost/move/move.hpp>
 #include <boost/tuple/tuple.hpp>
 
@@ -64,14 +65,20 @@
 #include <boost/geometry/index/detail/rtree/visitors/destroy.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/spatial_query.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/distance_query.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/distance_query_batch.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/spatial_join.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/count.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/children_box.hpp>
 
 #include <boost/geometry/index/detail/rtree/linear/linear.hpp>
 #include <boost/geometry/index/detail/rtree/quadratic/quadratic.hpp>
 #include <boost/geometry/index/detail/rtree/rstar/rstar.hpp>
-//#include <boost/geometry/extensions/index/detail/rtree/kmeans/kmeans.hpp>
+#include <boost/geometry/index/detail/rtree/kmeans/kmeans.hpp>
 
+#include <boost/geometry/index/packing.hpp>
+#include <boost/geometry/index/batch_query.hpp>
+#include <boost/geometry/index/statistics.hpp>
+#include <boost/geometry/index/spatial_join.hpp>
 #include <boost/geometry/index/detail/rtree/pack_create.hpp>
 
 #include <boost/geometry/index/inserter.hpp>
@@ -109,13 +116,15 @@ algorithm with specific parameters like min and max number of elements in node.
 Predefined algorithms with compile-time parameters are:
 \li <tt>boost::geometry::index::linear</tt>,
  \li <tt>boost::geometry::index::quadratic</tt>,
- \li <tt>boost::geometry::index::rstar</tt>.
+ \li <tt>boost::geometry::index::rstar</tt>,
+ \li <tt>boost::geometry::index::kmeans</tt>.
 
 \par
 Predefined algorithms with run-time parameters are:
  \li \c boost::geometry::index::dynamic_linear,
  \li \c boost::geometry::index::dynamic_quadratic,
- \li \c boost::geometry::index::dynamic_rstar.
+ \li \c boost::geometry::index::dynamic_rstar,
+ \li \c boost::geometry::index::dynamic_kmeans.
 
 \par IndexableGetter
 The object of IndexableGetter type translates from Value to Indexable each time
@@ -335,6 +344,156 @@ public:
         m_members.leafs_level = ll;
     }
 
+    /*!
+    \brief The constructor.
+
+    The tree is created using packing algorithm. The subtrees of the upper levels
+    of the tree are created in separate threads. The resulting tree is the same
+    as the one created by the constructor not taking \c parallel_packing.
+
+    \param first        The beginning of the range of Values.
+    \param last         The end of the range of Values.
+    \param packing      The parallel packing options.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Iterator>
+    inline rtree(Iterator first, Iterator last,
+                 index::parallel_packing const& packing,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type())
+        : m_members(getter, equal, parameters, allocator)
+    {
+        typedef detail::rtree::pack<value_type, options_type, translator_type, box_type, allocators_type> pack;
+        size_type vc = 0, ll = 0;
+        m_members.root = pack::apply(first, last, vc, ll,
+                                     m_members.parameters(), m_members.translator(), m_members.allocators(),
+                                     packing);
+        m_members.values_count = vc;
+        m_members.leafs_level = ll;
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using packing algorithm. The subtrees of the upper levels
+    of the tree are created in separate threads. The resulting tree is the same
+    as the one created by the constructor not taking \c parallel_packing.
+
+    \param rng          The range of Values.
+    \param packing      The parallel packing options.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Range>
+    inline rtree(Range const& rng,
+                 index::parallel_packing const& packing,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type())
+        : m_members(getter, equal, parameters, allocator)
+    {
+        typedef detail::rtree::pack<value_type, options_type, translator_type, box_type, allocators_type> pack;
+        size_type vc = 0, ll = 0;
+        m_members.root = pack::apply(::boost::begin(rng), ::boost::end(rng), vc, ll,
+                                     m_members.parameters(), m_members.translator(), m_members.allocators(),
+                                     packing);
+        m_members.values_count = vc;
+        m_members.leafs_level = ll;
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using the space-filling curve packing algorithm. The Values
+    are sorted by the positions of their Indexables on the curve and the nodes
+    are filled sequentially.
+
+    \param first        The beginning of the range of Values.
+    \param last         The end of the range of Values.
+    \param packing      The curve packing options.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Iterator>
+    inline rtree(Iterator first, Iterator last,
+                 index::curve_packing const& packing,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type())
+        : m_members(getter, equal, parameters, allocator)
+    {
+        typedef detail::rtree::pack<value_type, options_type, translator_type, box_type, allocators_type> pack;
+        size_type vc = 0, ll = 0;
+        m_members.root = pack::apply(first, last, vc, ll,
+                                     m_members.parameters(), m_members.translator(), m_members.allocators(),
+                                     packing);
+        m_members.values_count = vc;
+        m_members.leafs_level = ll;
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using the space-filling curve packing algorithm. The Values
+    are sorted by the positions of their Indexables on the curve and the nodes
+    are filled sequentially.
+
+    \param rng          The range of Values.
+    \param packing      The curve packing options.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Range>
+    inline rtree(Range const& rng,
+                 index::curve_packing const& packing,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type())
+        : m_members(getter, equal, parameters, allocator)
+    {
+        typedef detail::rtree::pack<value_type, options_type, translator_type, box_type, allocators_type> pack;
+        size_type vc = 0, ll = 0;
+        m_members.root = pack::apply(::boost::begin(rng), ::boost::end(rng), vc, ll,
+                                     m_members.parameters(), m_members.translator(), m_members.allocators(),
+                                     packing);
+        m_members.values_count = vc;
+        m_members.leafs_level = ll;
+    }
+
     /*!
     \brief The destructor.
 
@@ -583,6 +742,35 @@ public:
         this->raw_insert(value);
     }
 
+    /*!
+    \brief Insert a value to the index and gather the statistics of the insertion.
+
+    The counters of the statistics are increased by the number of the nodes split
+    and the number of the elements reinserted during this insertion.
+
+    \param value        The value which will be stored in the container.
+    \param statistics   The statistics updated by this insertion.
+
+    \par Throws
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+
+    \warning
+    This operation only guarantees that there will be no memory leaks.
+    After an exception is thrown the R-tree may be left in an inconsistent state,
+    elements must not be inserted or removed. Other operations are allowed however
+    some of them may return invalid data.
+    */
+    inline void insert(value_type const& value, index::insert_statistics & statistics)
+    {
+        if ( !m_members.root )
+            this->raw_create();
+
+        this->raw_insert(value, ::boost::addressof(statistics));
+
+        ++statistics.inserts;
+    }
+
     /*!
     \brief Insert a range of values to the index.
 
@@ -835,7 +1023,300 @@ public:
         static const bool is_distance_predicate = 0 < distance_predicates_count;
         BOOST_MPL_ASSERT_MSG((distance_predicates_count <= 1), PASS_ONLY_ONE_DISTANCE_PREDICATE, (Predicates));
 
-        return query_dispatch(predicates, out_it, boost::mpl::bool_<is_distance_predicate>());
+        return query_dispatch(predicates, out_it, boost::mpl::bool_<is_distance_predicate>(),
+                              static_cast<void *>(0));
+    }
+
+    /*!
+    \brief Finds values meeting passed predicates and gathers the statistics of the query.
+
+    The same as query() but additionally the counters of the statistics are increased
+    by the number of the nodes and leaves visited by this query and the number of
+    the elements of these nodes checked with the predicates.
+
+    \par Example
+    \verbatim
+    bgi::query_statistics stats;
+    tree.query(bgi::intersects(box), std::back_inserter(result), stats);
+    double checks_per_result = double(stats.predicates_checks) / result.size();
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If predicates copy throws.
+
+    \warning
+    Only one \c nearest() predicate may be passed to the query. Passing more of them results in compile-time error.
+
+    \param predicates   Predicates.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+    \param statistics   The statistics updated by this query.
+
+    \return             The number of values found.
+    */
+    template <typename Predicates, typename OutIter>
+    size_type query(Predicates const& predicates, OutIter out_it, index::query_statistics & statistics) const
+    {
+        if ( !m_members.root )
+            return 0;
+
+        static const unsigned distance_predicates_count = detail::predicates_count_distance<Predicates>::value;
+        static const bool is_distance_predicate = 0 < distance_predicates_count;
+        BOOST_MPL_ASSERT_MSG((distance_predicates_count <= 1), PASS_ONLY_ONE_DISTANCE_PREDICATE, (Predicates));
+
+        return query_dispatch(predicates, out_it, boost::mpl::bool_<is_distance_predicate>(),
+                              ::boost::addressof(statistics));
+    }
+
+    /*!
+    \brief Performs many k-nearest neighbours queries at once.
+
+    The result of each query is the same as the result of query() called with the
+    corresponding predicates, though if several values are equally distant the one
+    returned may be different. The queries are ordered along the Hilbert curve so
+    the subsequent queries access the same nodes of the tree. The neighbors found
+    by a query are used to prune the nodes of the tree during the next one.
+    The queries may be performed in several threads.
+
+    \par Example
+    \verbatim
+    std::vector<point> points;
+    std::vector<std::vector<value_type> > results(points.size());
+
+    std::vector<nearest_type> predicates;
+    std::vector<std::back_insert_iterator<std::vector<value_type> > > out_its;
+    for ( std::size_t i = 0 ; i < points.size() ; ++i )
+    {
+        predicates.push_back(bgi::nearest(points[i], 5));
+        out_its.push_back(std::back_inserter(results[i]));
+    }
+
+    tree.query_batch(predicates, out_its, bgi::batch_query(4));
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If the output iterators throw.
+    std::invalid_argument if the sizes of the ranges are different.
+
+    \warning
+    Each predicates object must contain exactly one \c nearest() predicate.
+    If more than one thread is used the output iterators must write to separate containers.
+
+    \param predicates   The random access range of predicates objects, one for each query.
+    \param out_its      The random access range of output iterators, one for each query.
+    \param batch        The batched query options.
+
+    \return             The total number of values found.
+    */
+    template <typename PredicatesRange, typename OutIterRange>
+    size_type query_batch(PredicatesRange const& predicates, OutIterRange const& out_its,
+                          index::batch_query const& batch = index::batch_query()) const
+    {
+        typedef typename boost::range_value<PredicatesRange>::type predicates_type;
+        typedef typename boost::range_iterator<PredicatesRange const>::type predicates_iterator;
+        typedef typename boost::range_iterator<OutIterRange const>::type out_iter_iterator;
+
+        static const unsigned distance_predicates_count = detail::predicates_count_distance<predicates_type>::value;
+        BOOST_MPL_ASSERT_MSG((distance_predicates_count == 1), PASS_ONE_DISTANCE_PREDICATE, (predicates_type));
+        static const unsigned distance_predicate_index = detail::predicates_find_distance<predicates_type>::value;
+
+        std::size_t const count = boost::size(predicates);
+        if ( count != std::size_t(boost::size(out_its)) )
+            detail::throw_invalid_argument("the numbers of predicates and output iterators are different");
+
+        if ( !m_members.root || count == 0 )
+            return 0;
+
+        typedef detail::rtree::visitors::distance_query_batch<
+            value_type, options_type, translator_type, box_type, allocators_type,
+            predicates_type, distance_predicate_index
+        > visitor_type;
+
+        // order the queries along the Hilbert curve
+        box_type const space = bounds();
+        predicates_iterator const preds_first = boost::begin(predicates);
+        std::vector< std::pair<detail::hilbert_key_type, std::size_t> > order(count);
+        for ( std::size_t i = 0 ; i < count ; ++i )
+        {
+            order[i].first = detail::rtree::visitors::distance_query_batch_key(
+                detail::predicates_element<distance_predicate_index, predicates_type>::get(*(preds_first + i)),
+                space);
+            order[i].second = i;
+        }
+        std::sort(order.begin(), order.end());
+
+        // divide the queries into chunks processed by the threads,
+        // more chunks than threads in order to balance the work
+        std::size_t const threads = batch.get_threads();
+        std::size_t const chunks_max = threads > 1 ? threads * 8 : 1;
+        std::size_t const chunk_size = (count + chunks_max - 1) / chunks_max;
+        std::size_t const chunks_count = (count + chunk_size - 1) / chunk_size;
+        std::vector<size_type> found(chunks_count, 0);
+
+        detail::rtree::visitors::distance_query_batch_task<
+            visitor_type, node, predicates_iterator, out_iter_iterator,
+            std::vector< std::pair<detail::hilbert_key_type, std::size_t> >
+        > task(m_members.parameters(), m_members.translator(),
+               *m_members.root, preds_first, boost::begin(out_its),
+               order, chunk_size, found);
+
+        geometry::detail::parallel::for_each_index(chunks_count, threads, task);
+
+        size_type result = 0;
+        for ( std::size_t i = 0 ; i < chunks_count ; ++i )
+            result += found[i];
+        return result;
+    }
+
+    /*!
+    \brief Finds the pairs of values of this and the other rtree meeting the join predicate.
+
+    Both trees are traversed at the same time. Only the pairs of nodes of both trees
+    for which the values may meet the predicate are visited. The pairs of values
+    are written to the output iterator as <tt>std::pair<value_type, OtherValue></tt>.
+
+    The join predicate is generated with one of the spatial predicates' generators
+    called without arguments. The first value of a pair plays the role of the Value
+    and the second one the role of the Geometry, e.g. <tt>bgi::within()</tt> returns
+    the pairs in which the first value is within the second one. The predicates
+    may be negated with <tt>operator!</tt>. \c disjoint() and negated predicates
+    (except <tt>!disjoint()</tt>) can't prune the nodes and test all of the pairs of values.
+
+    \par Example
+    \verbatim
+    // the pairs of intersecting values
+    tree1.spatial_join(tree2, bgi::intersects(), std::back_inserter(result));
+    // the values of tree1 within the values of tree2, the pairs are passed to a function object
+    tree1.spatial_join(tree2, bgi::within(), boost::make_function_output_iterator(do_something()));
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If the output iterator throws.
+
+    \param other        The other rtree.
+    \param predicate    The join predicate.
+    \param out_it       The output iterator of pairs of values.
+
+    \return             The number of pairs found.
+    */
+    template <typename Rtree, typename JoinPredicate, typename OutIter>
+    size_type spatial_join(Rtree const& other, JoinPredicate const& predicate, OutIter out_it) const
+    {
+        boost::ignore_unused(predicate);
+
+        typedef detail::rtree::utilities::view<Rtree> other_view;
+        other_view const other_v(other);
+
+        if ( !m_members.root || other.empty() )
+            return 0;
+
+        typename other_view::translator_type const other_tr = other_v.translator();
+
+        detail::rtree::visitors::spatial_join<
+            value_type, options_type, translator_type, box_type, allocators_type,
+            typename other_view::value_type, typename other_view::options_type,
+            typename other_view::translator_type, typename other_view::box_type,
+            typename other_view::allocators_type,
+            JoinPredicate, OutIter
+        > join_v(m_members.translator(), other_tr, out_it);
+
+        join_v.apply(*m_members.root, bounds(), other_v, other.bounds());
+
+        return join_v.found_count();
+    }
+
+    /*!
+    \brief Finds the pairs of values of this and the other rtree meeting the join predicate using several threads.
+
+    The same as the sequential spatial_join() but the pairs of subtrees of both trees
+    are processed in separate threads. The pairs found by the threads are buffered and
+    written to the output iterator in the calling thread in the order in which the
+    sequential version returns them.
+
+    \par Example
+    \verbatim
+    tree1.spatial_join(tree2, bgi::intersects(), std::back_inserter(result), bgi::parallel_join(4));
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If the output iterator throws.
+    If allocation throws.
+
+    \param other        The other rtree.
+    \param predicate    The join predicate.
+    \param out_it       The output iterator of pairs of values.
+    \param parallel     The parallel join options.
+
+    \return             The number of pairs found.
+    */
+    template <typename Rtree, typename JoinPredicate, typename OutIter>
+    size_type spatial_join(Rtree const& other, JoinPredicate const& predicate, OutIter out_it,
+                           index::parallel_join const& parallel) const
+    {
+        typedef detail::rtree::utilities::view<Rtree> other_view;
+        other_view const other_v(other);
+
+        std::size_t const threads = parallel.get_threads();
+        size_type const levels = (std::min)(m_members.leafs_level, size_type(other_v.depth()));
+
+        if ( threads <= 1 || !m_members.root || other.empty() || levels == 0 )
+            return spatial_join(other, predicate, out_it);
+
+        typename other_view::translator_type const other_tr = other_v.translator();
+
+        typedef std::vector< std::pair<value_type, typename other_view::value_type> > buffer_type;
+        typedef detail::rtree::visitors::spatial_join<
+            value_type, options_type, translator_type, box_type, allocators_type,
+            typename other_view::value_type, typename other_view::options_type,
+            typename other_view::translator_type, typename other_view::box_type,
+            typename other_view::allocators_type,
+            JoinPredicate, std::back_insert_iterator<buffer_type>
+        > join_type;
+
+        box_type const this_bounds = bounds();
+        typename other_view::box_type const other_bounds = other.bounds();
+
+        // traverse the upper levels of both trees until there are enough pairs
+        // of subtrees, more pairs than threads in order to balance the work
+        std::size_t const chunks_max = threads * 8;
+        std::vector<typename join_type::subtrees_type> subtrees;
+        size_type level = 0;
+        for ( ;; ++level )
+        {
+            buffer_type unused;
+            subtrees.clear();
+            join_type collect_v(m_members.translator(), other_tr, std::back_inserter(unused));
+            collect_v.collect(level, subtrees);
+            collect_v.apply(*m_members.root, this_bounds, other_v, other_bounds);
+
+            if ( chunks_max <= subtrees.size() || levels <= level + 1 )
+                break;
+        }
+
+        if ( subtrees.empty() )
+            return 0;
+
+        std::size_t const chunk_size = (subtrees.size() + chunks_max - 1) / chunks_max;
+        std::size_t const chunks_count = (subtrees.size() + chunk_size - 1) / chunk_size;
+        std::vector<buffer_type> buffers(chunks_count);
+
+        detail::rtree::visitors::spatial_join_task<
+            join_type, translator_type, typename other_view::translator_type, buffer_type
+        > task(m_members.translator(), other_tr, subtrees, level + 1, chunk_size, buffers);
+
+        geometry::detail::parallel::for_each_index(chunks_count, threads, task);
+
+        // write the pairs in the order of the subtrees
+        size_type result = 0;
+        for ( std::size_t i = 0 ; i < chunks_count ; ++i )
+        {
+            out_it = std::copy(buffers[i].begin(), buffers[i].end(), out_it);
+            result += buffers[i].size();
+        }
+        return result;
     }
 
     /*!
@@ -1425,7 +1906,7 @@ private:
     \par Exception-safety
     basic
     */
-    inline void raw_insert(value_type const& value)
+    inline void raw_insert(value_type const& value, index::insert_statistics * statistics = 0)
     {
         BOOST_GEOMETRY_INDEX_ASSERT(m_members.root, "The root must exist");
         // CONSIDER: alternative - ignore invalid indexable or throw an exception
@@ -1436,7 +1917,8 @@ private:
             value_type, options_type, translator_type, box_type, allocators_type,
             typename options_type::insert_tag
         > insert_v(m_members.root, m_members.leafs_level, value,
-                   m_members.parameters(), m_members.translator(), m_members.allocators());
+                   m_members.parameters(), m_members.translator(), m_members.allocators(),
+                   0, statistics);
 
         detail::rtree::apply_visitor(insert_v, *m_members.root);
 
@@ -1640,11 +2122,12 @@ private:
     \par Exception-safety
     strong
     */
-    template <typename Predicates, typename OutIter>
-    size_type query_dispatch(Predicates const& predicates, OutIter out_it, boost::mpl::bool_<false> const& /*is_distance_predicate*/) const
+    template <typename Predicates, typename OutIter, typename Statistics>
+    size_type query_dispatch(Predicates const& predicates, OutIter out_it, boost::mpl::bool_<false> const& /*is_distance_predicate*/,
+                             Statistics * statistics) const
     {
-        detail::rtree::visitors::spatial_query<value_type, options_type, translator_type, box_type, allocators_type, Predicates, OutIter>
-            find_v(m_members.translator(), predicates, out_it);
+        detail::rtree::visitors::spatial_query<value_type, options_type, translator_type, box_type, allocators_type, Predicates, OutIter, Statistics>
+            find_v(m_members.translator(), predicates, out_it, statistics);
 
         detail::rtree::apply_visitor(find_v, *m_members.root);
 
@@ -1657,8 +2140,9 @@ private:
     \par Exception-safety
     strong
     */
-    template <typename Predicates, typename OutIter>
-    size_type query_dispatch(Predicates const& predicates, OutIter out_it, boost::mpl::bool_<true> const& /*is_distance_predicate*/) const
+    template <typename Predicates, typename OutIter, typename Statistics>
+    size_type query_dispatch(Predicates const& predicates, OutIter out_it, boost::mpl::bool_<true> const& /*is_distance_predicate*/,
+                             Statistics * statistics) const
     {
         BOOST_GEOMETRY_INDEX_ASSERT(m_members.root, "The root must exist");
 
@@ -1671,8 +2155,9 @@ private:
             allocators_type,
             Predicates,
             distance_predicate_index,
-            OutIter
-        > distance_v(m_members.parameters(), m_members.translator(), predicates, out_it);
+            OutIter,
+            Statistics
+        > distance_v(m_members.parameters(), m_members.translator(), predicates, out_it, statistics);
 
         detail::rtree::apply_visitor(distance_v, *m_members.root);
 
@@ -1972,6 +2457,77 @@ query(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
     return tree.query(predicates, out_it);
 }
 
+/*!
+\brief Finds the pairs of values of two rtrees meeting the join predicate.
+
+It calls \c rtree::spatial_join(Rtree const&, JoinPredicate const&, OutIter).
+
+\par Example
+\verbatim
+bgi::spatial_join(tree1, tree2, bgi::intersects(), std::back_inserter(result));
+\endverbatim
+
+\par Throws
+If Value copy constructor or copy assignment throws.
+If the output iterator throws.
+
+\ingroup rtree_functions
+
+\param tree1        The first rtree.
+\param tree2        The second rtree.
+\param predicate    The join predicate.
+\param out_it       The output iterator of pairs of values.
+
+\return             The number of pairs found.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+          typename Rtree, typename JoinPredicate, typename OutIter> inline
+typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+spatial_join(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree1,
+             Rtree const& tree2,
+             JoinPredicate const& predicate,
+             OutIter out_it)
+{
+    return tree1.spatial_join(tree2, predicate, out_it);
+}
+
+/*!
+\brief Finds the pairs of values of two rtrees meeting the join predicate using several threads.
+
+It calls \c rtree::spatial_join(Rtree const&, JoinPredicate const&, OutIter, parallel_join const&).
+
+\par Example
+\verbatim
+bgi::spatial_join(tree1, tree2, bgi::intersects(), std::back_inserter(result), bgi::parallel_join());
+\endverbatim
+
+\par Throws
+If Value copy constructor or copy assignment throws.
+If the output iterator throws.
+If allocation throws.
+
+\ingroup rtree_functions
+
+\param tree1        The first rtree.
+\param tree2        The second rtree.
+\param predicate    The join predicate.
+\param out_it       The output iterator of pairs of values.
+\param parallel     The parallel join options.
+
+\return             The number of pairs found.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+          typename Rtree, typename JoinPredicate, typename OutIter> inline
+typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+spatial_join(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree1,
+             Rtree const& tree2,
+             JoinPredicate const& predicate,
+             OutIter out_it,
+             parallel_join const& parallel)
+{
+    return tree1.spatial_join(tree2, predicate, out_it, parallel);
+}
+
 /*!
 \brief Returns the query iterator pointing at the begin of the query range.
 
@@ -0,0 +1,53 @@
+// Boost.Geometry Index
+//
+// R-tree spatial join options
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_SPATIAL_JOIN_HPP
+#define BOOST_GEOMETRY_INDEX_SPATIAL_JOIN_HPP
+
+#include <cstddef>
+
+#include <boost/geometry/util/parallel.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief Parallel spatial join options.
+
+Passed to spatial_join() in order to process the pairs of the subtrees of both
+rtrees in separate threads. The upper levels of the trees are traversed until
+there are enough pairs of intersecting subtrees, then the pairs are divided
+between the threads. The pairs of Values found by each thread are buffered and
+written to the output iterator in the calling thread in the same order in which
+the sequential spatial_join() returns them.
+
+\par
+If threads are not available or are disabled by defining \c BOOST_GEOMETRY_NO_THREADS
+the join is performed in the calling thread.
+*/
+class parallel_join
+{
+public:
+    /*!
+    \brief The constructor.
+
+    \param threads  The maximum number of threads, including the calling one.
+                    If 0 the number of hardware threads is used. Default: 0.
+    */
+    explicit parallel_join(std::size_t threads = 0)
+        : m_threads(geometry::detail::parallel::threads_count(threads))
+    {}
+
+    std::size_t get_threads() const { return m_threads; }
+
+private:
+    std::size_t m_threads;
+};
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_SPATIAL_JOIN_HPP
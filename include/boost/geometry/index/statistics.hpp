@@ -0,0 +1,76 @@
+// Boost.Geometry Index
+//
+// R-tree query and insert statistics
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_STATISTICS_HPP
+#define BOOST_GEOMETRY_INDEX_STATISTICS_HPP
+
+#include <cstddef>
+
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief The counters of the work done by queries.
+
+Passed to rtree::query(). The counters are increased by each query so the same
+object may gather the statistics of many queries. The counters are updated
+only if the object is passed, the queries without it have no additional cost.
+
+\par
+The object may be used by only one query at a time. For concurrent queries
+separate objects should be used and summed afterwards.
+*/
+struct query_statistics
+{
+    query_statistics()
+        : nodes(0), leaves(0), predicates_checks(0)
+    {}
+
+    /*! \brief Resets all counters to 0. */
+    void clear()
+    {
+        *this = query_statistics();
+    }
+
+    /*! \brief The number of visited nodes, including leaves. */
+    std::size_t nodes;
+    /*! \brief The number of visited leaves. */
+    std::size_t leaves;
+    /*! \brief The number of elements of the visited nodes, children boxes and values, checked with the predicates. */
+    std::size_t predicates_checks;
+};
+
+/*!
+\brief The counters of the work done by insertions.
+
+Passed to rtree::insert(). The counters are increased by each insertion so the
+same object may gather the statistics of many insertions. The counters are
+updated only if the object is passed.
+*/
+struct insert_statistics
+{
+    insert_statistics()
+        : inserts(0), splits(0), reinserts(0)
+    {}
+
+    /*! \brief Resets all counters to 0. */
+    void clear()
+    {
+        *this = insert_statistics();
+    }
+
+    /*! \brief The number of inserted values. */
+    std::size_t inserts;
+    /*! \brief The number of nodes split because of overflow. */
+    std::size_t splits;
+    /*! \brief The number of elements removed and inserted again by the R*-tree forced reinsertion. */
+    std::size_t reinserts;
+};
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_STATISTICS_HPP
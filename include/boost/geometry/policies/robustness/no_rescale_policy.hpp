@@ -14,6 +14,10 @@
 
 #include <stddef.h>
 
+#include <boost/config.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
 #include <boost/geometry/core/coordinate_type.hpp>
 #include <boost/geometry/policies/robustness/robust_point_type.hpp>
 #include <boost/geometry/policies/robustness/segment_ratio.hpp>
@@ -55,9 +59,20 @@ template <typename Point>
 struct segment_ratio_type<Point, detail::no_rescale_policy>
 {
     // Define a segment_ratio defined on coordinate type, e.g.
-    // int/int or float/float
+    // float/float, or for integral coordinates on long long, as for
+    // the rescaled coordinates, because the ratio is a quotient of
+    // products of the coordinates
     typedef typename geometry::coordinate_type<Point>::type coordinate_type;
-    typedef segment_ratio<coordinate_type> type;
+    typedef segment_ratio
+        <
+            typename boost::mpl::if_c
+                <
+                    boost::is_integral<coordinate_type>::value
+                    && sizeof(coordinate_type) <= sizeof(boost::long_long_type),
+                    boost::long_long_type,
+                    coordinate_type
+                >::type
+        > type;
 };
 
 
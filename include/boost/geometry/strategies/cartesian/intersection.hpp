@@ -17,6 +17,11 @@
 #define BOOST_GEOMETRY_STRATEGIES_CARTESIAN_INTERSECTION_HPP
 
 #include <algorithm>
+#include <limits>
+
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_integral.hpp>
 
 #include <boost/geometry/core/exception.hpp>
 
@@ -233,11 +238,43 @@ struct cartesian_segments
             set<0>(point, get<0, 0>(segment) + boost::numeric_cast
                 <
                     CoordinateType
-                >(numerator * dx_promoted / denominator));
+                >(scale(numerator, denominator, dx_promoted)));
             set<1>(point, get<0, 1>(segment) + boost::numeric_cast
                 <
                     CoordinateType
-                >(numerator * dy_promoted / denominator));
+                >(scale(numerator, denominator, dy_promoted)));
+        }
+
+        // Returns numerator * d / denominator. Integers are multiplied
+        // first, unless the product overflows, then the quotient is
+        // calculated in double and truncated as the integer division.
+        template <typename T>
+        static inline T scale(T const& numerator, T const& denominator, T const& d)
+        {
+            return scale(numerator, denominator, d,
+                         typename boost::is_integral<T>::type());
+        }
+
+        template <typename T>
+        static inline T scale(T const& numerator, T const& denominator, T const& d,
+                              boost::true_type)
+        {
+            if (d != 0
+                && geometry::math::abs(numerator)
+                    > (std::numeric_limits<T>::max)() / geometry::math::abs(d))
+            {
+                return boost::numeric_cast<T>(boost::numeric_cast<double>(numerator)
+                        / boost::numeric_cast<double>(denominator)
+                        * boost::numeric_cast<double>(d));
+            }
+            return numerator * d / denominator;
+        }
+
+        template <typename T>
+        static inline T scale(T const& numerator, T const& denominator, T const& d,
+                              boost::false_type)
+        {
+            return numerator * d / denominator;
         }
 
     public :
@@ -406,6 +443,15 @@ struct cartesian_segments
                 ratio_type
             > sinfo;
 
+        // Integral coordinates are multiplied in the type of the ratio,
+        // e.g. long long, to avoid overflow
+        typedef typename boost::mpl::if_c
+            <
+                boost::is_integral<robust_coordinate_type>::value,
+                typename ratio_type::numeric_type,
+                robust_coordinate_type
+            >::type robust_calculation_type;
+
         sinfo.dx_a = get<1, 0>(a) - get<0, 0>(a); // distance in x-dir
         sinfo.dx_b = get<1, 0>(b) - get<0, 0>(b);
         sinfo.dy_a = get<1, 1>(a) - get<0, 1>(a); // distance in y-dir
@@ -420,8 +466,8 @@ struct cartesian_segments
         // (only calculated for non-collinear segments)
         if (! collinear)
         {
-            robust_coordinate_type robust_da0, robust_da;
-            robust_coordinate_type robust_db0, robust_db;
+            robust_calculation_type robust_da0, robust_da;
+            robust_calculation_type robust_db0, robust_db;
 
             cramers_rule(robust_dx_a, robust_dy_a, robust_dx_b, robust_dy_b,
                 get<0>(robust_a1) - get<0>(robust_b1),
@@ -433,9 +479,9 @@ struct cartesian_segments
                 get<1>(robust_b1) - get<1>(robust_a1),
                 robust_db0, robust_db);
 
-            math::detail::equals_factor_policy<robust_coordinate_type>
+            math::detail::equals_factor_policy<robust_calculation_type>
                 policy(robust_dx_a, robust_dy_a, robust_dx_b, robust_dy_b);
-            robust_coordinate_type const zero = 0;
+            robust_calculation_type const zero = 0;
             if (math::detail::equals_by_policy(robust_da0, zero, policy)
              || math::detail::equals_by_policy(robust_db0, zero, policy))
             {
@@ -21,6 +21,8 @@
 #define BOOST_GEOMETRY_STRATEGIES_CARTESIAN_SIDE_BY_TRIANGLE_HPP
 
 #include <boost/mpl/if.hpp>
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 #include <boost/type_traits/is_integral.hpp>
 #include <boost/type_traits/is_void.hpp>
 
@@ -222,6 +224,53 @@ public :
 
     template <typename P1, typename P2, typename P>
     static inline int apply(P1 const& p1, P2 const& p2, P const& p)
+    {
+        // Integral coordinates (up to 64 bits) are compared exactly,
+        // unless another calculation type is specified
+        static const bool is_exact
+            = boost::is_void<CalculationType>::type::value
+            && is_exact_integral<typename coordinate_type<P1>::type>::value
+            && is_exact_integral<typename coordinate_type<P2>::type>::value
+            && is_exact_integral<typename coordinate_type<P>::type>::value;
+
+        return apply(p1, p2, p, boost::integral_constant<bool, is_exact>());
+    }
+
+private:
+    template <typename T>
+    struct is_exact_integral
+        : boost::integral_constant
+            <
+                bool,
+                boost::is_integral<T>::value
+                && sizeof(T) <= sizeof(boost::long_long_type)
+            >
+    {};
+
+    // The differences are calculated in long long, so the coordinates
+    // should be less than 2^62 in magnitude, and the sign of the
+    // determinant without overflow
+    template <typename P1, typename P2, typename P>
+    static inline int apply(P1 const& p1, P2 const& p2, P const& p,
+                            boost::true_type)
+    {
+        typedef boost::long_long_type ll;
+
+        ll const x1 = boost::numeric_cast<ll>(get<0>(p1));
+        ll const y1 = boost::numeric_cast<ll>(get<1>(p1));
+
+        return geometry::detail::determinant_sign
+            (
+                boost::numeric_cast<ll>(get<0>(p2)) - x1,
+                boost::numeric_cast<ll>(get<1>(p2)) - y1,
+                boost::numeric_cast<ll>(get<0>(p)) - x1,
+                boost::numeric_cast<ll>(get<1>(p)) - y1
+            );
+    }
+
+    template <typename P1, typename P2, typename P>
+    static inline int apply(P1 const& p1, P2 const& p2, P const& p,
+                            boost::false_type)
     {
         typedef typename coordinate_type<P1>::type coordinate_type1;
         typedef typename coordinate_type<P2>::type coordinate_type2;
@@ -265,7 +314,6 @@ public :
             : -1;
     }
 
-private:
     template <typename P1, typename P2>
     static inline bool equals_point_point(P1 const& p1, P2 const& p2)
     {
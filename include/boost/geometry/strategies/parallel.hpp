@@ -0,0 +1,117 @@
+// Boost.Geometry
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_STRATEGIES_PARALLEL_HPP
+#define BOOST_GEOMETRY_STRATEGIES_PARALLEL_HPP
+
+
+#include <cstddef>
+
+#include <boost/core/addressof.hpp>
+
+#include <boost/geometry/util/parallel.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+namespace strategy { namespace intersection
+{
+
+/*!
+\brief Intersection strategy wrapper enabling multi-threaded overlay phases
+\ingroup strategies
+\details Behaves exactly like the wrapped Strategy and may be passed to
+    the algorithms instead of it. The algorithms supporting it split
+    their work, e.g. the calculation of turns of pairs of sections,
+    between threads. The results are the same as with the wrapped Strategy.
+    If threads are not available or are disabled by defining
+    \c BOOST_GEOMETRY_NO_THREADS all of the work is done in the calling thread.
+\tparam Strategy the wrapped intersection strategy, e.g. cartesian_segments<>
+*/
+template <typename Strategy>
+class parallel
+    : public Strategy
+{
+public :
+    /*!
+    \brief The constructor.
+    \param threads The maximum number of threads, including the calling one.
+        If 0 the number of hardware threads is used. Default: 0.
+    \param min_pairs The minimum number of pairs of sections for which
+        threads are used. Default: 256.
+    \param strategy The wrapped strategy.
+    */
+    explicit parallel(std::size_t threads = 0,
+                      std::size_t min_pairs = 256,
+                      Strategy const& strategy = Strategy())
+        : Strategy(strategy)
+        , m_threads(geometry::detail::parallel::threads_count(threads))
+        , m_min_pairs(min_pairs)
+    {}
+
+    std::size_t get_threads() const { return m_threads; }
+    std::size_t get_min_pairs() const { return m_min_pairs; }
+
+private :
+    std::size_t m_threads;
+    std::size_t m_min_pairs;
+};
+
+}} // namespace strategy::intersection
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace parallel
+{
+
+// The overloads taking pointers are chosen also for the strategies derived
+// from strategy::intersection::parallel, e.g. wrapped with other wrappers
+template <typename Strategy>
+inline std::size_t threads_of(strategy::intersection::parallel<Strategy> const* strategy)
+{
+    return strategy->get_threads();
+}
+
+inline std::size_t threads_of(void const* )
+{
+    return 1;
+}
+
+template <typename Strategy>
+inline std::size_t min_pairs_of(strategy::intersection::parallel<Strategy> const* strategy)
+{
+    return strategy->get_min_pairs();
+}
+
+inline std::size_t min_pairs_of(void const* )
+{
+    return 0;
+}
+
+// Returns the number of threads requested by the strategy, 1 for all of
+// the strategies not wrapped with strategy::intersection::parallel
+template <typename Strategy>
+inline std::size_t strategy_threads(Strategy const& strategy)
+{
+    return threads_of(boost::addressof(strategy));
+}
+
+// Returns the minimum number of pairs of elements for which threads are used
+template <typename Strategy>
+inline std::size_t strategy_min_pairs(Strategy const& strategy)
+{
+    return min_pairs_of(boost::addressof(strategy));
+}
+
+}} // namespace detail::parallel
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_STRATEGIES_PARALLEL_HPP
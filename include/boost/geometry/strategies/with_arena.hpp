@@ -0,0 +1,160 @@
+// Boost.Geometry
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_STRATEGIES_WITH_ARENA_HPP
+#define BOOST_GEOMETRY_STRATEGIES_WITH_ARENA_HPP
+
+
+#include <memory>
+
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+
+#include <boost/geometry/util/monotonic_arena.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace arena
+{
+
+// Base of the strategies passing an arena to the algorithms
+class arena_strategy_base
+{
+public :
+    explicit arena_strategy_base(monotonic_arena& arena)
+        : m_arena(&arena)
+    {}
+
+    monotonic_arena& get_arena() const { return *m_arena; }
+
+private :
+    monotonic_arena* m_arena;
+};
+
+}} // namespace detail::arena
+#endif // DOXYGEN_NO_DETAIL
+
+
+namespace strategy { namespace intersection
+{
+
+/*!
+\brief Intersection strategy wrapper passing a memory arena to overlay
+\ingroup strategies
+\details Behaves exactly like the wrapped Strategy and may be passed to
+    the set operations instead of it. The temporary containers of overlay,
+    e.g. turns, clusters, rings and per-ring maps, take their memory from
+    the arena. The arena is released when the operation finishes.
+\tparam Strategy the wrapped intersection strategy, e.g. cartesian_segments<>
+*/
+template <typename Strategy>
+class with_arena
+    : public Strategy
+    , public detail::arena::arena_strategy_base
+{
+public :
+    /*!
+    \brief The constructor.
+    \param arena The arena, it must outlive the operations using the strategy.
+    \param strategy The wrapped strategy.
+    */
+    explicit with_arena(monotonic_arena& arena,
+                        Strategy const& strategy = Strategy())
+        : Strategy(strategy)
+        , detail::arena::arena_strategy_base(arena)
+    {}
+};
+
+}} // namespace strategy::intersection
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace arena
+{
+
+template <typename Strategy>
+struct has_arena
+    : boost::is_base_of<arena_strategy_base, Strategy>
+{};
+
+// Allocator of T of the temporary containers of an algorithm called with
+// the Strategy, std::allocator unless the strategy has an arena
+template <typename Strategy, typename T>
+struct strategy_allocator
+{
+    typedef typename boost::mpl::if_c
+        <
+            has_arena<Strategy>::value,
+            arena_allocator<T>,
+            std::allocator<T>
+        >::type type;
+};
+
+template <typename Allocator>
+struct make_allocator
+{
+    template <typename Strategy>
+    static inline Allocator apply(Strategy const& )
+    {
+        return Allocator();
+    }
+};
+
+template <typename T>
+struct make_allocator<arena_allocator<T> >
+{
+    static inline arena_allocator<T> apply(arena_strategy_base const& strategy)
+    {
+        return arena_allocator<T>(&strategy.get_arena());
+    }
+};
+
+// Returns the allocator of T to be used with the Strategy
+template <typename T, typename Strategy>
+inline typename strategy_allocator<Strategy, T>::type
+    get_allocator(Strategy const& strategy)
+{
+    return make_allocator
+        <
+            typename strategy_allocator<Strategy, T>::type
+        >::apply(strategy);
+}
+
+// Releases the arena of the strategy, if any, when destroyed.
+// Should be created before the containers using the arena.
+template <typename Strategy, bool HasArena = has_arena<Strategy>::value>
+struct release_guard
+{
+    explicit release_guard(Strategy const& )
+    {}
+};
+
+template <typename Strategy>
+struct release_guard<Strategy, true>
+{
+    explicit release_guard(Strategy const& strategy)
+        : m_arena(strategy.get_arena())
+    {}
+
+    ~release_guard()
+    {
+        m_arena.release();
+    }
+
+    monotonic_arena& m_arena;
+};
+
+}} // namespace detail::arena
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_STRATEGIES_WITH_ARENA_HPP
@@ -0,0 +1,155 @@
+// Boost.Geometry
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_STRATEGIES_WITH_STATISTICS_HPP
+#define BOOST_GEOMETRY_STRATEGIES_WITH_STATISTICS_HPP
+
+
+#include <cstddef>
+
+#include <boost/core/addressof.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/geometry/strategies/with_arena.hpp>
+#include <boost/geometry/util/overlay_statistics.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace statistics
+{
+
+// Base of the strategies passing an overlay_statistics to the algorithms
+class statistics_strategy_base
+{
+public :
+    explicit statistics_strategy_base(overlay_statistics& statistics)
+        : m_statistics(&statistics)
+    {}
+
+    overlay_statistics& get_statistics() const { return *m_statistics; }
+
+private :
+    overlay_statistics* m_statistics;
+};
+
+}} // namespace detail::statistics
+#endif // DOXYGEN_NO_DETAIL
+
+
+namespace strategy { namespace intersection
+{
+
+/*!
+\brief Intersection strategy wrapper collecting the timings and counters
+    of overlay
+\ingroup strategies
+\details Behaves exactly like the wrapped Strategy and may be passed to
+    the set operations instead of it. The time of each phase of overlay
+    and the numbers of turns, clusters and rings are added to the
+    overlay_statistics. Without this wrapper nothing is measured.
+\tparam Strategy the wrapped intersection strategy, e.g. cartesian_segments<>,
+    possibly wrapped with the other wrappers, e.g. with_arena
+*/
+template <typename Strategy>
+class with_statistics
+    : public Strategy
+    , public detail::statistics::statistics_strategy_base
+{
+public :
+    /*!
+    \brief The constructor.
+    \param statistics The statistics, they must outlive the operations
+        using the strategy.
+    \param strategy The wrapped strategy.
+    */
+    explicit with_statistics(overlay_statistics& statistics,
+                             Strategy const& strategy = Strategy())
+        : Strategy(strategy)
+        , detail::statistics::statistics_strategy_base(statistics)
+    {}
+};
+
+}} // namespace strategy::intersection
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace statistics
+{
+
+// The overloads taking pointers are chosen also for the strategies derived
+// from strategy::intersection::with_statistics, e.g. wrapped with other wrappers
+inline overlay_statistics* statistics_of(statistics_strategy_base const* strategy)
+{
+    return boost::addressof(strategy->get_statistics());
+}
+
+inline overlay_statistics* statistics_of(void const* )
+{
+    return 0;
+}
+
+// Returns the statistics of the strategy, 0 for all of the strategies
+// not wrapped with strategy::intersection::with_statistics
+template <typename Strategy>
+inline overlay_statistics* strategy_statistics(Strategy const& strategy)
+{
+    return statistics_of(boost::addressof(strategy));
+}
+
+// Counts the operation and, when destroyed, adds the bytes taken from the
+// arena of the strategy. Should be created after the arena release_guard.
+template <typename Strategy, bool HasArena = detail::arena::has_arena<Strategy>::value>
+class operation_recorder
+    : boost::noncopyable
+{
+public :
+    explicit operation_recorder(Strategy const& strategy)
+        : m_statistics(strategy_statistics(strategy))
+        , m_strategy(strategy)
+    {
+        if (m_statistics != 0)
+        {
+            m_statistics->calls++;
+        }
+    }
+
+    ~operation_recorder()
+    {
+        if (m_statistics != 0)
+        {
+            m_statistics->allocated_bytes += allocated_bytes(m_strategy,
+                        boost::integral_constant<bool, HasArena>());
+        }
+    }
+
+private :
+    static inline std::size_t allocated_bytes(Strategy const& strategy,
+                                              boost::true_type)
+    {
+        return strategy.get_arena().allocated_bytes();
+    }
+
+    static inline std::size_t allocated_bytes(Strategy const& , boost::false_type)
+    {
+        return 0;
+    }
+
+    overlay_statistics* m_statistics;
+    Strategy const& m_strategy;
+};
+
+}} // namespace detail::statistics
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_STRATEGIES_WITH_STATISTICS_HPP
@@ -0,0 +1,282 @@
+// Boost.Geometry
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_UTIL_MONOTONIC_ARENA_HPP
+#define BOOST_GEOMETRY_UTIL_MONOTONIC_ARENA_HPP
+
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+
+#include <boost/core/noncopyable.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+/*!
+\brief Monotonic memory arena for the temporary containers of algorithms
+\ingroup utility
+\details Memory is taken from blocks allocated with operator new and is
+    not returned until release() is called or the arena is destroyed. The
+    algorithms using the arena, e.g. overlay passed a strategy wrapped with
+    strategy::intersection::with_arena, release it when they finish. The
+    last, largest block is kept so subsequent operations using the same
+    arena don't allocate again unless they need more memory.
+\note The arena may be used by one operation at a time.
+*/
+class monotonic_arena
+    : boost::noncopyable
+{
+    struct block
+    {
+        block* previous;
+        std::size_t size;
+    };
+
+public :
+    /*!
+    \brief The constructor.
+    \param block_size The size in bytes of the first block allocated.
+        The subsequent blocks are two times bigger than the previous ones.
+        Default: 64KiB.
+    */
+    explicit monotonic_arena(std::size_t block_size = 64 * 1024)
+        : m_last(0)
+        , m_current(0)
+        , m_end(0)
+        , m_next_block_size(block_size > 0 ? block_size : 1)
+        , m_allocated_bytes(0)
+    {}
+
+    ~monotonic_arena()
+    {
+        free_blocks(0);
+    }
+
+    /*!
+    \brief Returns the memory of the specified size and alignment.
+    */
+    inline void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+        std::size_t const misalignment
+            = reinterpret_cast<std::size_t>(m_current) % alignment;
+        std::size_t const padding = misalignment > 0 ? alignment - misalignment : 0;
+
+        if (m_current == 0
+            || bytes + padding > static_cast<std::size_t>(m_end - m_current))
+        {
+            add_block(bytes + alignment);
+            return allocate(bytes, alignment);
+        }
+
+        char* result = m_current + padding;
+        m_current = result + bytes;
+        m_allocated_bytes += bytes;
+        return result;
+    }
+
+    /*!
+    \brief Releases the memory of all of the allocations at once.
+    \details The last block is kept and reused by the subsequent allocations.
+    */
+    inline void release()
+    {
+        free_blocks(m_last);
+        if (m_last != 0)
+        {
+            m_last->previous = 0;
+            m_current = block_begin(m_last);
+            m_end = block_begin(m_last) + m_last->size;
+        }
+        m_allocated_bytes = 0;
+    }
+
+    /*!
+    \brief Returns the number of bytes allocated since the last release().
+    */
+    inline std::size_t allocated_bytes() const
+    {
+        return m_allocated_bytes;
+    }
+
+private :
+    static inline char* block_begin(block* b)
+    {
+        return reinterpret_cast<char*>(b) + header_size();
+    }
+
+    static inline std::size_t header_size()
+    {
+        // Keep the memory after the header aligned as the memory from new
+        std::size_t const a = boost::alignment_of<long double>::value;
+        return (sizeof(block) + a - 1) / a * a;
+    }
+
+    inline void add_block(std::size_t min_size)
+    {
+        std::size_t size = m_next_block_size;
+        while (size < min_size)
+        {
+            size *= 2;
+        }
+
+        block* b = static_cast<block*>(::operator new(header_size() + size));
+        b->previous = m_last;
+        b->size = size;
+        m_last = b;
+        m_current = block_begin(b);
+        m_end = m_current + size;
+        m_next_block_size = size * 2;
+    }
+
+    // Frees all blocks except keep
+    inline void free_blocks(block* keep)
+    {
+        block* b = m_last;
+        while (b != 0)
+        {
+            block* previous = b->previous;
+            if (b != keep)
+            {
+                ::operator delete(b);
+            }
+            b = previous;
+        }
+        if (keep == 0)
+        {
+            m_last = 0;
+            m_current = 0;
+            m_end = 0;
+        }
+    }
+
+    block* m_last;
+    char* m_current;
+    char* m_end;
+    std::size_t m_next_block_size;
+    std::size_t m_allocated_bytes;
+};
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail
+{
+
+// Allocator taking the memory from the monotonic_arena or from operator new
+// if it's default-constructed, e.g. by containers created in other threads
+template <typename T>
+class arena_allocator
+{
+public :
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T const* const_pointer;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef arena_allocator<U> other;
+    };
+
+    arena_allocator()
+        : m_arena(0)
+    {}
+
+    explicit arena_allocator(monotonic_arena* arena)
+        : m_arena(arena)
+    {}
+
+    template <typename U>
+    arena_allocator(arena_allocator<U> const& other)
+        : m_arena(other.arena())
+    {}
+
+    inline pointer allocate(size_type n, void const* = 0)
+    {
+        if (m_arena != 0)
+        {
+            return static_cast<pointer>(m_arena->allocate(n * sizeof(T),
+                                            boost::alignment_of<T>::value));
+        }
+        return static_cast<pointer>(::operator new(n * sizeof(T)));
+    }
+
+    inline void deallocate(pointer p, size_type )
+    {
+        if (m_arena == 0)
+        {
+            ::operator delete(p);
+        }
+    }
+
+    inline size_type max_size() const
+    {
+        return (std::numeric_limits<size_type>::max)() / sizeof(T);
+    }
+
+    inline pointer address(reference r) const { return &r; }
+    inline const_pointer address(const_reference r) const { return &r; }
+
+    inline void construct(pointer p, T const& value)
+    {
+        new (static_cast<void*>(p)) T(value);
+    }
+
+    inline void destroy(pointer p)
+    {
+        p->~T();
+    }
+
+    inline monotonic_arena* arena() const
+    {
+        return m_arena;
+    }
+
+private :
+    monotonic_arena* m_arena;
+};
+
+template <typename T, typename U>
+inline bool operator==(arena_allocator<T> const& a, arena_allocator<U> const& b)
+{
+    return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+inline bool operator!=(arena_allocator<T> const& a, arena_allocator<U> const& b)
+{
+    return a.arena() != b.arena();
+}
+
+// Allocator of T using the same memory as Allocator
+template <typename Allocator, typename T>
+struct rebind_allocator
+{
+    typedef typename Allocator::template rebind<T>::other type;
+};
+
+template <typename U, typename T>
+struct rebind_allocator<std::allocator<U>, T>
+{
+    typedef std::allocator<T> type;
+};
+
+} // namespace detail
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_UTIL_MONOTONIC_ARENA_HPP
@@ -0,0 +1,197 @@
+// Boost.Geometry
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_UTIL_OVERLAY_STATISTICS_HPP
+#define BOOST_GEOMETRY_UTIL_OVERLAY_STATISTICS_HPP
+
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+#include <boost/core/noncopyable.hpp>
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+#include <chrono>
+#else
+#include <ctime>
+#endif
+
+
+namespace boost { namespace geometry
+{
+
+/*!
+\brief Timings and counters of the phases of overlay
+\ingroup utility
+\details Filled by the set operations (intersection, union_, difference)
+    of areal geometries passed a strategy wrapped with
+    strategy::intersection::with_statistics. The values are accumulated
+    over all of the operations using the same object until reset() is
+    called. The times are measured in the calling thread, in seconds,
+    with a steady clock if the standard library provides it and with the
+    processor time otherwise. Nested phases are not included in the time
+    of the enclosing phase, e.g. the time of get_turns doesn't contain
+    the time of sectionalize.
+\note The object may be used by one operation at a time.
+*/
+struct overlay_statistics
+{
+    enum phase
+    {
+        phase_sectionalize,
+        phase_get_turns,
+        phase_handle_colocations,
+        phase_enrich,
+        phase_traverse,
+        phase_assign_parents,
+        phase_add_rings,
+        phase_count
+    };
+
+    overlay_statistics()
+    {
+        reset();
+    }
+
+    /*!
+    \brief Sets all of the times and counters to zero.
+    */
+    inline void reset()
+    {
+        for (std::size_t i = 0; i < phase_count; i++)
+        {
+            seconds[i] = 0.0;
+        }
+        calls = 0;
+        turns = 0;
+        discarded_turns = 0;
+        clusters = 0;
+        traversed_rings = 0;
+        allocated_bytes = 0;
+    }
+
+    /*!
+    \brief Returns the sum of the times of all phases.
+    */
+    inline double total_seconds() const
+    {
+        double result = 0.0;
+        for (std::size_t i = 0; i < phase_count; i++)
+        {
+            result += seconds[i];
+        }
+        return result;
+    }
+
+    /*!
+    \brief Returns the name of the phase, e.g. for reports.
+    */
+    static inline char const* phase_name(std::size_t p)
+    {
+        static char const* const names[] =
+            {
+                "sectionalize", "get_turns", "handle_colocations",
+                "enrich", "traverse", "assign_parents", "add_rings"
+            };
+        return p < phase_count ? names[p] : "";
+    }
+
+    //! Time of each of the phases
+    double seconds[phase_count];
+    //! Number of the operations calculated
+    std::size_t calls;
+    //! Number of the turns, including the self-turns
+    std::size_t turns;
+    //! Number of the turns discarded by enrichment
+    std::size_t discarded_turns;
+    //! Number of the clusters of colocated turns
+    std::size_t clusters;
+    //! Number of the rings created by traversal
+    std::size_t traversed_rings;
+    //! Number of the bytes taken from the arena, if the strategy is also
+    //! wrapped with strategy::intersection::with_arena, otherwise 0
+    std::size_t allocated_bytes;
+};
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace statistics
+{
+
+// Returns the current time in seconds, from an unspecified starting point
+inline double clock_seconds()
+{
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    typedef std::chrono::steady_clock clock_type;
+    return std::chrono::duration<double>(
+                clock_type::now().time_since_epoch()).count();
+#else
+    return double(std::clock()) / double(CLOCKS_PER_SEC);
+#endif
+}
+
+// Adds the time from the construction to stop() or the destruction to the
+// phase, minus the time added meanwhile to the nested phase, if any.
+// Does nothing if there are no statistics.
+class phase_timer
+    : boost::noncopyable
+{
+public :
+    phase_timer(overlay_statistics* statistics, std::size_t phase,
+                std::size_t nested_phase = overlay_statistics::phase_count)
+        : m_statistics(statistics)
+        , m_phase(phase)
+        , m_nested_phase(nested_phase)
+        , m_nested_start(0.0)
+        , m_start(0.0)
+    {
+        if (m_statistics != 0)
+        {
+            if (m_nested_phase < overlay_statistics::phase_count)
+            {
+                m_nested_start = m_statistics->seconds[m_nested_phase];
+            }
+            m_start = clock_seconds();
+        }
+    }
+
+    ~phase_timer()
+    {
+        stop();
+    }
+
+    inline void stop()
+    {
+        if (m_statistics == 0)
+        {
+            return;
+        }
+
+        double elapsed = clock_seconds() - m_start;
+        if (m_nested_phase < overlay_statistics::phase_count)
+        {
+            elapsed -= m_statistics->seconds[m_nested_phase] - m_nested_start;
+        }
+        m_statistics->seconds[m_phase] += elapsed;
+        m_statistics = 0;
+    }
+
+private :
+    overlay_statistics* m_statistics;
+    std::size_t m_phase;
+    std::size_t m_nested_phase;
+    double m_nested_start;
+    double m_start;
+};
+
+}} // namespace detail::statistics
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_UTIL_OVERLAY_STATISTICS_HPP
@@ -0,0 +1,233 @@
+// Boost.Geometry
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_UTIL_PARALLEL_HPP
+#define BOOST_GEOMETRY_UTIL_PARALLEL_HPP
+
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+#include <boost/core/ignore_unused.hpp>
+
+
+// Threads are used only if the standard library provides them and the user
+// didn't disable them explicitly by defining BOOST_GEOMETRY_NO_THREADS.
+// Otherwise all of the utilities below execute the work in the calling thread.
+#if ! defined(BOOST_GEOMETRY_NO_THREADS) \
+ && ! defined(BOOST_NO_CXX11_HDR_THREAD) \
+ && ! defined(BOOST_NO_CXX11_HDR_ATOMIC) \
+ && ! defined(BOOST_NO_CXX11_HDR_MUTEX) \
+ && ! defined(BOOST_NO_EXCEPTIONS)
+#define BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+#endif
+
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace parallel
+{
+
+// Returns the number of threads which may be executed concurrently, at least 1
+inline std::size_t hardware_concurrency()
+{
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+    std::size_t const result = std::thread::hardware_concurrency();
+    return result > 0 ? result : 1;
+#else
+    return 1;
+#endif
+}
+
+// Translates the number of threads requested by the user, where 0 means
+// "as many as the hardware supports", into the number of threads to use
+inline std::size_t threads_count(std::size_t requested)
+{
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+    return requested > 0 ? requested : hardware_concurrency();
+#else
+    boost::ignore_unused(requested);
+    return 1;
+#endif
+}
+
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+
+template <typename Function>
+struct invoke_catching
+{
+    invoke_catching(Function & f, std::exception_ptr & e)
+        : function(f), exception(e)
+    {}
+
+    void operator()() const
+    {
+        try
+        {
+            function();
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+    }
+
+    Function & function;
+    std::exception_ptr & exception;
+};
+
+template <typename Function>
+struct for_each_index_worker
+{
+    for_each_index_worker(Function & f, std::size_t c, std::atomic<std::size_t> & n,
+                          std::exception_ptr & e, std::mutex & m)
+        : function(f), count(c), next(n), exception(e), mutex(m)
+    {}
+
+    void operator()() const
+    {
+        for (std::size_t i = next++ ; i < count ; i = next++)
+        {
+            try
+            {
+                function(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (! exception)
+                {
+                    exception = std::current_exception();
+                }
+                // Stop handing out indexes to all of the workers
+                next = count;
+            }
+        }
+    }
+
+    Function & function;
+    std::size_t count;
+    std::atomic<std::size_t> & next;
+    std::exception_ptr & exception;
+    std::mutex & mutex;
+};
+
+#endif // BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+
+// Calls f1() in a separate thread and f2() in the calling thread and waits
+// for both of them. If any of them throws, the exception is rethrown after
+// both calls are finished, the one thrown by f2() first.
+// If a thread can't be created both functions are called sequentially.
+template <typename Function1, typename Function2>
+inline void invoke(Function1 & f1, Function2 & f2)
+{
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+    std::exception_ptr exception1;
+    std::thread thread;
+    try
+    {
+        thread = std::thread(invoke_catching<Function1>(f1, exception1));
+    }
+    catch (...)
+    {
+        f1();
+        f2();
+        return;
+    }
+
+    std::exception_ptr exception2;
+    invoke_catching<Function2>(f2, exception2)();
+    thread.join();
+
+    if (exception2)
+    {
+        std::rethrow_exception(exception2);
+    }
+    if (exception1)
+    {
+        std::rethrow_exception(exception1);
+    }
+#else
+    f1();
+    f2();
+#endif
+}
+
+// Calls f(i) for each i in [0, count) using at most the specified number
+// of threads, including the calling one. The order in which the indexes are
+// processed is not specified. After the first exception no new indexes are
+// processed and the exception is rethrown when all threads are finished.
+template <typename Function>
+inline void for_each_index(std::size_t count, std::size_t threads, Function & f)
+{
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+    if (threads > count)
+    {
+        threads = count;
+    }
+
+    if (threads > 1)
+    {
+        std::atomic<std::size_t> next(0);
+        std::exception_ptr exception;
+        std::mutex mutex;
+        for_each_index_worker<Function> worker(f, count, next, exception, mutex);
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (std::size_t t = 1 ; t < threads ; ++t)
+        {
+            try
+            {
+                workers.push_back(std::thread(worker));
+            }
+            catch (...)
+            {
+                // Continue with the threads created so far
+                break;
+            }
+        }
+
+        worker();
+
+        for (std::size_t t = 0 ; t < workers.size() ; ++t)
+        {
+            workers[t].join();
+        }
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+        return;
+    }
+#else
+    boost::ignore_unused(threads);
+#endif
+
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        f(i);
+    }
+}
+
+}} // namespace detail::parallel
+#endif // DOXYGEN_NO_DETAIL
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_UTIL_PARALLEL_HPP
@@ -0,0 +1,151 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/foreach.hpp>
+#include <boost/random.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+
+#include <boost/geometry/index/detail/rtree/utilities/statistics.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+
+typedef boost::chrono::steady_clock clock_type;
+typedef boost::chrono::duration<float> dur_type;
+
+template <typename Parameters>
+void test_rtree(std::vector<P> const& values, std::vector<B> const& boxes, std::vector<P> const& points,
+                Parameters const& parameters = Parameters())
+{
+    typedef bgi::rtree<P, Parameters> RT;
+    RT t(parameters);
+
+    {
+        clock_type::time_point start = clock_type::now();
+        BOOST_FOREACH(P const& p, values)
+            t.insert(p);
+        dur_type time = clock_type::now() - start;
+        std::cout << "insert: " << time.count() << std::endl;
+    }
+
+    {
+        clock_type::time_point start = clock_type::now();
+        size_t temp = 0;
+        std::vector<P> result;
+        BOOST_FOREACH(B const& b, boxes)
+        {
+            result.clear();
+            temp += t.query(bgi::intersects(b), std::back_inserter(result));
+        }
+        dur_type time = clock_type::now() - start;
+        std::cout << "spatial query: " << time.count() << " " << temp << std::endl;
+    }
+
+    {
+        clock_type::time_point start = clock_type::now();
+        size_t temp = 0;
+        std::vector<P> result;
+        BOOST_FOREACH(P const& p, points)
+        {
+            result.clear();
+            temp += t.query(bgi::nearest(p, 5), std::back_inserter(result));
+        }
+        dur_type time = clock_type::now() - start;
+        std::cout << "knn query: " << time.count() << " " << temp << std::endl;
+    }
+
+    boost::tuple<size_t, size_t, size_t, size_t, size_t, size_t>
+        stats = bgi::detail::rtree::utilities::statistics(t);
+    std::cout << "levels: " << boost::get<0>(stats)
+              << " nodes: " << boost::get<1>(stats)
+              << " leaves: " << boost::get<2>(stats) << std::endl;
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t clusters_count = 1000;
+    size_t queries_count = 100000;
+
+    std::vector<P> values;
+    std::vector<B> boxes;
+    std::vector<P> points;
+
+    //randomize values
+    {
+        boost::mt19937 rng;
+        boost::uniform_real<double> range(-1000, 1000);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<double> > rnd(rng, range);
+        boost::normal_distribution<double> normal(0, 1);
+        boost::variate_generator<boost::mt19937&, boost::normal_distribution<double> > rnd_normal(rng, normal);
+
+        values.reserve(values_count);
+
+        std::cout << "randomizing data\n";
+        // e.g. GPS positions, dense clusters around the cities and along the tracks
+        std::vector<P> centers;
+        for ( size_t i = 0 ; i < clusters_count ; ++i )
+            centers.push_back(P(rnd(), rnd()));
+
+        for ( size_t i = 0 ; i < values_count / 2 ; ++i )
+        {
+            P const& c = centers[i % clusters_count];
+            double const sigma = 0.5 + double(i % 7);
+            values.push_back(P(bg::get<0>(c) + rnd_normal() * sigma, bg::get<1>(c) + rnd_normal() * sigma));
+        }
+        for ( size_t i = values_count / 2 ; i < values_count ; )
+        {
+            P const& c1 = centers[(i / 1000) % clusters_count];
+            P const& c2 = centers[(i / 1000 + 1) % clusters_count];
+            for ( size_t j = 0 ; j < 1000 && i < values_count ; ++j, ++i )
+            {
+                double const f = double(j) / 1000;
+                values.push_back(P(bg::get<0>(c1) * (1 - f) + bg::get<0>(c2) * f + rnd_normal() * 0.05,
+                                   bg::get<1>(c1) * (1 - f) + bg::get<1>(c2) * f + rnd_normal() * 0.05));
+            }
+        }
+
+        // the queries near the data
+        for ( size_t i = 0 ; i < queries_count ; ++i )
+        {
+            P const& v = values[(i * 7919) % values_count];
+            double const x = bg::get<0>(v) + rnd_normal();
+            double const y = bg::get<1>(v) + rnd_normal();
+            boxes.push_back(B(P(x - 1, y - 1), P(x + 1, y + 1)));
+            points.push_back(P(x, y));
+        }
+        std::cout << "randomized\n";
+    }
+
+    std::cout << "------------------------------------------------\n";
+    std::cout << "linear<16, 4>\n";
+    test_rtree< bgi::linear<16, 4> >(values, boxes, points);
+    std::cout << "------------------------------------------------\n";
+    std::cout << "quadratic<16, 4>\n";
+    test_rtree< bgi::quadratic<16, 4> >(values, boxes, points);
+    std::cout << "------------------------------------------------\n";
+    std::cout << "rstar<16, 4>\n";
+    test_rtree< bgi::rstar<16, 4> >(values, boxes, points);
+    std::cout << "------------------------------------------------\n";
+    std::cout << "kmeans<16, 4>\n";
+    test_rtree< bgi::kmeans<16, 4> >(values, boxes, points);
+    std::cout << "------------------------------------------------\n";
+    std::cout << "dynamic_kmeans(16, 4)\n";
+    test_rtree(values, boxes, points, bgi::dynamic_kmeans(16, 4));
+
+    return 0;
+}
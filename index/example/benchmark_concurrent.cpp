@@ -0,0 +1,168 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <vector>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/index/concurrent_rtree.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+typedef bgi::rtree<B, bgi::rstar<16, 4> > RT;
+typedef bgi::concurrent_rtree<B, bgi::rstar<16, 4> > CRT;
+
+typedef boost::chrono::steady_clock clock_type;
+typedef boost::chrono::duration<float> dur_type;
+
+// The rtree guarded by a mutex, the readers wait for the writer and for each other
+struct locked_rtree
+{
+    explicit locked_rtree(std::vector<B> const& v) : tree(v) {}
+
+    template <typename Range>
+    void insert(Range const& r) { std::lock_guard<std::mutex> l(mutex); tree.insert(r); }
+    template <typename Range>
+    void remove(Range const& r) { std::lock_guard<std::mutex> l(mutex); tree.remove(r); }
+    size_t query(B const& b, std::vector<B> & result)
+    {
+        std::lock_guard<std::mutex> l(mutex);
+        return tree.query(bgi::intersects(b), std::back_inserter(result));
+    }
+
+    RT tree;
+    std::mutex mutex;
+};
+
+struct concurrent_wrapper
+{
+    explicit concurrent_wrapper(std::vector<B> const& v) : tree(v) {}
+
+    template <typename Range>
+    void insert(Range const& r) { tree.insert(r); }
+    template <typename Range>
+    void remove(Range const& r) { tree.remove(r); }
+    size_t query(B const& b, std::vector<B> & result)
+    {
+        return tree.query(bgi::intersects(b), std::back_inserter(result));
+    }
+
+    CRT tree;
+};
+
+template <typename Tree>
+void test_tree(std::vector<B> const& values, std::vector<B> const& updates,
+               std::vector<B> const& queries, size_t readers_count)
+{
+    Tree t(values);
+
+    std::atomic<bool> done(false);
+    std::atomic<size_t> queries_done(0);
+    std::atomic<size_t> found(0);
+
+    clock_type::time_point start = clock_type::now();
+
+    std::vector<std::thread> readers;
+    for ( size_t r = 0 ; r < readers_count ; ++r )
+    {
+        readers.push_back(std::thread([&, r]()
+        {
+            std::vector<B> result;
+            for ( size_t i = r ; !done.load() ; i = (i + readers_count) % queries.size() )
+            {
+                result.clear();
+                found += t.query(queries[i], result);
+                ++queries_done;
+            }
+        }));
+    }
+
+    // the writer applies the updates in small batches
+    dur_type max_write(0);
+    for ( size_t i = 0 ; i + 10 <= updates.size() ; i += 10 )
+    {
+        std::vector<B> batch(updates.begin() + i, updates.begin() + i + 10);
+        clock_type::time_point write_start = clock_type::now();
+        t.insert(batch);
+        if ( i % 20 == 0 )
+            t.remove(batch);
+        dur_type write_time = clock_type::now() - write_start;
+        if ( max_write < write_time )
+            max_write = write_time;
+    }
+
+    done = true;
+    for ( size_t r = 0 ; r < readers.size() ; ++r )
+        readers[r].join();
+
+    dur_type time = clock_type::now() - start;
+    std::cout << "readers: " << readers_count
+              << " time: " << time.count()
+              << " queries/s: " << float(queries_done.load()) / time.count()
+              << " max write: " << max_write.count()
+              << " found: " << found.load() << std::endl;
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t updates_count = 20000;
+    size_t queries_count = 100000;
+
+    std::vector<B> values, updates, queries;
+
+    //randomize values
+    {
+        boost::mt19937 rng;
+        boost::uniform_real<double> range(-1000, 1000);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<double> > rnd(rng, range);
+
+        std::cout << "randomizing data\n";
+        for ( size_t i = 0 ; i < values_count ; ++i )
+        {
+            double x = rnd(), y = rnd();
+            values.push_back(B(P(x - 0.5, y - 0.5), P(x + 0.5, y + 0.5)));
+        }
+        for ( size_t i = 0 ; i < updates_count ; ++i )
+        {
+            double x = rnd(), y = rnd();
+            updates.push_back(B(P(x - 0.5, y - 0.5), P(x + 0.5, y + 0.5)));
+        }
+        for ( size_t i = 0 ; i < queries_count ; ++i )
+        {
+            double x = rnd(), y = rnd();
+            queries.push_back(B(P(x - 5, y - 5), P(x + 5, y + 5)));
+        }
+        std::cout << "randomized\n";
+    }
+
+    size_t const threads = std::thread::hardware_concurrency() > 1
+                         ? std::thread::hardware_concurrency() - 1 : 1;
+
+    std::cout << "------------------------------------------------\n";
+    std::cout << "rtree + mutex\n";
+    test_tree<locked_rtree>(values, updates, queries, 1);
+    test_tree<locked_rtree>(values, updates, queries, threads);
+    std::cout << "------------------------------------------------\n";
+    std::cout << "concurrent_rtree\n";
+    test_tree<concurrent_wrapper>(values, updates, queries, 1);
+    test_tree<concurrent_wrapper>(values, updates, queries, threads);
+
+    return 0;
+}
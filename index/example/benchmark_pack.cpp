@@ -0,0 +1,133 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+
+typedef boost::chrono::steady_clock clock_type;
+typedef boost::chrono::duration<float> dur_type;
+
+template <typename RT, typename Values>
+void test_queries(RT const& t, Values const& values, size_t queries_count)
+{
+    std::vector<B> result;
+    result.reserve(100);
+
+    clock_type::time_point start = clock_type::now();
+    size_t temp = 0;
+    for (size_t i = 0 ; i < queries_count ; ++i )
+    {
+        P const& c = values[i].min_corner();
+        double x = bg::get<0>(c);
+        double y = bg::get<1>(c);
+        result.clear();
+        t.query(bgi::intersects(B(P(x - 10, y - 10), P(x + 10, y + 10))), std::back_inserter(result));
+        temp += result.size();
+    }
+    dur_type time = clock_type::now() - start;
+    std::cout << time.count() << " " << temp << " ";
+}
+
+template <typename Parameters>
+void test_pack(std::vector<B> const& values, size_t queries_count)
+{
+    typedef bgi::rtree<B, Parameters> RT;
+
+    size_t const threads[] = { 2, 4, 8, 0 };
+
+    std::cout << "serial: ";
+    {
+        clock_type::time_point start = clock_type::now();
+        RT t(values.begin(), values.end());
+        dur_type time = clock_type::now() - start;
+        std::cout << time.count() << " ";
+
+        test_queries(t, values, queries_count);
+    }
+    std::cout << std::endl;
+
+    for ( size_t i = 0 ; i < sizeof(threads) / sizeof(threads[0]) ; ++i )
+    {
+        bgi::parallel_packing packing(threads[i]);
+
+        std::cout << "parallel(" << packing.get_threads() << "): ";
+        {
+            clock_type::time_point start = clock_type::now();
+            RT t(values.begin(), values.end(), packing);
+            dur_type time = clock_type::now() - start;
+            std::cout << time.count() << " ";
+
+            test_queries(t, values, queries_count);
+        }
+        std::cout << std::endl;
+    }
+
+    bgi::packing_curve const curves[] = { bgi::hilbert_curve, bgi::z_order_curve };
+    char const* const curves_names[] = { "hilbert", "z_order" };
+    for ( size_t i = 0 ; i < sizeof(curves) / sizeof(curves[0]) ; ++i )
+    {
+        std::cout << curves_names[i] << ": ";
+        {
+            clock_type::time_point start = clock_type::now();
+            RT t(values.begin(), values.end(), bgi::curve_packing(curves[i]));
+            dur_type time = clock_type::now() - start;
+            std::cout << time.count() << " ";
+
+            test_queries(t, values, queries_count);
+        }
+        std::cout << std::endl;
+    }
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t queries_count = 100000;
+
+    std::vector<B> values;
+
+    //randomize values
+    {
+        boost::mt19937 rng;
+        float max_val = static_cast<float>(values_count / 2);
+        boost::uniform_real<float> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+
+        values.reserve(values_count);
+
+        std::cout << "randomizing data\n";
+        for ( size_t i = 0 ; i < values_count ; ++i )
+        {
+            double x = rnd();
+            double y = rnd();
+            values.push_back(B(P(x - 0.5, y - 0.5), P(x + 0.5, y + 0.5)));
+        }
+        std::cout << "randomized\n";
+    }
+
+    std::cout << "------------------------------------------------\n";
+    std::cout << "linear<16, 4>\n";
+    test_pack< bgi::linear<16, 4> >(values, queries_count);
+    std::cout << "------------------------------------------------\n";
+    std::cout << "rstar<16, 4>\n";
+    test_pack< bgi::rstar<16, 4> >(values, queries_count);
+
+    return 0;
+}
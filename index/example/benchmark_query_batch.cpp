@@ -0,0 +1,132 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+typedef bgi::detail::predicates::nearest<P> N;
+typedef std::back_insert_iterator<std::vector<B> > O;
+
+typedef boost::chrono::steady_clock clock_type;
+typedef boost::chrono::duration<float> dur_type;
+
+template <typename RT>
+void test_loop(RT const& t, std::vector<N> const& queries)
+{
+    std::vector<std::vector<B> > results(queries.size());
+
+    clock_type::time_point start = clock_type::now();
+    size_t temp = 0;
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        temp += t.query(queries[i], std::back_inserter(results[i]));
+    }
+    dur_type time = clock_type::now() - start;
+    std::cout << "loop: " << time.count() << " " << temp << std::endl;
+}
+
+template <typename RT>
+void test_batch(RT const& t, std::vector<N> const& queries, bgi::batch_query const& batch)
+{
+    std::vector<std::vector<B> > results(queries.size());
+    std::vector<O> out_its;
+    out_its.reserve(queries.size());
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+        out_its.push_back(std::back_inserter(results[i]));
+
+    clock_type::time_point start = clock_type::now();
+    size_t temp = t.query_batch(queries, out_its, batch);
+    dur_type time = clock_type::now() - start;
+    std::cout << "batch(" << batch.get_threads() << "): "
+              << time.count() << " " << temp << std::endl;
+}
+
+template <typename Parameters>
+void test_rtree(std::vector<B> const& values, std::vector<N> const& queries)
+{
+    typedef bgi::rtree<B, Parameters> RT;
+    RT t(values.begin(), values.end());
+
+    test_loop(t, queries);
+
+    size_t const threads[] = { 1, 2, 4, 0 };
+    for ( size_t i = 0 ; i < sizeof(threads) / sizeof(threads[0]) ; ++i )
+        test_batch(t, queries, bgi::batch_query(threads[i]));
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t queries_count = 200000;
+    unsigned k = 5;
+
+    std::vector<B> values;
+    std::vector<N> queries;
+    std::vector<N> track_queries;
+
+    //randomize values
+    {
+        boost::mt19937 rng;
+        float max_val = static_cast<float>(values_count / 2);
+        boost::uniform_real<float> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+
+        values.reserve(values_count);
+
+        std::cout << "randomizing data\n";
+        for ( size_t i = 0 ; i < values_count ; ++i )
+        {
+            double x = rnd();
+            double y = rnd();
+            values.push_back(B(P(x - 0.5, y - 0.5), P(x + 0.5, y + 0.5)));
+        }
+        for ( size_t i = 0 ; i < queries_count ; ++i )
+        {
+            double x = rnd();
+            double y = rnd();
+            queries.push_back(bgi::nearest(P(x, y), k));
+        }
+        // points of tracks, e.g. GPS positions, much denser than the values
+        for ( size_t i = 0 ; i < queries_count ; )
+        {
+            double x = rnd();
+            double y = rnd();
+            double dx = rnd() / max_val * 50;
+            double dy = rnd() / max_val * 50;
+            for ( size_t j = 0 ; j < 1000 && i < queries_count ; ++j, ++i )
+            {
+                track_queries.push_back(bgi::nearest(P(x + j * dx, y + j * dy), k));
+            }
+        }
+        std::cout << "randomized\n";
+    }
+
+    std::cout << "------------------------------------------------\n";
+    std::cout << "linear<16, 4> random\n";
+    test_rtree< bgi::linear<16, 4> >(values, queries);
+    std::cout << "------------------------------------------------\n";
+    std::cout << "rstar<16, 4> random\n";
+    test_rtree< bgi::rstar<16, 4> >(values, queries);
+    std::cout << "------------------------------------------------\n";
+    std::cout << "rstar<16, 4> tracks\n";
+    test_rtree< bgi::rstar<16, 4> >(values, track_queries);
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+
+typedef boost::chrono::steady_clock clock_type;
+typedef boost::chrono::duration<float> dur_type;
+
+template <typename RT>
+void test_loop(RT const& t1, RT const& t2)
+{
+    std::vector<std::pair<B, B> > result;
+    std::vector<B> found;
+
+    clock_type::time_point start = clock_type::now();
+    for ( typename RT::const_iterator it = t1.begin() ; it != t1.end() ; ++it )
+    {
+        found.clear();
+        t2.query(bgi::intersects(*it), std::back_inserter(found));
+        for ( size_t i = 0 ; i < found.size() ; ++i )
+            result.push_back(std::make_pair(*it, found[i]));
+    }
+    dur_type time = clock_type::now() - start;
+    std::cout << "loop: " << time.count() << " " << result.size() << std::endl;
+}
+
+template <typename RT>
+void test_join(RT const& t1, RT const& t2)
+{
+    std::vector<std::pair<B, B> > result;
+
+    clock_type::time_point start = clock_type::now();
+    size_t temp = bgi::spatial_join(t1, t2, bgi::intersects(), std::back_inserter(result));
+    dur_type time = clock_type::now() - start;
+    std::cout << "join: " << time.count() << " " << temp << std::endl;
+}
+
+template <typename RT>
+void test_join(RT const& t1, RT const& t2, bgi::parallel_join const& parallel)
+{
+    std::vector<std::pair<B, B> > result;
+
+    clock_type::time_point start = clock_type::now();
+    size_t temp = bgi::spatial_join(t1, t2, bgi::intersects(), std::back_inserter(result), parallel);
+    dur_type time = clock_type::now() - start;
+    std::cout << "join(" << parallel.get_threads() << "): "
+              << time.count() << " " << temp << std::endl;
+}
+
+template <typename Parameters>
+void test_rtree(std::vector<B> const& values1, std::vector<B> const& values2)
+{
+    typedef bgi::rtree<B, Parameters> RT;
+    RT t1(values1.begin(), values1.end());
+    RT t2(values2.begin(), values2.end());
+
+    test_loop(t1, t2);
+    test_join(t1, t2);
+
+    size_t const threads[] = { 1, 2, 4, 0 };
+    for ( size_t i = 0 ; i < sizeof(threads) / sizeof(threads[0]) ; ++i )
+        test_join(t1, t2, bgi::parallel_join(threads[i]));
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+
+    std::vector<B> parcels;
+    std::vector<B> zones;
+
+    //randomize values
+    {
+        boost::mt19937 rng;
+        float max_val = static_cast<float>(values_count / 100);
+        boost::uniform_real<float> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+
+        parcels.reserve(values_count);
+        zones.reserve(values_count);
+
+        std::cout << "randomizing data\n";
+        // e.g. parcels and flood zones
+        for ( size_t i = 0 ; i < values_count ; ++i )
+        {
+            double x = rnd();
+            double y = rnd();
+            parcels.push_back(B(P(x - 0.5, y - 0.5), P(x + 0.5, y + 0.5)));
+        }
+        for ( size_t i = 0 ; i < values_count ; ++i )
+        {
+            double x = rnd();
+            double y = rnd();
+            zones.push_back(B(P(x - 2, y - 2), P(x + 2, y + 2)));
+        }
+        std::cout << "randomized\n";
+    }
+
+    std::cout << "------------------------------------------------\n";
+    std::cout << "linear<16, 4>\n";
+    test_rtree< bgi::linear<16, 4> >(zones, parcels);
+    std::cout << "------------------------------------------------\n";
+    std::cout << "rstar<16, 4>\n";
+    test_rtree< bgi::rstar<16, 4> >(zones, parcels);
+    std::cout << "------------------------------------------------\n";
+    std::cout << "quadratic<64, 16>\n";
+    test_rtree< bgi::quadratic<64, 16> >(zones, parcels);
+
+    return 0;
+}
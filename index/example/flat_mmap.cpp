@@ -0,0 +1,101 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/index/flat_rtree.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+int main()
+{
+    namespace bg = boost::geometry;
+    namespace bgi = bg::index;
+    namespace bip = boost::interprocess;
+
+    typedef boost::chrono::thread_clock clock_type;
+    typedef boost::chrono::duration<float> dur_type;
+
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+    typedef bg::model::box<P> B;
+    typedef std::pair<P, unsigned> V;
+    typedef bgi::rtree<V, bgi::rstar<16, 4> > RT;
+    typedef bgi::flat_rtree<V, bgi::rstar<16, 4> > FRT;
+
+    char const* const filename = "flat_mmap.bin";
+    std::size_t const values_count = 1000000;
+    std::size_t const queries_count = 100000;
+
+    // values and queries
+    boost::mt19937 rng;
+    boost::uniform_real<double> range(-1000, 1000);
+    boost::variate_generator<boost::mt19937&, boost::uniform_real<double> > rnd(rng, range);
+
+    std::vector<V> values;
+    for ( std::size_t i = 0 ; i < values_count ; ++i )
+        values.push_back(V(P(rnd(), rnd()), static_cast<unsigned>(i)));
+
+    std::vector<B> boxes;
+    for ( std::size_t i = 0 ; i < queries_count ; ++i )
+    {
+        double x = rnd(), y = rnd();
+        boxes.push_back(B(P(x - 5, y - 5), P(x + 5, y + 5)));
+    }
+
+    // build the rtree and store it in a file
+    {
+        clock_type::time_point start = clock_type::now();
+        RT t(values);
+        std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+        bgi::write_flat(t, ofs);
+        dur_type time = clock_type::now() - start;
+        std::cout << time << " - build and write " << bgi::flat_size(t) << " bytes" << std::endl;
+    }
+
+    // map the file and query the tree directly
+    {
+        clock_type::time_point start = clock_type::now();
+        bip::file_mapping file(filename, bip::read_only);
+        bip::mapped_region region(file, bip::read_only);
+        FRT t(region.get_address(), region.get_size());
+        dur_type time = clock_type::now() - start;
+        std::cout << time << " - map " << t.size() << " values" << std::endl;
+
+        start = clock_type::now();
+        std::size_t found = 0;
+        std::vector<V> result;
+        for ( std::size_t i = 0 ; i < queries_count ; ++i )
+        {
+            result.clear();
+            found += t.query(bgi::intersects(boxes[i]), std::back_inserter(result));
+        }
+        time = clock_type::now() - start;
+        std::cout << time << " - query(B) " << queries_count << " found " << found << std::endl;
+
+        start = clock_type::now();
+        found = 0;
+        for ( std::size_t i = 0 ; i < queries_count / 10 ; ++i )
+        {
+            result.clear();
+            found += t.query(bgi::nearest(boxes[i].min_corner(), 5), std::back_inserter(result));
+        }
+        time = clock_type::now() - start;
+        std::cout << time << " - query(nearest(P, 5)) " << queries_count / 10 << " found " << found << std::endl;
+    }
+
+    bip::file_mapping::remove(filename);
+
+    return 0;
+}
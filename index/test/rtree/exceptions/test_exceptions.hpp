@@ -55,6 +55,14 @@ void test_rtree_value_exceptions(Parameters const& parameters = Parameters())
         BOOST_CHECK_THROW( Tree tree(input.begin(), input.end(), parameters), throwing_value_copy_exception );
     }
 
+    for ( size_t i = 0 ; i < 20 ; i += 1 )
+    {
+        throwing_value::reset_calls_counter();
+        throwing_value::set_max_calls(i);
+
+        BOOST_CHECK_THROW( Tree tree(input.begin(), input.end(), bgi::curve_packing(), parameters), throwing_value_copy_exception );
+    }
+
     for ( size_t i = 0 ; i < 10 ; i += 1 )
     {
         throwing_value::reset_calls_counter();
@@ -142,6 +150,19 @@ void test_rtree_elements_exceptions(Parameters const& parameters = Parameters())
         BOOST_CHECK_EQUAL(throwing_nodes_stats::internal_nodes_count(), 0u);
         BOOST_CHECK_EQUAL(throwing_nodes_stats::leafs_count(), 0u);
     }
+
+    for ( size_t i = 0 ; i < 100 ; i += 2 )
+    {
+        throwing_varray_settings::reset_calls_counter();
+        throwing_varray_settings::set_max_calls(i);
+
+        throwing_nodes_stats::reset_counters();
+
+        BOOST_CHECK_THROW( Tree tree(input.begin(), input.end(), bgi::curve_packing(), parameters), throwing_varray_exception );
+
+        BOOST_CHECK_EQUAL(throwing_nodes_stats::internal_nodes_count(), 0u);
+        BOOST_CHECK_EQUAL(throwing_nodes_stats::leafs_count(), 0u);
+    }
     
     for ( size_t i = 0 ; i < 50 ; i += 2 )
     {
@@ -0,0 +1,204 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <vector>
+
+#include <boost/geometry/index/concurrent_rtree.hpp>
+
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+#include <atomic>
+#include <thread>
+#endif
+
+template <typename Value, typename Params>
+void test_concurrent_values(int size, Params const& params = Params())
+{
+    typedef bgi::concurrent_rtree<Value, Params> concurrent_type;
+    typedef typename concurrent_type::rtree_type rtree_type;
+    typedef typename rtree_type::bounds_type box_type;
+
+    std::vector<Value> input;
+    box_type qbox;
+    generate::input<bg::dimension<box_type>::value>::apply(input, qbox, size);
+
+    concurrent_type ct(params);
+    rtree_type rt(params);
+
+    BOOST_CHECK(ct.empty());
+
+    // insert
+    std::size_t const half = input.size() / 2;
+    for ( std::size_t i = 0 ; i < half ; ++i )
+    {
+        ct.insert(input[i]);
+        rt.insert(input[i]);
+    }
+    ct.insert(input.begin() + half, input.end());
+    rt.insert(input.begin() + half, input.end());
+
+    BOOST_CHECK(ct.size() == rt.size());
+    BOOST_CHECK(bg::equals(ct.bounds(), rt.bounds()));
+    BOOST_CHECK(ct.count(input[0]) == rt.count(input[0]));
+
+    std::vector<Value> expected;
+    rt.query(bgi::intersects(qbox), std::back_inserter(expected));
+    {
+        std::vector<Value> output;
+        ct.query(bgi::intersects(qbox), std::back_inserter(output));
+        basictest::compare_outputs(rt, output, expected);
+    }
+
+    // query iterators of the snapshot
+    {
+        typename concurrent_type::snapshot s(ct);
+        std::vector<Value> output;
+        for ( typename rtree_type::const_query_iterator it = s->qbegin(bgi::intersects(qbox)) ;
+              it != s->qend() ; ++it )
+            output.push_back(*it);
+        basictest::compare_outputs(rt, output, expected);
+        BOOST_CHECK((*s).size() == rt.size());
+    }
+
+    // both instances are equal after each modification
+    {
+        typename concurrent_type::snapshot s(ct);
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_levels_ok(*s));
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(*s));
+    }
+
+    // remove
+    std::vector<Value> removed(input.begin(), input.begin() + half);
+    BOOST_CHECK(ct.remove(removed) == rt.remove(removed));
+    if ( half < input.size() )
+    {
+        BOOST_CHECK(ct.remove(input[half]) == rt.remove(input[half]));
+        BOOST_CHECK(ct.remove(input[half]) == 0);
+        rt.remove(input[half]);
+    }
+    for ( int i = 0 ; i < 2 ; ++i )
+    {
+        // check both instances
+        BOOST_CHECK(ct.size() == rt.size());
+        std::vector<Value> output, expected_rem;
+        ct.query(bgi::intersects(qbox), std::back_inserter(output));
+        rt.query(bgi::intersects(qbox), std::back_inserter(expected_rem));
+        basictest::compare_outputs(rt, output, expected_rem);
+        ct.insert(std::vector<Value>());
+    }
+
+    // packing
+    concurrent_type ctp(input, params);
+    BOOST_CHECK(ctp.size() == input.size());
+    ctp.clear();
+    BOOST_CHECK(ctp.empty());
+    ctp.insert(input[0]);
+    BOOST_CHECK(ctp.size() == 1);
+
+    ct.clear();
+    BOOST_CHECK(ct.empty());
+    BOOST_CHECK(ct.size() == 0);
+}
+
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+
+// The writer inserts and removes pairs of values, the readers check if they
+// see the state before or after the modification, never in between
+template <typename Params>
+void test_concurrent_readers(Params const& params = Params())
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+    typedef bg::model::box<P> B;
+    typedef bgi::concurrent_rtree<P, Params> concurrent_type;
+
+    std::vector<P> initial;
+    for ( int i = 0 ; i < 100 ; ++i )
+        initial.push_back(P(i, i));
+    concurrent_type ct(initial, params);
+
+    std::atomic<bool> done(false);
+    std::atomic<std::size_t> errors(0);
+    std::atomic<std::size_t> reads(0);
+
+    B const qbox(P(-1000, -1000), P(1000, 1000));
+
+    std::vector<std::thread> readers;
+    for ( int r = 0 ; r < 3 ; ++r )
+    {
+        readers.push_back(std::thread([&]()
+        {
+            while ( !done.load() )
+            {
+                std::this_thread::yield();
+                typename concurrent_type::snapshot s(ct);
+                std::size_t const size = s->size();
+                std::vector<P> found;
+                s->query(bgi::intersects(qbox), std::back_inserter(found));
+                std::size_t iterated = 0;
+                for ( typename concurrent_type::rtree_type::const_query_iterator
+                        it = s->qbegin(bgi::intersects(qbox)) ; it != s->qend() ; ++it )
+                    ++iterated;
+                if ( size % 2 != 0 || found.size() != size || iterated != size )
+                    errors.fetch_add(1);
+                reads.fetch_add(1);
+            }
+        }));
+    }
+
+    // wait for the readers to start
+    while ( reads.load() == 0 )
+        std::this_thread::yield();
+
+    for ( int i = 0 ; i < 200 ; ++i )
+    {
+        std::vector<P> pair;
+        pair.push_back(P(200 + i % 50, i));
+        pair.push_back(P(-200 - i % 50, -i));
+        ct.insert(pair);
+        if ( i % 3 != 0 )
+            BOOST_CHECK(ct.remove(pair) == 2);
+    }
+
+    done.store(true);
+    for ( std::size_t r = 0 ; r < readers.size() ; ++r )
+        readers[r].join();
+
+    BOOST_CHECK(errors.load() == 0);
+    BOOST_CHECK(ct.size() == 100 + 2 * 67);
+}
+
+#endif // BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+
+template <typename Params>
+void test_concurrent_params()
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+    typedef bg::model::box<P2> B2;
+    typedef bg::model::point<double, 3, bg::cs::cartesian> P3;
+
+    test_concurrent_values<P2, Params>(10);
+    test_concurrent_values<B2, Params>(10);
+    test_concurrent_values<std::pair<P2, int>, Params>(10);
+    test_concurrent_values<P3, Params>(4);
+
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_THREADS
+    test_concurrent_readers<Params>();
+#endif
+}
+
+int test_main(int, char* [])
+{
+    test_concurrent_params< bgi::linear<4, 2> >();
+    test_concurrent_params< bgi::quadratic<5, 2> >();
+    test_concurrent_params< bgi::rstar<16, 4> >();
+
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+    test_concurrent_values<P2, bgi::dynamic_rstar>(10, bgi::dynamic_rstar(8, 3));
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <sstream>
+#include <vector>
+
+#include <boost/geometry/index/flat_rtree.hpp>
+#include <boost/geometry/index/detail/rtree/utilities/view.hpp>
+
+// The memory block aligned for any of the types used in the test
+struct flat_buffer
+{
+    explicit flat_buffer(std::size_t size)
+        : m_data(size / sizeof(double) + 1)
+    {}
+
+    char * data() { return reinterpret_cast<char*>(&m_data[0]); }
+
+    std::vector<double> m_data;
+};
+
+template <typename Value>
+struct test_equals
+{
+    test_equals(Value const& v, bgi::equal_to<Value> const& eq) : m_v(v), m_eq(eq) {}
+    bool operator()(Value const& v) const { return m_eq(m_v, v); }
+    Value m_v;
+    bgi::equal_to<Value> m_eq;
+};
+
+template <typename Value>
+void check_same_values(std::vector<Value> expected, std::vector<Value> result)
+{
+    BOOST_CHECK(expected.size() == result.size());
+    if ( expected.size() != result.size() )
+        return;
+
+    bgi::equal_to<Value> eq;
+    for ( std::size_t i = 0 ; i < expected.size() ; ++i )
+    {
+        BOOST_CHECK(std::count_if(result.begin(), result.end(), test_equals<Value>(expected[i], eq)) == 1);
+    }
+}
+
+// The nearest values may be different if there are ties so only distances are compared
+template <typename Value, typename Point>
+void check_same_distances(std::vector<Value> const& expected, std::vector<Value> const& result, Point const& pt)
+{
+    BOOST_CHECK(expected.size() == result.size());
+    if ( expected.size() != result.size() )
+        return;
+
+    bgi::indexable<Value> ind;
+    std::vector<double> expected_d, result_d;
+    for ( std::size_t i = 0 ; i < expected.size() ; ++i )
+    {
+        expected_d.push_back(bg::comparable_distance(pt, ind(expected[i])));
+        result_d.push_back(bg::comparable_distance(pt, ind(result[i])));
+    }
+    std::sort(expected_d.begin(), expected_d.end());
+    std::sort(result_d.begin(), result_d.end());
+    BOOST_CHECK(expected_d == result_d);
+}
+
+template <typename FlatRtree, typename Rtree, typename Box>
+void check_queries(FlatRtree const& frt, Rtree const& rt, Box const& qbox)
+{
+    typedef typename Rtree::value_type value_type;
+    typedef typename bg::point_type<Box>::type point_type;
+
+    BOOST_CHECK(frt.size() == rt.size());
+    BOOST_CHECK(frt.empty() == rt.empty());
+    BOOST_CHECK(frt.depth() == bgi::detail::rtree::utilities::view<Rtree>(rt).depth());
+    if ( !rt.empty() )
+    {
+        BOOST_CHECK(bg::equals(frt.bounds(), rt.bounds()));
+    }
+
+    // spatial query
+    {
+        std::vector<value_type> expected, result;
+        rt.query(bgi::intersects(qbox), std::back_inserter(expected));
+        BOOST_CHECK(frt.query(bgi::intersects(qbox), std::back_inserter(result)) == expected.size());
+        check_same_values(expected, result);
+
+        std::vector<value_type> result_it(frt.qbegin(bgi::intersects(qbox)), frt.qend());
+        check_same_values(expected, result_it);
+    }
+
+    // knn query
+    {
+        point_type pt;
+        bg::centroid(qbox, pt);
+
+        std::vector<value_type> expected, result;
+        rt.query(bgi::nearest(pt, 5), std::back_inserter(expected));
+        BOOST_CHECK(frt.query(bgi::nearest(pt, 5), std::back_inserter(result)) == expected.size());
+        check_same_distances(expected, result, pt);
+
+        std::vector<value_type> result_it;
+        for ( typename FlatRtree::const_query_iterator it = frt.qbegin(bgi::nearest(pt, 5)) ;
+              it != frt.qend() ; ++it )
+        {
+            result_it.push_back(*it);
+        }
+        check_same_distances(expected, result_it, pt);
+    }
+}
+
+template <typename Value, typename Params>
+void test_flat(int size, Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_type;
+    typedef bgi::flat_rtree<Value, Params> flat_rtree_type;
+    typedef typename rtree_type::bounds_type box_type;
+
+    std::vector<Value> input;
+    box_type qbox;
+    generate::input<bg::dimension<box_type>::value>::apply(input, qbox, size);
+
+    // packed and created by insertion
+    rtree_type rt_pack(input, params);
+    rtree_type rt_ins(params);
+    rt_ins.insert(input);
+
+    rtree_type const* trees[] = { &rt_pack, &rt_ins };
+    for ( std::size_t t = 0 ; t < 2 ; ++t )
+    {
+        rtree_type const& rt = *trees[t];
+
+        std::size_t const size = bgi::flat_size(rt);
+
+        flat_buffer buffer(size);
+        BOOST_CHECK(bgi::write_flat(rt, buffer.data()) == size);
+
+        flat_rtree_type frt(buffer.data(), size, params);
+        check_queries(frt, rt, qbox);
+
+        // the block is relocatable
+        flat_buffer moved(size + 64);
+        char * moved_data = moved.data() + 64;
+        std::memcpy(moved_data, buffer.data(), size);
+        std::memset(buffer.data(), 0, size);
+
+        flat_rtree_type frt_moved(moved_data, size, params);
+        check_queries(frt_moved, rt, qbox);
+
+        // the stream contains the same data
+        std::ostringstream os(std::ios::binary);
+        bgi::write_flat(rt, os);
+        std::string const str = os.str();
+        BOOST_CHECK(str.size() == size);
+        BOOST_CHECK(std::memcmp(str.data(), moved_data, size) == 0);
+    }
+}
+
+template <typename Params>
+void test_flat_values()
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+    typedef bg::model::box<P2> B2;
+    typedef bg::model::point<float, 3, bg::cs::cartesian> P3;
+
+    test_flat<P2, Params>(1);
+    test_flat<P2, Params>(10);
+    test_flat<B2, Params>(10);
+    test_flat<std::pair<P2, int>, Params>(10);
+    test_flat<P3, Params>(4);
+}
+
+void test_flat_errors()
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+    typedef bg::model::box<P2> B2;
+    typedef bgi::rtree<P2, bgi::linear<4, 2> > rtree_type;
+    typedef bgi::flat_rtree<P2, bgi::linear<4, 2> > flat_rtree_type;
+
+    // empty tree
+    rtree_type rt;
+    std::size_t const size = bgi::flat_size(rt);
+    flat_buffer buffer(size);
+    bgi::write_flat(rt, buffer.data());
+    flat_rtree_type frt(buffer.data(), size);
+    BOOST_CHECK(frt.empty());
+    std::vector<P2> result;
+    BOOST_CHECK(frt.query(bgi::intersects(B2(P2(0, 0), P2(1, 1))), std::back_inserter(result)) == 0);
+    BOOST_CHECK(frt.query(bgi::nearest(P2(0, 0), 1), std::back_inserter(result)) == 0);
+    BOOST_CHECK(frt.qbegin(bgi::nearest(P2(0, 0), 1)) == frt.qend());
+
+    // truncated block
+    BOOST_CHECK_THROW(flat_rtree_type(buffer.data(), size - 1), std::invalid_argument);
+    // different parameters
+    BOOST_CHECK_THROW((bgi::flat_rtree<P2, bgi::linear<8, 2> >(buffer.data(), size)), std::invalid_argument);
+    // different value
+    BOOST_CHECK_THROW((bgi::flat_rtree<B2, bgi::linear<4, 2> >(buffer.data(), size)), std::invalid_argument);
+    // invalid data
+    buffer.data()[0] = 'X';
+    BOOST_CHECK_THROW(flat_rtree_type(buffer.data(), size), std::invalid_argument);
+}
+
+int test_main(int, char* [])
+{
+    test_flat_values< bgi::linear<4, 2> >();
+    test_flat_values< bgi::quadratic<5, 2> >();
+    test_flat_values< bgi::rstar<16, 4> >();
+
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+    test_flat<P2, bgi::dynamic_rstar>(10, bgi::dynamic_rstar(8, 3));
+
+    test_flat_errors();
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <vector>
+
+#include <boost/geometry/index/detail/rtree/utilities/are_counts_ok.hpp>
+
+template <typename Rtree, typename Box>
+void check_query(Rtree const& rt, Rtree const& rt_expected, Box const& qbox)
+{
+    typedef typename Rtree::value_type value_type;
+
+    std::vector<value_type> expected, result;
+    rt_expected.query(bgi::intersects(qbox), std::back_inserter(expected));
+    rt.query(bgi::intersects(qbox), std::back_inserter(result));
+    basictest::compare_outputs(rt, result, expected);
+}
+
+template <typename Rtree>
+void check_structure(Rtree const& rt, std::size_t size)
+{
+    BOOST_CHECK(rt.size() == size);
+    BOOST_CHECK(bgi::detail::rtree::utilities::are_levels_ok(rt));
+    BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(rt));
+    BOOST_CHECK(bgi::detail::rtree::utilities::are_counts_ok(rt));
+}
+
+template <typename Value, typename Params>
+void test_pack_curve(int size, Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_type;
+    typedef typename rtree_type::bounds_type box_type;
+
+    std::vector<Value> input;
+    box_type qbox;
+    generate::input<bg::dimension<box_type>::value>::apply(input, qbox, size);
+
+    rtree_type rt_expected(input.begin(), input.end(), params);
+
+    bgi::packing_curve const curves[] = { bgi::hilbert_curve, bgi::z_order_curve };
+    for ( std::size_t i = 0 ; i < sizeof(curves) / sizeof(curves[0]) ; ++i )
+    {
+        bgi::curve_packing packing(curves[i]);
+
+        rtree_type rt_it(input.begin(), input.end(), packing, params);
+        rtree_type rt_rng(input, packing, params);
+
+        check_structure(rt_it, input.size());
+        check_structure(rt_rng, input.size());
+
+        check_query(rt_it, rt_expected, qbox);
+        check_query(rt_rng, rt_expected, qbox);
+
+        // the tree may be modified after packing
+        std::size_t const removed_count = input.size() / 2;
+        BOOST_CHECK(rt_it.remove(input.begin(), input.begin() + removed_count) == removed_count);
+        rt_it.insert(input.begin(), input.begin() + removed_count);
+        check_structure(rt_it, input.size());
+        check_query(rt_it, rt_expected, qbox);
+    }
+
+    // the same values
+    {
+        std::vector<Value> same(37, input.front());
+        rtree_type rt(same, bgi::curve_packing(), params);
+        check_structure(rt, same.size());
+    }
+
+    // empty range
+    {
+        std::vector<Value> empty;
+        rtree_type rt(empty.begin(), empty.end(), bgi::curve_packing(), params);
+        BOOST_CHECK(rt.empty());
+    }
+}
+
+template <typename Value, typename Params>
+void test_pack_curve_counts(Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_type;
+
+    std::vector<Value> input;
+    for ( int i = 0 ; i < 200 ; ++i )
+    {
+        input.push_back(generate::value<Value>::apply(i % 17, i / 17));
+        rtree_type rt(input, bgi::curve_packing(), params);
+        check_structure(rt, input.size());
+    }
+}
+
+template <typename Params>
+void test_pack_curve_values()
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+    typedef bg::model::box<P2> B2;
+    typedef bg::model::point<double, 3, bg::cs::cartesian> P3;
+    typedef bg::model::box<P3> B3;
+
+    test_pack_curve<P2, Params>(1);
+    test_pack_curve<P2, Params>(10);
+    test_pack_curve<B2, Params>(10);
+    test_pack_curve<std::pair<P2, int>, Params>(10);
+    test_pack_curve<P3, Params>(4);
+    test_pack_curve<B3, Params>(4);
+
+    test_pack_curve_counts<P2, Params>();
+}
+
+int test_main(int, char* [])
+{
+    test_pack_curve_values< bgi::linear<4, 2> >();
+    test_pack_curve_values< bgi::quadratic<5, 2> >();
+    test_pack_curve_values< bgi::rstar<16, 4> >();
+
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+    test_pack_curve<P2, bgi::dynamic_rstar>(10, bgi::dynamic_rstar(8, 3));
+    test_pack_curve_counts<P2, bgi::dynamic_linear>(bgi::dynamic_linear(7, 3));
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <vector>
+
+#include <boost/geometry/index/detail/rtree/utilities/view.hpp>
+
+// Stores the structure of the tree in a depth-first order
+template <typename Value, typename Options, typename Box, typename Allocators>
+struct structure_visitor
+    : public bgi::detail::rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, true>::type
+{
+    typedef typename bgi::detail::rtree::internal_node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename bgi::detail::rtree::leaf<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    void operator()(internal_node const& n)
+    {
+        typedef typename bgi::detail::rtree::elements_type<internal_node>::type elements_type;
+        elements_type const& elements = bgi::detail::rtree::elements(n);
+
+        sizes.push_back(elements.size());
+        for ( typename elements_type::const_iterator it = elements.begin() ; it != elements.end() ; ++it )
+        {
+            boxes.push_back(it->first);
+            bgi::detail::rtree::apply_visitor(*this, *it->second);
+        }
+    }
+
+    void operator()(leaf const& n)
+    {
+        typedef typename bgi::detail::rtree::elements_type<leaf>::type elements_type;
+        elements_type const& elements = bgi::detail::rtree::elements(n);
+
+        sizes.push_back(elements.size());
+        values.insert(values.end(), elements.begin(), elements.end());
+    }
+
+    std::vector<std::size_t> sizes;
+    std::vector<Box> boxes;
+    std::vector<Value> values;
+};
+
+template <typename Rtree>
+void check_same_structure(Rtree const& rt1, Rtree const& rt2)
+{
+    typedef bgi::detail::rtree::utilities::view<Rtree> RTV;
+    RTV rtv1(rt1);
+    RTV rtv2(rt2);
+
+    structure_visitor
+        <
+            typename RTV::value_type,
+            typename RTV::options_type,
+            typename RTV::box_type,
+            typename RTV::allocators_type
+        > v1, v2;
+    rtv1.apply_visitor(v1);
+    rtv2.apply_visitor(v2);
+
+    BOOST_CHECK(rtv1.depth() == rtv2.depth());
+    BOOST_CHECK(v1.sizes == v2.sizes);
+    BOOST_CHECK(v1.boxes.size() == v2.boxes.size());
+    for ( std::size_t i = 0 ; i < (std::min)(v1.boxes.size(), v2.boxes.size()) ; ++i )
+    {
+        BOOST_CHECK(bg::equals(v1.boxes[i], v2.boxes[i]));
+    }
+    BOOST_CHECK(v1.values.size() == v2.values.size());
+    for ( std::size_t i = 0 ; i < (std::min)(v1.values.size(), v2.values.size()) ; ++i )
+    {
+        BOOST_CHECK(bgi::equal_to<typename RTV::value_type>()(v1.values[i], v2.values[i]));
+    }
+}
+
+template <typename Value, typename Params>
+void test_pack_parallel(int size, Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_type;
+    typedef typename rtree_type::bounds_type box_type;
+
+    std::vector<Value> input;
+    box_type qbox;
+    generate::input<bg::dimension<box_type>::value>::apply(input, qbox, size);
+
+    rtree_type rt_serial(input.begin(), input.end(), params);
+
+    // 1 thread, threads count not divisible by 2 and subtrees created in separate threads regardless of size
+    std::size_t const threads[] = { 1, 3, 4, 0 };
+    for ( std::size_t i = 0 ; i < sizeof(threads) / sizeof(threads[0]) ; ++i )
+    {
+        bgi::parallel_packing packing(threads[i], 1);
+
+        rtree_type rt_it(input.begin(), input.end(), packing, params);
+        rtree_type rt_rng(input, packing, params);
+
+        BOOST_CHECK(rt_it.size() == input.size());
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_levels_ok(rt_it));
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(rt_it));
+
+        check_same_structure(rt_serial, rt_it);
+        check_same_structure(rt_serial, rt_rng);
+
+        std::vector<Value> expected, result;
+        rt_serial.query(bgi::intersects(qbox), std::back_inserter(expected));
+        rt_it.query(bgi::intersects(qbox), std::back_inserter(result));
+        BOOST_CHECK(expected.size() == result.size());
+    }
+
+    // empty range
+    {
+        std::vector<Value> empty;
+        rtree_type rt(empty.begin(), empty.end(), bgi::parallel_packing(4, 1), params);
+        BOOST_CHECK(rt.empty());
+    }
+}
+
+template <typename Params>
+void test_pack_parallel_values()
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+    typedef bg::model::box<P2> B2;
+    typedef bg::model::point<double, 3, bg::cs::cartesian> P3;
+
+    test_pack_parallel<P2, Params>(1);
+    test_pack_parallel<P2, Params>(10);
+    test_pack_parallel<B2, Params>(10);
+    test_pack_parallel<std::pair<P2, int>, Params>(10);
+    test_pack_parallel<P3, Params>(4);
+}
+
+int test_main(int, char* [])
+{
+    test_pack_parallel_values< bgi::linear<4, 2> >();
+    test_pack_parallel_values< bgi::quadratic<5, 2> >();
+    test_pack_parallel_values< bgi::rstar<16, 4> >();
+
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+    test_pack_parallel<P2, bgi::dynamic_rstar>(10, bgi::dynamic_rstar(8, 3));
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <vector>
+
+// The nearest values may be different if there are ties so only distances are compared
+template <typename Value, typename Point>
+bool same_distances(std::vector<Value> const& expected, std::vector<Value> const& result, Point const& pt)
+{
+    if ( expected.size() != result.size() )
+        return false;
+
+    bgi::indexable<Value> ind;
+    std::vector<double> expected_d, result_d;
+    for ( std::size_t i = 0 ; i < expected.size() ; ++i )
+    {
+        expected_d.push_back(bg::comparable_distance(pt, ind(expected[i])));
+        result_d.push_back(bg::comparable_distance(pt, ind(result[i])));
+    }
+    std::sort(expected_d.begin(), expected_d.end());
+    std::sort(result_d.begin(), result_d.end());
+    return expected_d == result_d;
+}
+
+template <typename Rtree, typename Predicates, typename Point>
+void test_query_batch(Rtree const& rt, std::vector<Predicates> const& predicates,
+                      std::vector<Point> const& points, bgi::batch_query const& batch)
+{
+    typedef typename Rtree::value_type value_type;
+    typedef std::back_insert_iterator<std::vector<value_type> > out_iter;
+
+    std::vector<std::vector<value_type> > results(predicates.size());
+    std::vector<out_iter> out_its;
+    for ( std::size_t i = 0 ; i < results.size() ; ++i )
+        out_its.push_back(std::back_inserter(results[i]));
+
+    std::size_t const found = rt.query_batch(predicates, out_its, batch);
+
+    std::size_t expected_found = 0;
+    for ( std::size_t i = 0 ; i < predicates.size() ; ++i )
+    {
+        std::vector<value_type> expected;
+        expected_found += rt.query(predicates[i], std::back_inserter(expected));
+        BOOST_CHECK(same_distances(expected, results[i], points[i]));
+    }
+    BOOST_CHECK(found == expected_found);
+}
+
+template <typename Rtree, typename Point, typename Box, typename Predicates>
+void test_query_batch_and(Rtree const& rt, std::vector<Point> const& points, Box const& qbox,
+                          Predicates const& /*type of predicates*/)
+{
+    std::vector<Predicates> predicates;
+    for ( std::size_t i = 0 ; i < points.size() ; ++i )
+        predicates.push_back(bgi::nearest(points[i], 3) && bgi::intersects(qbox));
+
+    test_query_batch(rt, predicates, points, bgi::batch_query(2));
+}
+
+template <typename Value, typename Params>
+void test_query_batch_values(int size, Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_type;
+    typedef typename rtree_type::bounds_type box_type;
+    typedef typename bg::point_type<box_type>::type point_type;
+
+    std::vector<Value> input;
+    box_type qbox;
+    generate::input<bg::dimension<box_type>::value>::apply(input, qbox, size);
+
+    rtree_type rt(input, params);
+
+    // the query points inside and outside of the tree's bounds
+    std::vector<point_type> points;
+    for ( std::size_t i = 0 ; i < input.size() ; i += 3 )
+    {
+        point_type pt;
+        bg::centroid(bgi::indexable<Value>()(input[i]), pt);
+        points.push_back(pt);
+        bg::multiply_value(pt, 2);
+        points.push_back(pt);
+    }
+
+    std::vector<typename bgi::detail::predicates::nearest<point_type> > nearest;
+    for ( std::size_t i = 0 ; i < points.size() ; ++i )
+    {
+        nearest.push_back(bgi::nearest(points[i], 1 + unsigned(i % 7)));
+    }
+
+    test_query_batch(rt, nearest, points, bgi::batch_query());
+    test_query_batch(rt, nearest, points, bgi::batch_query(3));
+    test_query_batch(rt, nearest, points, bgi::batch_query(0));
+
+    // nearest and spatial predicates
+    test_query_batch_and(rt, points, qbox, bgi::nearest(points[0], 3) && bgi::intersects(qbox));
+}
+
+template <typename Params>
+void test_query_batch_params()
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+    typedef bg::model::box<P2> B2;
+    typedef bg::model::point<double, 3, bg::cs::cartesian> P3;
+
+    test_query_batch_values<P2, Params>(10);
+    test_query_batch_values<B2, Params>(10);
+    test_query_batch_values<std::pair<P2, int>, Params>(10);
+    test_query_batch_values<P3, Params>(4);
+}
+
+int test_main(int, char* [])
+{
+    test_query_batch_params< bgi::linear<4, 2> >();
+    test_query_batch_params< bgi::quadratic<5, 2> >();
+    test_query_batch_params< bgi::rstar<16, 4> >();
+
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+    test_query_batch_values<P2, bgi::dynamic_rstar>(10, bgi::dynamic_rstar(8, 3));
+
+    return 0;
+}
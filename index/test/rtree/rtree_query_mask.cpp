@@ -0,0 +1,153 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <limits>
+#include <vector>
+
+#include <boost/geometry/index/detail/algorithms/predicates_mask.hpp>
+
+struct always_true
+{
+    template <typename Value>
+    bool operator()(Value const&) const { return true; }
+};
+
+// The predicates combined with satisfies() are checked one by one so the
+// results of the fast path are compared with the results of the generic path
+template <typename Rtree, typename Predicate>
+void check_query(Rtree const& rt, Predicate const& pred)
+{
+    typedef typename Rtree::value_type value_type;
+
+    std::vector<value_type> expected, result;
+    rt.query(pred && bgi::satisfies(always_true()), std::back_inserter(expected));
+    rt.query(pred, std::back_inserter(result));
+
+    // the order of the values must also be the same
+    BOOST_CHECK(expected.size() == result.size());
+    if ( expected.size() != result.size() )
+        return;
+
+    bgi::equal_to<value_type> eq;
+    for ( std::size_t i = 0 ; i < expected.size() ; ++i )
+        BOOST_CHECK(eq(expected[i], result[i]));
+}
+
+template <typename Value, typename Params>
+void test_query_mask(Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_type;
+    typedef typename rtree_type::bounds_type box_type;
+
+    std::vector<Value> input;
+    box_type qbox;
+    generate::input<bg::dimension<box_type>::value>::apply(input, qbox, 2);
+
+    rtree_type rt(input, params);
+
+    // the query box and the boxes touching the values
+    std::vector<box_type> qboxes(1, qbox);
+    qboxes.push_back(rt.bounds());
+    for ( std::size_t i = 0 ; i < input.size() ; i += 17 )
+    {
+        box_type b;
+        bg::envelope(bgi::indexable<Value>()(input[i]), b);
+        qboxes.push_back(b);
+    }
+
+    for ( std::size_t i = 0 ; i < qboxes.size() ; ++i )
+    {
+        check_query(rt, bgi::intersects(qboxes[i]));
+        check_query(rt, bgi::within(qboxes[i]));
+        check_query(rt, bgi::covered_by(qboxes[i]));
+    }
+}
+
+// The kernel compared with the algorithms, also for NaN coordinates
+template <typename Predicate, typename T>
+void check_mask(T const* mins, T const* maxs, std::size_t count, T qmin, T qmax, bool const* expected)
+{
+    unsigned char flags[16];
+    for ( std::size_t i = 0 ; i < count ; ++i )
+        flags[i] = 1;
+    bgi::detail::predicate_dimension_mask<Predicate>(mins, maxs, qmin, qmax, count, flags);
+    for ( std::size_t i = 0 ; i < count ; ++i )
+        BOOST_CHECK(bool(flags[i]) == expected[i]);
+}
+
+template <typename T>
+void test_mask()
+{
+    namespace pm = bgi::detail::predicates_mask;
+    typedef bg::model::point<T, 1, bg::cs::cartesian> point_type;
+    typedef bg::model::box<point_type> box_type;
+
+    T const nan = std::numeric_limits<T>::quiet_NaN();
+    T const mins[] = { -2, -1, 0, 0, 1, 2, 3, 0.5, nan, 0, nan, 1 };
+    T const maxs[] = { -1,  0, 0, 1, 1, 3, 4, 0.5, 0, nan, nan, 2 };
+    std::size_t const count = sizeof(mins) / sizeof(mins[0]);
+
+    T const qmin = 0, qmax = 1;
+    box_type const qbox((point_type(qmin)), (point_type(qmax)));
+
+    bool p_covered_by[count], p_within[count], b_intersects[count], b_within[count], b_covered_by[count];
+    for ( std::size_t i = 0 ; i < count ; ++i )
+    {
+        point_type const p(mins[i]);
+        box_type b;
+        bg::set<bg::min_corner, 0>(b, mins[i]);
+        bg::set<bg::max_corner, 0>(b, maxs[i]);
+
+        p_covered_by[i] = bg::intersects(p, qbox);
+        BOOST_CHECK(p_covered_by[i] == bg::covered_by(p, qbox));
+        p_within[i] = bg::within(p, qbox);
+        b_intersects[i] = bg::intersects(b, qbox);
+        b_within[i] = bg::within(b, qbox);
+        b_covered_by[i] = bg::covered_by(b, qbox);
+    }
+
+    check_mask<pm::point_covered_by>(mins, mins, count, qmin, qmax, p_covered_by);
+    check_mask<pm::point_within>(mins, mins, count, qmin, qmax, p_within);
+    check_mask<pm::box_intersects>(mins, maxs, count, qmin, qmax, b_intersects);
+    check_mask<pm::box_within>(mins, maxs, count, qmin, qmax, b_within);
+    check_mask<pm::box_covered_by>(mins, maxs, count, qmin, qmax, b_covered_by);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2d;
+    typedef bg::model::point<double, 3, bg::cs::cartesian> P3d;
+    typedef bg::model::point<float, 2, bg::cs::cartesian> P2f;
+    typedef bg::model::point<float, 3, bg::cs::cartesian> P3f;
+    typedef bg::model::point<int, 2, bg::cs::cartesian> P2i;
+    typedef bg::model::box<P2d> B2d;
+    typedef bg::model::box<P3d> B3d;
+    typedef bg::model::box<P2f> B2f;
+    typedef bg::model::box<P3f> B3f;
+
+    test_mask<double>();
+    test_mask<float>();
+
+    test_query_mask<P2d>(bgi::linear<16, 4>());
+    test_query_mask<P3d>(bgi::quadratic<8, 3>());
+    test_query_mask<B2d>(bgi::rstar<16, 4>());
+    test_query_mask<B3d>(bgi::linear<4, 2>());
+    test_query_mask<P2f>(bgi::linear<16, 4>());
+    test_query_mask<P3f>(bgi::rstar<8, 3>());
+    test_query_mask<B2f>(bgi::quadratic<16, 4>());
+    test_query_mask<B3f>(bgi::linear<16, 4>());
+    test_query_mask<P2i>(bgi::linear<16, 4>());
+    test_query_mask<std::pair<B2d, int> >(bgi::linear<16, 4>());
+    // leaves bigger than the chunk of coordinates
+    test_query_mask<P2d>(bgi::dynamic_linear(150, 30));
+    test_query_mask<B2f>(bgi::rstar<100, 30>());
+    test_query_mask<P2d>(bgi::soa_nodes<bgi::linear<16, 4> >());
+
+    return 0;
+}
@@ -0,0 +1,161 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/geometry/index/detail/rtree/utilities/are_counts_ok.hpp>
+
+template <typename Rtree, typename Predicates>
+void check_query(Rtree const& rt, std::vector<typename Rtree::value_type> const& input, Predicates const& pred)
+{
+    typedef typename Rtree::value_type value_type;
+
+    std::vector<value_type> expected, result;
+    bgi::rtree<value_type, bgi::linear<4> > rt_expected(input);
+    rt_expected.query(pred, std::back_inserter(expected));
+    rt.query(pred, std::back_inserter(result));
+    basictest::compare_outputs(rt, result, expected);
+}
+
+// The nearest values may be different if there are ties so only distances are compared
+template <typename Rtree, typename Point>
+void check_nearest(Rtree const& rt, std::vector<typename Rtree::value_type> const& input, Point const& pt)
+{
+    typedef typename Rtree::value_type value_type;
+
+    std::vector<value_type> expected, result;
+    bgi::rtree<value_type, bgi::linear<4> > rt_expected(input);
+    rt_expected.query(bgi::nearest(pt, 5), std::back_inserter(expected));
+    rt.query(bgi::nearest(pt, 5), std::back_inserter(result));
+
+    BOOST_CHECK(expected.size() == result.size());
+    if ( expected.size() != result.size() )
+        return;
+
+    bgi::indexable<value_type> ind;
+    std::vector<double> expected_d, result_d;
+    for ( std::size_t i = 0 ; i < expected.size() ; ++i )
+    {
+        expected_d.push_back(bg::comparable_distance(pt, ind(expected[i])));
+        result_d.push_back(bg::comparable_distance(pt, ind(result[i])));
+    }
+    std::sort(expected_d.begin(), expected_d.end());
+    std::sort(result_d.begin(), result_d.end());
+    BOOST_CHECK(expected_d == result_d);
+}
+
+template <typename Rtree>
+void check_structure(Rtree const& rt, std::size_t size)
+{
+    BOOST_CHECK(rt.size() == size);
+    BOOST_CHECK(bgi::detail::rtree::utilities::are_levels_ok(rt));
+    BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(rt));
+    BOOST_CHECK(bgi::detail::rtree::utilities::are_counts_ok(rt));
+}
+
+template <typename Value, typename Params>
+void test_soa(Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_type;
+    typedef typename rtree_type::bounds_type box_type;
+    typedef typename bg::point_type<box_type>::type point_type;
+
+    std::vector<Value> input;
+    box_type qbox;
+    generate::input<bg::dimension<box_type>::value>::apply(input, qbox, 2);
+
+    rtree_type rt_ins(params);
+    rt_ins.insert(input);
+    rtree_type rt_pack(input, params);
+
+    check_structure(rt_ins, input.size());
+    check_structure(rt_pack, input.size());
+
+    // the predicates tested with the structure-of-arrays kernel
+    check_query(rt_ins, input, bgi::intersects(qbox));
+    check_query(rt_pack, input, bgi::intersects(qbox));
+    check_query(rt_ins, input, bgi::within(qbox));
+    check_query(rt_ins, input, bgi::covered_by(qbox));
+    check_query(rt_ins, input, bgi::intersects(qbox.min_corner()));
+    // the predicates tested one by one
+    check_query(rt_ins, input, bgi::disjoint(qbox));
+    check_query(rt_ins, input, !bgi::intersects(qbox));
+    check_query(rt_ins, input, bgi::intersects(qbox) && !bgi::covered_by(qbox));
+    check_nearest(rt_ins, input, point_type(qbox.min_corner()));
+
+    // copy and modification
+    rtree_type rt_copy(rt_ins);
+    check_structure(rt_copy, input.size());
+    std::size_t const removed_count = input.size() / 2;
+    BOOST_CHECK(rt_copy.remove(input.begin(), input.begin() + removed_count) == removed_count);
+    check_structure(rt_copy, input.size() - removed_count);
+    rt_copy.insert(input.begin(), input.begin() + removed_count);
+    check_structure(rt_copy, input.size());
+    check_query(rt_copy, input, bgi::intersects(qbox));
+
+    rt_copy = rt_pack;
+    check_query(rt_copy, input, bgi::intersects(qbox));
+}
+
+template <typename Box>
+void test_soa_elements()
+{
+    typedef bgi::detail::rtree::soa_elements<Box, int, 4> elements_type;
+    typedef typename bg::point_type<Box>::type point_type;
+
+    elements_type elements;
+    elements.push_back(bgi::detail::rtree::make_ptr_pair(Box(point_type(0, 0), point_type(1, 1)), 10));
+    elements.push_back(bgi::detail::rtree::make_ptr_pair(Box(point_type(2, 0), point_type(3, 1)), 11));
+    elements.push_back(bgi::detail::rtree::make_ptr_pair(Box(point_type(4, 0), point_type(5, 1)), 12));
+
+    BOOST_CHECK(elements.size() == 3);
+    BOOST_CHECK(elements.min_coords(0)[1] == 2 && elements.max_coords(0)[2] == 5);
+    BOOST_CHECK(bg::equals(elements[1].first, Box(point_type(2, 0), point_type(3, 1))));
+    BOOST_CHECK(elements[2].second == 12);
+
+    // the boxes touching the query box intersect it
+    unsigned char flags[4];
+    bgi::detail::rtree::soa_intersects(elements, Box(point_type(1, 0), point_type(2, 2)), flags);
+    BOOST_CHECK(flags[0] && flags[1] && ! flags[2]);
+    bgi::detail::rtree::soa_intersects(elements, point_type(4.5, 0.5), flags);
+    BOOST_CHECK(! flags[0] && ! flags[1] && flags[2]);
+
+    elements.erase(elements.begin());
+    BOOST_CHECK(elements.size() == 2);
+    BOOST_CHECK(elements[0].second == 11 && elements[1].second == 12);
+    BOOST_CHECK(bg::equals(elements[1].first, Box(point_type(4, 0), point_type(5, 1))));
+
+    elements[0] = elements[1];
+    BOOST_CHECK(elements[0].second == 12);
+    BOOST_CHECK(bg::equals(elements[0].first, Box(point_type(4, 0), point_type(5, 1))));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2d;
+    typedef bg::model::point<double, 3, bg::cs::cartesian> P3d;
+    typedef bg::model::point<int, 2, bg::cs::cartesian> P2i;
+    typedef bg::model::box<P2d> B2d;
+    typedef bg::model::box<P3d> B3d;
+
+    test_soa_elements<B2d>();
+
+    test_soa<P2d>(bgi::soa_nodes<bgi::linear<4, 2> >());
+    test_soa<B2d>(bgi::soa_nodes<bgi::quadratic<8, 3> >());
+    test_soa<P3d>(bgi::soa_nodes<bgi::rstar<16, 4> >());
+    test_soa<B3d>(bgi::soa_nodes<bgi::rstar<5, 2> >());
+    test_soa<P2i>(bgi::soa_nodes<bgi::kmeans<8, 3> >());
+    test_soa<std::pair<B2d, int> >(bgi::soa_nodes<bgi::linear<16, 4> >());
+
+    testset::modifiers<B2d>(bgi::soa_nodes<bgi::quadratic<5, 2> >(), std::allocator<int>());
+    testset::queries<P3d>(bgi::soa_nodes<bgi::rstar<5, 2> >(), std::allocator<int>());
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+typedef bg::model::box<P2> B2;
+
+template <typename Indexable>
+struct generate_indexable;
+
+template <>
+struct generate_indexable<P2>
+{
+    static P2 apply(int x, int y)
+    {
+        return P2(x, y);
+    }
+};
+
+template <>
+struct generate_indexable<B2>
+{
+    static B2 apply(int x, int y)
+    {
+        return B2(P2(x, y), P2(x + std::rand() % 4, y + std::rand() % 4));
+    }
+};
+
+// The values on a small grid so there are many values touching, within etc. each other
+template <typename Indexable>
+std::vector< std::pair<Indexable, int> > generate_values(int count, int range)
+{
+    std::vector< std::pair<Indexable, int> > result;
+    for ( int i = 0 ; i < count ; ++i )
+    {
+        int const x = std::rand() % range;
+        int const y = std::rand() % range;
+        result.push_back(std::make_pair(generate_indexable<Indexable>::apply(x, y), i));
+    }
+    return result;
+}
+
+template <typename Tag, bool Negated, typename I1, typename I2>
+bool expected_check(bgi::detail::predicates::spatial_join_predicate<Tag, Negated> const& ,
+                    I1 const& i1, I2 const& i2)
+{
+    return bgi::detail::spatial_predicate_call<Tag>::apply(i1, i2) != Negated;
+}
+
+template <typename Value1, typename Value2, typename Predicate>
+std::vector< std::pair<int, int> > expected_join(std::vector<Value1> const& values1,
+                                                 std::vector<Value2> const& values2,
+                                                 Predicate const& pred)
+{
+    std::vector< std::pair<int, int> > result;
+    for ( std::size_t i = 0 ; i < values1.size() ; ++i )
+        for ( std::size_t j = 0 ; j < values2.size() ; ++j )
+            if ( expected_check(pred, values1[i].first, values2[j].first) )
+                result.push_back(std::make_pair(values1[i].second, values2[j].second));
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template <typename Pairs>
+std::vector< std::pair<int, int> > ids(Pairs const& pairs)
+{
+    std::vector< std::pair<int, int> > result;
+    for ( std::size_t i = 0 ; i < pairs.size() ; ++i )
+        result.push_back(std::make_pair(pairs[i].first.second, pairs[i].second.second));
+    return result;
+}
+
+template <typename Rtree1, typename Rtree2, typename Predicate>
+void test_join(Rtree1 const& rt1, Rtree2 const& rt2, Predicate const& pred,
+               std::vector< std::pair<int, int> > const& expected)
+{
+    typedef std::vector< std::pair<typename Rtree1::value_type, typename Rtree2::value_type> > pairs_type;
+
+    pairs_type result;
+    BOOST_CHECK(bgi::spatial_join(rt1, rt2, pred, std::back_inserter(result)) == expected.size());
+    std::vector< std::pair<int, int> > result_ids = ids(result);
+    std::vector< std::pair<int, int> > sorted_ids = result_ids;
+    std::sort(sorted_ids.begin(), sorted_ids.end());
+    BOOST_CHECK(sorted_ids == expected);
+
+    // the parallel join returns the same pairs in the same order
+    for ( std::size_t threads = 1 ; threads <= 3 ; ++threads )
+    {
+        pairs_type result_par;
+        BOOST_CHECK(rt1.spatial_join(rt2, pred, std::back_inserter(result_par), bgi::parallel_join(threads))
+                    == expected.size());
+        BOOST_CHECK(ids(result_par) == result_ids);
+    }
+}
+
+template <typename Indexable1, typename Indexable2, typename Params1, typename Params2, typename Predicate>
+void test_join_values(int count1, int count2, int range, Predicate const& pred,
+                      Params1 const& params1 = Params1(), Params2 const& params2 = Params2())
+{
+    typedef std::pair<Indexable1, int> value1_type;
+    typedef std::pair<Indexable2, int> value2_type;
+
+    std::vector<value1_type> values1 = generate_values<Indexable1>(count1, range);
+    std::vector<value2_type> values2 = generate_values<Indexable2>(count2, range);
+    std::vector< std::pair<int, int> > const expected = expected_join(values1, values2, pred);
+
+    // packed
+    {
+        bgi::rtree<value1_type, Params1> rt1(values1, params1);
+        bgi::rtree<value2_type, Params2> rt2(values2, params2);
+        test_join(rt1, rt2, pred, expected);
+    }
+    // created by insertion
+    {
+        bgi::rtree<value1_type, Params1> rt1(params1);
+        rt1.insert(values1);
+        bgi::rtree<value2_type, Params2> rt2(params2);
+        rt2.insert(values2);
+        test_join(rt1, rt2, pred, expected);
+    }
+}
+
+template <typename Params1, typename Params2>
+void test_join_params(Params1 const& params1 = Params1(), Params2 const& params2 = Params2())
+{
+    // trees of similar and different heights
+    int const counts[][2] = { {0, 10}, {1, 1}, {300, 300}, {1000, 20}, {20, 1000} };
+    for ( std::size_t i = 0 ; i < sizeof(counts) / sizeof(counts[0]) ; ++i )
+    {
+        int const c1 = counts[i][0];
+        int const c2 = counts[i][1];
+
+        test_join_values<B2, B2>(c1, c2, 100, bgi::intersects(), params1, params2);
+        test_join_values<B2, B2>(c1, c2, 100, bgi::within(), params1, params2);
+        test_join_values<B2, B2>(c1, c2, 100, bgi::covered_by(), params1, params2);
+        test_join_values<B2, B2>(c1, c2, 100, bgi::contains(), params1, params2);
+        test_join_values<B2, B2>(c1, c2, 100, bgi::covers(), params1, params2);
+        test_join_values<B2, B2>(c1, c2, 100, bgi::overlaps(), params1, params2);
+        test_join_values<B2, B2>(c1, c2, 100, bgi::touches(), params1, params2);
+        test_join_values<B2, B2>(c1, c2, 100, !bgi::disjoint(), params1, params2);
+        test_join_values<P2, B2>(c1, c2, 100, bgi::covered_by(), params1, params2);
+        test_join_values<B2, P2>(c1, c2, 100, bgi::intersects(), params1, params2);
+        test_join_values<P2, P2>(c1, c2, 30, bgi::intersects(), params1, params2);
+    }
+
+    // the predicates which can't prune the nodes
+    test_join_values<B2, B2>(100, 80, 100, bgi::disjoint(), params1, params2);
+    test_join_values<B2, B2>(100, 80, 100, !bgi::intersects(), params1, params2);
+    test_join_values<B2, P2>(80, 100, 100, !bgi::covers(), params1, params2);
+}
+
+int test_main(int, char* [])
+{
+    test_join_params< bgi::linear<4, 2>, bgi::linear<4, 2> >();
+    test_join_params< bgi::quadratic<5, 2>, bgi::rstar<16, 4> >();
+    test_join_params< bgi::rstar<8, 3>, bgi::linear<16, 4> >();
+    test_join_params<bgi::dynamic_rstar, bgi::dynamic_linear>(bgi::dynamic_rstar(8, 3), bgi::dynamic_linear(4, 2));
+
+    return 0;
+}
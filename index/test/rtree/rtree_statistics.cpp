@@ -0,0 +1,100 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <vector>
+
+#include <boost/geometry/index/detail/rtree/utilities/statistics.hpp>
+
+template <typename Value, typename Params>
+void test_statistics(bool has_reinserts, Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_type;
+    typedef typename rtree_type::bounds_type box_type;
+    typedef typename bg::point_type<box_type>::type point_type;
+
+    std::vector<Value> input;
+    box_type qbox;
+    generate::input<bg::dimension<box_type>::value>::apply(input, qbox, 2);
+
+    // insertions
+    rtree_type rt(params);
+    bgi::insert_statistics istats;
+    for ( std::size_t i = 0 ; i < input.size() ; ++i )
+        rt.insert(input[i], istats);
+
+    std::size_t const depth = bgi::detail::rtree::utilities::view<rtree_type>(rt).depth();
+    std::size_t const internal_nodes = boost::get<1>(bgi::detail::rtree::utilities::statistics(rt));
+    std::size_t const leaves = boost::get<2>(bgi::detail::rtree::utilities::statistics(rt));
+
+    BOOST_CHECK(istats.inserts == input.size());
+    // each split creates one node and the split of the root also a new root,
+    // the first leaf is created without a split
+    BOOST_CHECK(istats.splits + depth + 1 == internal_nodes + leaves);
+    BOOST_CHECK((istats.reinserts > 0) == has_reinserts);
+
+    // the query visiting all nodes
+    std::vector<Value> expected, result;
+    bgi::query_statistics qstats;
+    rt.query(bgi::intersects(rt.bounds()), std::back_inserter(expected));
+    rt.query(bgi::intersects(rt.bounds()), std::back_inserter(result), qstats);
+
+    BOOST_CHECK(expected.size() == input.size());
+    basictest::compare_outputs(rt, result, expected);
+    BOOST_CHECK(qstats.nodes == internal_nodes + leaves);
+    BOOST_CHECK(qstats.leaves == leaves);
+    // every child of the internal nodes and every value is checked
+    BOOST_CHECK(qstats.predicates_checks == internal_nodes + leaves - 1 + input.size());
+
+    // the counters are accumulated
+    bgi::query_statistics const qstats_all = qstats;
+    result.clear();
+    rt.query(bgi::intersects(qbox), std::back_inserter(result), qstats);
+    BOOST_CHECK(qstats.nodes > qstats_all.nodes);
+    BOOST_CHECK(qstats.nodes - qstats_all.nodes <= qstats_all.nodes);
+    BOOST_CHECK(qstats.leaves - qstats_all.leaves <= leaves);
+
+    expected.clear();
+    rt.query(bgi::intersects(qbox), std::back_inserter(expected));
+    basictest::compare_outputs(rt, result, expected);
+
+    // knn query
+    point_type const pt = bg::return_centroid<point_type>(qbox);
+    qstats.clear();
+    result.clear();
+    expected.clear();
+    rt.query(bgi::nearest(pt, 5), std::back_inserter(result), qstats);
+    rt.query(bgi::nearest(pt, 5), std::back_inserter(expected));
+    BOOST_CHECK(result.size() == 5);
+    basictest::compare_outputs(rt, result, expected);
+    BOOST_CHECK(1 <= qstats.leaves && qstats.leaves <= leaves);
+    BOOST_CHECK(qstats.leaves < qstats.nodes && qstats.nodes <= internal_nodes + leaves);
+    BOOST_CHECK(qstats.predicates_checks > 0);
+
+    // empty tree
+    rtree_type empty(params);
+    qstats.clear();
+    empty.query(bgi::intersects(qbox), std::back_inserter(result), qstats);
+    BOOST_CHECK(qstats.nodes == 0 && qstats.leaves == 0 && qstats.predicates_checks == 0);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2d;
+    typedef bg::model::point<double, 3, bg::cs::cartesian> P3d;
+    typedef bg::model::box<P2d> B2d;
+
+    test_statistics<P2d>(false, bgi::linear<4, 2>());
+    test_statistics<P2d>(false, bgi::quadratic<8, 3>());
+    test_statistics<P2d>(true, bgi::rstar<8, 3>());
+    test_statistics<B2d>(true, bgi::dynamic_rstar(16, 4));
+    test_statistics<P3d>(false, bgi::dynamic_linear(16, 4));
+    test_statistics<P2d>(false, bgi::soa_nodes<bgi::linear<8, 3> >());
+
+    return 0;
+}
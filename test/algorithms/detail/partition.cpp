@@ -647,6 +647,72 @@ void test_heterogenuous_collections(int seed1, int seed2, int size, int count)
     BOOST_CHECK_EQUAL(visitor2.count, expected_count);
 }
 
+// Records the ids of the visited pairs, optionally interrupts after a limit
+struct sequence_visitor
+{
+    std::vector<std::pair<int, int> > visits;
+    std::size_t limit;
+
+    explicit sequence_visitor(std::size_t l = 0)
+        : limit(l)
+    {}
+
+    template <typename Item1, typename Item2>
+    inline bool apply(Item1 const& item1, Item2 const& item2)
+    {
+        visits.push_back(std::make_pair(item1.id, item2.id));
+        return limit == 0 || visits.size() < limit;
+    }
+};
+
+void test_threads(int seed1, int seed2, int size, int count)
+{
+    typedef bg::model::box<point_item> box_type;
+    typedef bg::partition<box_type> partition_type;
+    std::vector<box_item<box_type> > boxes1, boxes2;
+
+    fill_boxes(boxes1, seed1, size, count);
+    fill_boxes(boxes2, seed2, size, count);
+
+    bg::detail::partition::visit_no_policy box_policy;
+
+    // The visits are the same and in the same order as in one thread
+    for (std::size_t limit = 0; limit < 2000; limit += 1000)
+    {
+        sequence_visitor expected(limit);
+        partition_type::apply(boxes1, expected, get_box(), ovelaps_box(),
+                              2, box_policy, 1);
+
+        BOOST_CHECK(! expected.visits.empty());
+
+        for (std::size_t threads = 2; threads <= 5; threads++)
+        {
+            sequence_visitor visitor(limit);
+            partition_type::apply(boxes1, visitor, get_box(), ovelaps_box(),
+                                  2, box_policy, threads);
+
+            BOOST_CHECK(visitor.visits == expected.visits);
+        }
+
+        sequence_visitor expected2(limit);
+        partition_type::apply(boxes1, boxes2, expected2,
+                              get_box(), ovelaps_box(), get_box(), ovelaps_box(),
+                              2, box_policy, 1);
+
+        BOOST_CHECK(! expected2.visits.empty());
+
+        for (std::size_t threads = 2; threads <= 5; threads++)
+        {
+            sequence_visitor visitor(limit);
+            partition_type::apply(boxes1, boxes2, visitor,
+                                  get_box(), ovelaps_box(), get_box(), ovelaps_box(),
+                                  2, box_policy, threads);
+
+            BOOST_CHECK(visitor.visits == expected2.visits);
+        }
+    }
+}
+
 int test_main( int , char* [] )
 {
     test_all<bg::model::d2::point_xy<double> >();
@@ -671,5 +737,7 @@ int test_main( int , char* [] )
 
     test_heterogenuous_collections(67890, 98765, 20, 60);
 
+    test_threads(12345, 54321, 200, 20000);
+
     return 0;
 }
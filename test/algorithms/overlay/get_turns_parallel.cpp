@@ -0,0 +1,247 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/strategies/strategies.hpp>
+#include <boost/geometry/strategies/parallel.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/for_each.hpp>
+#include <boost/geometry/algorithms/intersection.hpp>
+#include <boost/geometry/algorithms/union.hpp>
+#include <boost/geometry/algorithms/detail/overlay/cluster_info.hpp>
+#include <boost/geometry/algorithms/detail/overlay/enrich_intersection_points.hpp>
+#include <boost/geometry/algorithms/detail/overlay/get_turns.hpp>
+#include <boost/geometry/algorithms/detail/overlay/traversal_info.hpp>
+#include <boost/geometry/policies/robustness/get_rescale_policy.hpp>
+
+#include <boost/geometry/geometries/geometries.hpp>
+
+
+// Polygon with the radius varying along the circle, with many self-crossing
+// free spikes, so two of them with different phases intersect many times
+template <typename Polygon>
+Polygon wavy_polygon(std::size_t count, double waves, double phase, double cx)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    double const pi = 3.14159265358979323846;
+
+    Polygon result;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        double const a = 2.0 * pi * double(i) / double(count);
+        double const r = 100.0 + 10.0 * std::sin(waves * a + phase);
+        bg::append(result, point_type(cx + r * std::cos(a), r * std::sin(a)));
+    }
+    bg::correct(result);
+    return result;
+}
+
+template <typename Point>
+struct shift
+{
+    shift(double dx, double dy)
+        : m_dx(dx), m_dy(dy)
+    {}
+
+    inline void operator()(Point& point) const
+    {
+        bg::set<0>(point, bg::get<0>(point) + m_dx);
+        bg::set<1>(point, bg::get<1>(point) + m_dy);
+    }
+
+    double m_dx, m_dy;
+};
+
+template <typename Turn>
+void check_equal_turns(std::vector<Turn> const& expected,
+                       std::vector<Turn> const& turns)
+{
+    BOOST_CHECK_EQUAL(expected.size(), turns.size());
+    if (expected.size() != turns.size())
+    {
+        return;
+    }
+
+    for (std::size_t i = 0; i < turns.size(); i++)
+    {
+        Turn const& e = expected[i];
+        Turn const& t = turns[i];
+        BOOST_CHECK(bg::get<0>(e.point) == bg::get<0>(t.point)
+                 && bg::get<1>(e.point) == bg::get<1>(t.point));
+        BOOST_CHECK(e.method == t.method);
+        for (int j = 0; j < 2; j++)
+        {
+            BOOST_CHECK(e.operations[j].seg_id == t.operations[j].seg_id);
+            BOOST_CHECK(e.operations[j].operation == t.operations[j].operation);
+        }
+    }
+}
+
+template <typename Polygon>
+void test_get_turns(Polygon const& g1, Polygon const& g2,
+                    std::size_t threads, std::size_t min_pairs)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    typedef bg::strategy::intersection::cartesian_segments<> strategy_type;
+    typedef bg::strategy::intersection::parallel<strategy_type> parallel_type;
+    typedef typename bg::rescale_policy_type<point_type>::type
+        rescale_policy_type;
+    typedef bg::detail::overlay::turn_info
+        <
+            point_type,
+            typename bg::segment_ratio_type<point_type, rescale_policy_type>::type
+        > turn_info;
+
+    rescale_policy_type rescale_policy
+            = bg::get_rescale_policy<rescale_policy_type>(g1, g2);
+
+    std::vector<turn_info> expected, turns;
+    bg::detail::get_turns::no_interrupt_policy policy;
+
+    bg::get_turns
+        <
+            false, false, bg::detail::overlay::assign_null_policy
+        >(g1, g2, strategy_type(), rescale_policy, expected, policy);
+    bg::get_turns
+        <
+            false, false, bg::detail::overlay::assign_null_policy
+        >(g1, g2, parallel_type(threads, min_pairs), rescale_policy, turns, policy);
+
+    BOOST_CHECK(! expected.empty());
+    check_equal_turns(expected, turns);
+}
+
+template <typename Polygon>
+void test_overlay(Polygon const& g1, Polygon const& g2)
+{
+    typedef bg::strategy::intersection::cartesian_segments<> strategy_type;
+    typedef bg::strategy::intersection::parallel<strategy_type> parallel_type;
+    typedef bg::model::multi_polygon<Polygon> multi_polygon;
+
+    multi_polygon expected, result;
+    bg::intersection(g1, g2, expected);
+    bg::intersection(g1, g2, result, parallel_type(4, 0));
+    BOOST_CHECK_EQUAL(boost::size(expected), boost::size(result));
+    BOOST_CHECK_CLOSE(bg::area(expected), bg::area(result), 0.0001);
+
+    expected.clear();
+    result.clear();
+    bg::union_(g1, g2, expected);
+    bg::union_(g1, g2, result, parallel_type(4, 0));
+    BOOST_CHECK_EQUAL(boost::size(expected), boost::size(result));
+    BOOST_CHECK_CLOSE(bg::area(expected), bg::area(result), 0.0001);
+}
+
+template <typename MultiPolygon>
+void test_enrich(MultiPolygon const& g1, MultiPolygon const& g2)
+{
+    typedef typename bg::point_type<MultiPolygon>::type point_type;
+    typedef bg::strategy::intersection::cartesian_segments<> strategy_type;
+    typedef typename bg::rescale_policy_type<point_type>::type
+        rescale_policy_type;
+    typedef bg::detail::overlay::traversal_turn_info
+        <
+            point_type,
+            typename bg::segment_ratio_type<point_type, rescale_policy_type>::type
+        > turn_info;
+    typedef std::map
+        <
+            bg::signed_size_type, bg::detail::overlay::cluster_info
+        > clusters_type;
+
+    rescale_policy_type rescale_policy
+            = bg::get_rescale_policy<rescale_policy_type>(g1, g2);
+    strategy_type strategy;
+
+    std::vector<turn_info> expected;
+    bg::detail::get_turns::no_interrupt_policy policy;
+    bg::get_turns
+        <
+            false, false, bg::detail::overlay::assign_null_policy
+        >(g1, g2, strategy, rescale_policy, expected, policy);
+
+    // Enough operations to sort the rings in threads
+    BOOST_CHECK(2 * expected.size()
+                >= bg::detail::overlay::enrich_min_parallel_operations);
+
+    std::vector<turn_info> turns = expected;
+    clusters_type expected_clusters, clusters;
+    bg::enrich_intersection_points<false, false, bg::overlay_union>(expected,
+        expected_clusters, g1, g2, rescale_policy, strategy.get_side_strategy());
+    bg::enrich_intersection_points<false, false, bg::overlay_union>(turns,
+        clusters, g1, g2, rescale_policy, strategy.get_side_strategy(), 4);
+
+    BOOST_CHECK_EQUAL(expected_clusters.size(), clusters.size());
+    for (std::size_t i = 0; i < turns.size(); i++)
+    {
+        BOOST_CHECK(expected[i].discarded == turns[i].discarded);
+        for (int j = 0; j < 2; j++)
+        {
+            BOOST_CHECK_EQUAL(expected[i].operations[j].enriched.travels_to_ip_index,
+                              turns[i].operations[j].enriched.travels_to_ip_index);
+            BOOST_CHECK_EQUAL(expected[i].operations[j].enriched.travels_to_vertex_index,
+                              turns[i].operations[j].enriched.travels_to_vertex_index);
+            BOOST_CHECK_EQUAL(expected[i].operations[j].enriched.next_ip_index,
+                              turns[i].operations[j].enriched.next_ip_index);
+        }
+    }
+}
+
+template <typename Point>
+void test_all()
+{
+    typedef bg::model::polygon<Point> polygon;
+
+    polygon const g1 = wavy_polygon<polygon>(2000, 50, 0.0, 0.0);
+    polygon const g2 = wavy_polygon<polygon>(1500, 70, 0.5, 3.0);
+
+    test_get_turns(g1, g2, 4, 0);
+    test_get_turns(g1, g2, 3, 0);
+    test_get_turns(g1, g2, 1, 0);
+    // Not enough pairs to use threads
+    test_get_turns(g1, g2, 4, 1000000);
+
+    test_overlay(g1, g2);
+
+    // A small input, fewer pairs than chunks
+    polygon small1, small2;
+    bg::read_wkt("POLYGON((0 0,0 2,2 2,2 0,0 0))", small1);
+    bg::read_wkt("POLYGON((1 1,1 3,3 3,3 1,1 1))", small2);
+    test_get_turns(small1, small2, 8, 0);
+
+    // Many rings, enriched by multiple threads
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+    multi_polygon mp1, mp2;
+    for (int i = 0; i < 10; i++)
+    {
+        for (int j = 0; j < 10; j++)
+        {
+            polygon p1 = wavy_polygon<polygon>(200, 15, 0.0, 0.0);
+            polygon p2 = wavy_polygon<polygon>(150, 20, 0.5, 3.0);
+            bg::for_each_point(p1, shift<Point>(i * 250.0, j * 250.0));
+            bg::for_each_point(p2, shift<Point>(i * 250.0, j * 250.0));
+            mp1.push_back(p1);
+            mp2.push_back(p2);
+        }
+    }
+    test_enrich(mp1, mp2);
+}
+
+int test_main(int, char* [])
+{
+    test_all<bg::model::d2::point_xy<double> >();
+    test_all<bg::model::d2::point_xy<float> >();
+
+    return 0;
+}
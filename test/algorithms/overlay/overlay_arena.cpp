@@ -0,0 +1,156 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/strategies/strategies.hpp>
+#include <boost/geometry/strategies/parallel.hpp>
+#include <boost/geometry/strategies/with_arena.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/difference.hpp>
+#include <boost/geometry/algorithms/intersection.hpp>
+#include <boost/geometry/algorithms/union.hpp>
+
+#include <boost/geometry/geometries/geometries.hpp>
+
+#include <boost/geometry/util/monotonic_arena.hpp>
+
+
+template <typename Polygon>
+Polygon wavy_polygon(std::size_t count, double waves, double phase, double cx)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    double const pi = 3.14159265358979323846;
+
+    Polygon result;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        double const a = 2.0 * pi * double(i) / double(count);
+        double const r = 100.0 + 10.0 * std::sin(waves * a + phase);
+        bg::append(result, point_type(cx + r * std::cos(a), r * std::sin(a)));
+    }
+    bg::correct(result);
+    return result;
+}
+
+void test_arena()
+{
+    bg::monotonic_arena arena(64);
+    BOOST_CHECK_EQUAL(arena.allocated_bytes(), 0u);
+
+    // Aligned allocations, also bigger than the block
+    char* c = static_cast<char*>(arena.allocate(1, 1));
+    double* d = static_cast<double*>(arena.allocate(sizeof(double) * 100,
+                                        boost::alignment_of<double>::value));
+    BOOST_CHECK(c != 0);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(d)
+                        % boost::alignment_of<double>::value, 0u);
+    for (int i = 0; i < 100; i++)
+    {
+        d[i] = i;
+    }
+    BOOST_CHECK_EQUAL(arena.allocated_bytes(), 1u + sizeof(double) * 100);
+
+    arena.release();
+    BOOST_CHECK_EQUAL(arena.allocated_bytes(), 0u);
+
+    // The containers may use the arena
+    bg::detail::arena_allocator<int> alloc(&arena);
+    std::vector<int, bg::detail::arena_allocator<int> > v(alloc);
+    for (int i = 0; i < 10000; i++)
+    {
+        v.push_back(i);
+    }
+    BOOST_CHECK_EQUAL(v[9999], 9999);
+    BOOST_CHECK(arena.allocated_bytes() >= sizeof(int) * 10000);
+
+    // Or the heap if default-constructed
+    std::vector<int, bg::detail::arena_allocator<int> > h;
+    h.push_back(1);
+    BOOST_CHECK(h.get_allocator().arena() == 0);
+}
+
+template <typename Strategy, typename Polygon>
+void test_overlay(Polygon const& g1, Polygon const& g2,
+                  Strategy const& strategy, bg::monotonic_arena const& arena)
+{
+    typedef bg::model::multi_polygon<Polygon> multi_polygon;
+
+    multi_polygon expected, result;
+    bg::intersection(g1, g2, expected);
+    bg::intersection(g1, g2, result, strategy);
+    BOOST_CHECK_EQUAL(boost::size(expected), boost::size(result));
+    BOOST_CHECK_CLOSE(bg::area(expected), bg::area(result), 0.0001);
+    BOOST_CHECK_EQUAL(arena.allocated_bytes(), 0u);
+
+    expected.clear();
+    result.clear();
+    bg::union_(g1, g2, expected);
+    bg::union_(g1, g2, result, strategy);
+    BOOST_CHECK_EQUAL(boost::size(expected), boost::size(result));
+    BOOST_CHECK_CLOSE(bg::area(expected), bg::area(result), 0.0001);
+    BOOST_CHECK_EQUAL(arena.allocated_bytes(), 0u);
+
+    expected.clear();
+    result.clear();
+    bg::difference(g1, g2, expected);
+    bg::difference(g1, g2, result, strategy);
+    BOOST_CHECK_EQUAL(boost::size(expected), boost::size(result));
+    BOOST_CHECK_CLOSE(bg::area(expected), bg::area(result), 0.0001);
+    BOOST_CHECK_EQUAL(arena.allocated_bytes(), 0u);
+}
+
+template <typename Point>
+void test_all()
+{
+    typedef bg::model::polygon<Point> polygon;
+    typedef bg::strategy::intersection::cartesian_segments<> strategy_type;
+    typedef bg::strategy::intersection::with_arena<strategy_type> arena_type;
+    typedef bg::strategy::intersection::with_arena
+        <
+            bg::strategy::intersection::parallel<strategy_type>
+        > parallel_arena_type;
+
+    polygon const g1 = wavy_polygon<polygon>(2000, 50, 0.0, 0.0);
+    polygon const g2 = wavy_polygon<polygon>(1500, 70, 0.5, 3.0);
+
+    bg::monotonic_arena arena;
+    test_overlay(g1, g2, arena_type(arena), arena);
+
+    // The arena is reused
+    test_overlay(g1, g2, arena_type(arena), arena);
+
+    // The wrappers can be combined
+    BOOST_CHECK_EQUAL(bg::detail::parallel::strategy_threads(
+        parallel_arena_type(arena,
+            bg::strategy::intersection::parallel<strategy_type>(4, 0))), 4u);
+    test_overlay(g1, g2,
+        parallel_arena_type(arena,
+            bg::strategy::intersection::parallel<strategy_type>(4, 0)),
+        arena);
+
+    // Without intersections
+    polygon small1, small2;
+    bg::read_wkt("POLYGON((0 0,0 2,2 2,2 0,0 0))", small1);
+    bg::read_wkt("POLYGON((5 5,5 7,7 7,7 5,5 5))", small2);
+    test_overlay(small1, small2, arena_type(arena), arena);
+}
+
+int test_main(int, char* [])
+{
+    test_arena();
+
+    test_all<bg::model::d2::point_xy<double> >();
+    test_all<bg::model::d2::point_xy<float> >();
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/intersection.hpp>
+#include <boost/geometry/algorithms/intersects.hpp>
+#include <boost/geometry/algorithms/union.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <boost/geometry/geometries/geometries.hpp>
+
+
+// The side is calculated exactly for integer coordinates, with doubles
+// the determinant (-1) is lost
+template <typename T>
+void test_side()
+{
+    typedef bg::model::d2::point_xy<T> point_type;
+    typedef bg::strategy::side::side_by_triangle<> side;
+
+    point_type const p1(0, 0);
+    point_type const p2(2000000001, 2000000000);
+    point_type const right(2000000000, 1999999999);
+    point_type const left(1999999999, 1999999999);
+    point_type const on(-2000000001, -2000000000);
+
+    BOOST_CHECK_EQUAL(side::apply(p1, p2, right), -1);
+    BOOST_CHECK_EQUAL(side::apply(p1, p2, left), 1);
+    BOOST_CHECK_EQUAL(side::apply(p1, p2, on), 0);
+    BOOST_CHECK_EQUAL(side::apply(p2, p1, right), 1);
+}
+
+template <typename Polygon>
+Polygon wavy_polygon(std::size_t count, double waves, double phase,
+                     double cx, double scale)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    typedef typename bg::coordinate_type<Polygon>::type coordinate_type;
+    double const pi = 3.14159265358979323846;
+
+    Polygon result;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        double const a = 2.0 * pi * double(i) / double(count);
+        double const r = 1.0 + 0.1 * std::sin(waves * a + phase);
+        bg::append(result, point_type(
+            coordinate_type(std::floor((cx + r * std::cos(a)) * scale + 0.5)),
+            coordinate_type(std::floor(r * std::sin(a) * scale + 0.5))));
+    }
+    bg::correct(result);
+    return result;
+}
+
+// Overlay of integer polygons, also with large coordinates, gives the
+// same areas as with doubles
+template <typename T>
+void test_overlay(double scale)
+{
+    typedef bg::model::polygon<bg::model::d2::point_xy<T> > polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+    typedef bg::model::polygon<bg::model::d2::point_xy<double> > polygon_d;
+    typedef bg::model::multi_polygon<polygon_d> multi_polygon_d;
+
+    polygon const p = wavy_polygon<polygon>(500, 20, 0.0, 0.0, scale);
+    polygon const q = wavy_polygon<polygon>(400, 30, 0.5, 0.3, scale);
+    polygon_d const pd = wavy_polygon<polygon_d>(500, 20, 0.0, 0.0, scale);
+    polygon_d const qd = wavy_polygon<polygon_d>(400, 30, 0.5, 0.3, scale);
+
+    multi_polygon intersection, union_result;
+    multi_polygon_d intersection_d, union_d;
+    bg::intersection(p, q, intersection);
+    bg::union_(p, q, union_result);
+    bg::intersection(pd, qd, intersection_d);
+    bg::union_(pd, qd, union_d);
+
+    BOOST_CHECK_EQUAL(boost::size(intersection), boost::size(intersection_d));
+    BOOST_CHECK_EQUAL(boost::size(union_result), boost::size(union_d));
+    BOOST_CHECK_CLOSE(double(bg::area(intersection)), bg::area(intersection_d), 0.01);
+    BOOST_CHECK_CLOSE(double(bg::area(union_result)), bg::area(union_d), 0.01);
+
+    BOOST_CHECK(bg::intersects(p, q));
+    BOOST_CHECK(! bg::within(p, q));
+    BOOST_CHECK(bg::within(bg::model::d2::point_xy<T>(T(0), T(0)), union_result));
+    BOOST_CHECK(bg::within(bg::model::d2::point_xy<T>(T(0.3 * scale), T(0)), intersection));
+}
+
+int test_main(int, char* [])
+{
+    test_side<boost::int32_t>();
+    test_side<boost::int64_t>();
+
+    for (double scale = 1.0e3; scale < 1.1e8; scale *= 10.0)
+    {
+        test_overlay<boost::int32_t>(scale);
+        test_overlay<boost::int64_t>(scale);
+    }
+    test_overlay<boost::int64_t>(1.0e9);
+
+    return 0;
+}
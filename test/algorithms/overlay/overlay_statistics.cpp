@@ -0,0 +1,131 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <string>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/strategies/strategies.hpp>
+#include <boost/geometry/strategies/with_arena.hpp>
+#include <boost/geometry/strategies/with_statistics.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/difference.hpp>
+#include <boost/geometry/algorithms/intersection.hpp>
+#include <boost/geometry/algorithms/union.hpp>
+
+#include <boost/geometry/geometries/geometries.hpp>
+
+#include <boost/geometry/util/monotonic_arena.hpp>
+#include <boost/geometry/util/overlay_statistics.hpp>
+
+
+template <typename Polygon>
+Polygon wavy_polygon(std::size_t count, double waves, double phase, double cx)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    double const pi = 3.14159265358979323846;
+
+    Polygon result;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        double const a = 2.0 * pi * double(i) / double(count);
+        double const r = 100.0 + 10.0 * std::sin(waves * a + phase);
+        bg::append(result, point_type(cx + r * std::cos(a), r * std::sin(a)));
+    }
+    bg::correct(result);
+    return result;
+}
+
+template <typename Polygon>
+void test_statistics(Polygon const& g1, Polygon const& g2)
+{
+    typedef bg::strategy::intersection::cartesian_segments<> strategy_type;
+    typedef bg::strategy::intersection::with_statistics<strategy_type> statistics_type;
+    typedef bg::model::multi_polygon<Polygon> multi_polygon;
+
+    bg::overlay_statistics statistics;
+    BOOST_CHECK_EQUAL(statistics.calls, 0u);
+
+    multi_polygon expected, result;
+    bg::intersection(g1, g2, expected);
+    bg::intersection(g1, g2, result, statistics_type(statistics));
+    BOOST_CHECK_EQUAL(boost::size(expected), boost::size(result));
+    BOOST_CHECK_CLOSE(bg::area(expected), bg::area(result), 0.0001);
+
+    BOOST_CHECK_EQUAL(statistics.calls, 1u);
+    BOOST_CHECK(statistics.turns > 0);
+    BOOST_CHECK(statistics.discarded_turns <= statistics.turns);
+    BOOST_CHECK_EQUAL(statistics.traversed_rings, boost::size(result));
+    BOOST_CHECK_EQUAL(statistics.allocated_bytes, 0u);
+    for (std::size_t i = 0; i < bg::overlay_statistics::phase_count; i++)
+    {
+        BOOST_CHECK(statistics.seconds[i] >= 0.0);
+    }
+    BOOST_CHECK(statistics.total_seconds() > 0.0);
+
+    // The counters are accumulated, the turns are the same for all operations
+    std::size_t const turns = statistics.turns;
+    result.clear();
+    bg::union_(g1, g2, result, statistics_type(statistics));
+    result.clear();
+    bg::difference(g1, g2, result, statistics_type(statistics));
+    BOOST_CHECK_EQUAL(statistics.calls, 3u);
+    BOOST_CHECK_EQUAL(statistics.turns, 3 * turns);
+
+    statistics.reset();
+    BOOST_CHECK_EQUAL(statistics.calls, 0u);
+    BOOST_CHECK_EQUAL(statistics.turns, 0u);
+    BOOST_CHECK_EQUAL(statistics.total_seconds(), 0.0);
+
+    // Combined with the arena, in both orders
+    bg::monotonic_arena arena;
+    typedef bg::strategy::intersection::with_arena<strategy_type> arena_type;
+    typedef bg::strategy::intersection::with_statistics<arena_type> statistics_arena_type;
+    typedef bg::strategy::intersection::with_arena<statistics_type> arena_statistics_type;
+
+    result.clear();
+    bg::intersection(g1, g2, result,
+        statistics_arena_type(statistics, arena_type(arena)));
+    BOOST_CHECK_CLOSE(bg::area(expected), bg::area(result), 0.0001);
+    BOOST_CHECK_EQUAL(statistics.turns, turns);
+    BOOST_CHECK(statistics.allocated_bytes > 0);
+    BOOST_CHECK_EQUAL(arena.allocated_bytes(), 0u);
+
+    std::size_t const allocated_bytes = statistics.allocated_bytes;
+    result.clear();
+    bg::intersection(g1, g2, result,
+        arena_statistics_type(arena, statistics_type(statistics)));
+    BOOST_CHECK_CLOSE(bg::area(expected), bg::area(result), 0.0001);
+    BOOST_CHECK_EQUAL(statistics.calls, 2u);
+    BOOST_CHECK_EQUAL(statistics.allocated_bytes, 2 * allocated_bytes);
+}
+
+void test_phase_names()
+{
+    BOOST_CHECK_EQUAL(std::string(bg::overlay_statistics::phase_name(
+        bg::overlay_statistics::phase_sectionalize)), "sectionalize");
+    BOOST_CHECK_EQUAL(std::string(bg::overlay_statistics::phase_name(
+        bg::overlay_statistics::phase_add_rings)), "add_rings");
+    BOOST_CHECK_EQUAL(std::string(bg::overlay_statistics::phase_name(
+        bg::overlay_statistics::phase_count)), "");
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::polygon<bg::model::d2::point_xy<double> > polygon;
+
+    polygon const g1 = wavy_polygon<polygon>(2000, 50, 0.0, 0.0);
+    polygon const g2 = wavy_polygon<polygon>(1500, 70, 0.5, 3.0);
+
+    test_statistics(g1, g2);
+    test_phase_names();
+
+    return 0;
+}
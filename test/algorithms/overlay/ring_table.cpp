@@ -0,0 +1,101 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdlib>
+#include <map>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/detail/overlay/ring_table.hpp>
+#include <boost/geometry/util/monotonic_arena.hpp>
+
+
+typedef bg::ring_identifier rid;
+
+template <typename Table, typename Map>
+void check_equal(Table const& table, Map const& map)
+{
+    BOOST_CHECK_EQUAL(table.size(), map.size());
+    BOOST_CHECK_EQUAL(table.empty(), map.empty());
+
+    // Same values, in the same order
+    typename Table::const_iterator tit = boost::begin(table);
+    typename Map::const_iterator mit = boost::begin(map);
+    for ( ; tit != boost::end(table) && mit != boost::end(map); ++tit, ++mit)
+    {
+        BOOST_CHECK(tit->first == mit->first);
+        BOOST_CHECK_EQUAL(tit->second, mit->second);
+    }
+    BOOST_CHECK(tit == boost::end(table));
+    BOOST_CHECK(mit == boost::end(map));
+}
+
+template <typename Table>
+void test_table(Table& table)
+{
+    std::map<rid, int> map;
+    check_equal(table, map);
+
+    // Rings of a polygon, of a multi-polygon and of the traversed rings,
+    // added in random order
+    std::srand(7);
+    for (int i = 0; i < 2000; i++)
+    {
+        int const source = std::rand() % 3;
+        int const multi = source == 0 ? -1 : std::rand() % 50;
+        int const ring = source == 2 ? -1 : std::rand() % 20 - 1;
+        rid const id(source, multi, ring);
+        table[id] += i;
+        map[id] += i;
+    }
+    check_equal(table, map);
+
+    // Find
+    BOOST_CHECK(table.find(rid(0, -1, 100)) == table.end());
+    BOOST_CHECK(table.find(rid(1, 100, -1)) == table.end());
+    BOOST_CHECK(table.find(rid(5, -1, -1)) == table.end());
+    BOOST_CHECK_EQUAL(table.count(rid(5, -1, -1)), 0u);
+
+    rid const id = map.begin()->first;
+    typename Table::iterator it = table.find(id);
+    BOOST_CHECK(it != table.end());
+    BOOST_CHECK(it->first == id);
+    it->second = -1;
+    map[id] = -1;
+    check_equal(table, map);
+
+    // Insert
+    BOOST_CHECK(! table.insert(std::make_pair(id, 5)).second);
+    BOOST_CHECK(table.insert(std::make_pair(rid(1, 200, 3), 5)).second);
+    map.insert(std::make_pair(rid(1, 200, 3), 5));
+    check_equal(table, map);
+
+    table.clear();
+    map.clear();
+    check_equal(table, map);
+}
+
+int test_main(int, char* [])
+{
+    {
+        bg::detail::overlay::ring_table<int> table;
+        test_table(table);
+    }
+
+    {
+        typedef bg::detail::arena_allocator<int> allocator_type;
+        typedef bg::detail::overlay::ring_table<int, allocator_type> table_type;
+
+        bg::monotonic_arena arena;
+        table_type::allocator_type const allocator(&arena);
+        table_type table(allocator);
+        test_table(table);
+        BOOST_CHECK(arena.allocated_bytes() > 0u);
+    }
+
+    return 0;
+}
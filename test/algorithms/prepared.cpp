@@ -0,0 +1,221 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/prepared.hpp>
+
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/disjoint.hpp>
+#include <boost/geometry/algorithms/for_each.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/io/wkt/wkt.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+
+
+template <typename Ring>
+Ring wavy_ring(std::size_t count, double waves,
+               double cx, double cy, double radius)
+{
+    typedef typename bg::point_type<Ring>::type point_type;
+    double const pi = 3.14159265358979323846;
+
+    Ring result;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        double const a = 2.0 * pi * double(i) / double(count);
+        double const r = radius * (1.0 + 0.1 * std::sin(waves * a));
+        bg::append(result, point_type(cx + r * std::cos(a), cy + r * std::sin(a)));
+    }
+    return result;
+}
+
+template <typename Polygon>
+Polygon wavy_polygon(double cx, double cy)
+{
+    typedef typename bg::ring_type<Polygon>::type ring_type;
+
+    Polygon result;
+    bg::exterior_ring(result) = wavy_ring<ring_type>(1000, 15, cx, cy, 100.0);
+    bg::interior_rings(result).push_back(wavy_ring<ring_type>(200, 5, cx - 40.0, cy, 20.0));
+    bg::interior_rings(result).push_back(wavy_ring<ring_type>(300, 7, cx + 40.0, cy, 25.0));
+    bg::correct(result);
+    return result;
+}
+
+template <typename Point>
+struct collect_points
+{
+    explicit collect_points(std::vector<Point>& points)
+        : m_points(points)
+    {}
+
+    inline void operator()(Point const& point)
+    {
+        m_points.push_back(point);
+    }
+
+    std::vector<Point>& m_points;
+};
+
+// Points around and on the vertices and the segments of the geometry
+template <typename Point, typename Geometry>
+std::vector<Point> test_points(Geometry const& geometry)
+{
+    std::vector<Point> result;
+    for (int i = -130; i <= 330; i += 3)
+    {
+        for (int j = -130; j <= 130; j += 3)
+        {
+            result.push_back(Point(i, j));
+        }
+    }
+
+    std::vector<Point> vertices;
+    bg::for_each_point(geometry, collect_points<Point>(vertices));
+    for (std::size_t i = 0; i + 1 < vertices.size(); i += 7)
+    {
+        result.push_back(vertices[i]);
+        Point const middle((bg::get<0>(vertices[i]) + bg::get<0>(vertices[i + 1])) / 2,
+                           (bg::get<1>(vertices[i]) + bg::get<1>(vertices[i + 1])) / 2);
+        result.push_back(middle);
+    }
+    return result;
+}
+
+template <typename Prepared, typename Geometry2, typename Geometry>
+void check_predicates(Prepared const& prepared, Geometry2 const& geometry2,
+                      Geometry const& geometry)
+{
+    BOOST_CHECK_EQUAL(bg::within(geometry2, geometry), prepared.within(geometry2));
+    BOOST_CHECK_EQUAL(bg::covered_by(geometry2, geometry), prepared.covered_by(geometry2));
+    BOOST_CHECK_EQUAL(bg::intersects(geometry2, geometry), prepared.intersects(geometry2));
+    BOOST_CHECK_EQUAL(bg::disjoint(geometry2, geometry), prepared.disjoint(geometry2));
+    BOOST_CHECK_EQUAL(bg::relation(geometry2, geometry).str(),
+                      prepared.relation(geometry2).str());
+    BOOST_CHECK_EQUAL(bg::relate(geometry2, geometry, bg::de9im::mask("T*F**F***")),
+                      prepared.relate(geometry2, bg::de9im::mask("T*F**F***")));
+}
+
+template <typename Geometry>
+void test_points_of(Geometry const& geometry)
+{
+    typedef typename bg::point_type<Geometry>::type point_type;
+    typedef bg::model::multi_point<point_type> multi_point;
+
+    bg::prepared<Geometry> const prepared(geometry);
+
+    std::vector<point_type> const points = test_points<point_type>(geometry);
+    std::size_t inside = 0, boundary = 0;
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        check_predicates(prepared, points[i], geometry);
+        inside += bg::within(points[i], geometry) ? 1 : 0;
+        boundary += bg::covered_by(points[i], geometry)
+                 && ! bg::within(points[i], geometry) ? 1 : 0;
+    }
+    // The points cover all cases
+    BOOST_CHECK(inside > 0);
+    BOOST_CHECK(boundary > 0);
+
+    multi_point mp;
+    for (std::size_t i = 0; i < points.size(); i += 97)
+    {
+        mp.push_back(points[i]);
+        check_predicates(prepared, mp, geometry);
+    }
+
+    // A copy of the geometry is not the prepared geometry
+    Geometry const copy = geometry;
+    check_predicates(prepared, points.front(), copy);
+}
+
+template <typename Geometry>
+void test_lines_of(Geometry const& geometry)
+{
+    typedef typename bg::point_type<Geometry>::type point_type;
+    typedef bg::model::linestring<point_type> linestring;
+
+    bg::prepared<Geometry> const prepared(geometry);
+
+    for (int i = -150; i <= 350; i += 25)
+    {
+        for (int j = -150; j <= 150; j += 50)
+        {
+            linestring line;
+            bg::append(line, point_type(i, j));
+            bg::append(line, point_type(i + 20, j + 15));
+            check_predicates(prepared, line, geometry);
+        }
+    }
+}
+
+template <typename Polygon>
+void test_polygons_of(Polygon const& geometry)
+{
+    bg::prepared<Polygon> const prepared(geometry);
+
+    Polygon inner, outer;
+    bg::read_wkt("POLYGON((-10 -10,-10 10,10 10,10 -10,-10 -10))", inner);
+    bg::read_wkt("POLYGON((-200 -200,-200 200,400 200,400 -200,-200 -200))", outer);
+    bg::correct(inner);
+    bg::correct(outer);
+    check_predicates(prepared, inner, geometry);
+    check_predicates(prepared, outer, geometry);
+}
+
+template <typename Point, bool ClockWise, bool Closed>
+void test_all()
+{
+    typedef bg::model::polygon<Point, ClockWise, Closed> polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+    typedef bg::model::ring<Point, ClockWise, Closed> ring;
+
+    polygon const poly = wavy_polygon<polygon>(0.0, 0.0);
+    multi_polygon mpoly;
+    mpoly.push_back(poly);
+    mpoly.push_back(wavy_polygon<polygon>(210.0, 0.0));
+    ring const r = bg::exterior_ring(poly);
+
+    test_points_of(poly);
+    test_points_of(mpoly);
+    test_points_of(r);
+
+    test_lines_of(poly);
+    test_lines_of(mpoly);
+
+    test_polygons_of(poly);
+}
+
+void test_integer()
+{
+    typedef bg::model::point<int, 2, bg::cs::cartesian> point_type;
+    typedef bg::model::polygon<point_type> polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+
+    // Many points on the vertical and horizontal segments
+    multi_polygon mpoly;
+    bg::read_wkt("MULTIPOLYGON(((0 0,0 100,100 100,100 0,0 0),(20 20,80 20,80 80,20 80,20 20)),"
+                 "((40 40,40 60,60 60,60 40,40 40)),((150 0,100 50,150 100,200 50,150 0)))", mpoly);
+    test_points_of(mpoly);
+    test_lines_of(mpoly);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+
+    test_all<point_type, true, true>();
+    test_all<point_type, false, false>();
+    test_integer();
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/prepared_clip.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/length.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+
+template <typename Polygon>
+Polygon wavy_polygon(std::size_t count, double waves, double phase,
+                     double cx, double cy, double radius)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    double const pi = 3.14159265358979323846;
+
+    Polygon result;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        double const a = 2.0 * pi * double(i) / double(count);
+        double const r = radius * (1.0 + 0.1 * std::sin(waves * a + phase));
+        bg::append(result, point_type(cx + r * std::cos(a), cy + r * std::sin(a)));
+    }
+    bg::correct(result);
+    return result;
+}
+
+template <typename Polygon>
+std::vector<Polygon> features(std::size_t count)
+{
+    std::vector<Polygon> result;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        double const x = -150.0 + 300.0 * double(i % 10) / 9.0;
+        double const y = -150.0 + 300.0 * double(i / 10) / 9.0;
+        result.push_back(wavy_polygon<Polygon>(100 + i, 7, 0.1 * double(i),
+                                               x, y, 20.0 + double(i % 7)));
+    }
+    return result;
+}
+
+template <typename Prepared, typename Polygon>
+void check_feature(Prepared const& prepared, Polygon const& clip,
+                   Polygon const& feature)
+{
+    typedef bg::model::multi_polygon<Polygon> multi_polygon;
+
+    multi_polygon expected, result;
+    bg::intersection(feature, clip, expected);
+    BOOST_CHECK(prepared.intersection(feature, result));
+    BOOST_CHECK_EQUAL(boost::size(expected), boost::size(result));
+    BOOST_CHECK_CLOSE(bg::area(expected), bg::area(result), 0.0001);
+
+    expected.clear();
+    result.clear();
+    bg::difference(feature, clip, expected);
+    prepared.difference(feature, result);
+    BOOST_CHECK_EQUAL(boost::size(expected), boost::size(result));
+    BOOST_CHECK_CLOSE(bg::area(expected), bg::area(result), 0.0001);
+
+    BOOST_CHECK_EQUAL(bg::intersects(feature, clip), prepared.intersects(feature));
+}
+
+template <typename Prepared, typename Polygon>
+struct check_features
+{
+    Prepared const& m_prepared;
+    Polygon const& m_clip;
+    std::vector<Polygon> const& m_features;
+    std::vector<double>& m_areas;
+
+    inline void operator()(std::size_t i)
+    {
+        bg::model::multi_polygon<Polygon> result;
+        m_prepared.intersection(m_features[i], result);
+        m_areas[i] = bg::area(result);
+    }
+};
+
+template <typename Polygon>
+void test_areal()
+{
+    typedef bg::prepared_clip<Polygon> prepared_type;
+
+    Polygon const clip = wavy_polygon<Polygon>(3000, 40, 0.3, 0.0, 0.0, 100.0);
+    prepared_type const prepared(clip);
+
+    std::vector<Polygon> const input = features<Polygon>(100);
+    for (std::size_t i = 0; i < input.size(); i++)
+    {
+        check_feature(prepared, clip, input[i]);
+    }
+
+    // Feature with the same vertices as the clip
+    check_feature(prepared, clip, clip);
+
+    // A copy of the clip is not the prepared geometry, it is sectionalized
+    Polygon const copy = clip;
+    check_feature(prepared, clip, copy);
+
+    // Shared by threads
+    std::vector<double> areas(input.size());
+    check_features<prepared_type, Polygon> worker = { prepared, clip, input, areas };
+    bg::detail::parallel::for_each_index(input.size(), 4, worker);
+    for (std::size_t i = 0; i < input.size(); i++)
+    {
+        bg::model::multi_polygon<Polygon> expected;
+        bg::intersection(input[i], clip, expected);
+        BOOST_CHECK_CLOSE(bg::area(expected), areas[i], 0.0001);
+    }
+}
+
+template <typename Polygon>
+void test_linear()
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    typedef bg::model::linestring<point_type> linestring;
+    typedef bg::model::multi_linestring<linestring> multi_linestring;
+
+    Polygon const clip = wavy_polygon<Polygon>(500, 20, 0.0, 0.0, 0.0, 100.0);
+    bg::prepared_clip<Polygon> const prepared(clip);
+
+    for (int i = -3; i <= 3; i++)
+    {
+        linestring line;
+        bg::append(line, point_type(-200.0, 50.0 * i));
+        bg::append(line, point_type(200.0, 50.0 * i + 10.0));
+
+        multi_linestring expected, result;
+        bg::intersection(line, clip, expected);
+        prepared.intersection(line, result);
+        BOOST_CHECK_CLOSE(bg::length(expected), bg::length(result), 0.0001);
+
+        expected.clear();
+        result.clear();
+        bg::difference(line, clip, expected);
+        prepared.difference(line, result);
+        BOOST_CHECK_CLOSE(bg::length(expected), bg::length(result), 0.0001);
+
+        BOOST_CHECK_EQUAL(bg::intersects(line, clip), prepared.intersects(line));
+    }
+}
+
+template <typename Polygon>
+void test_prepared_sections()
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    typedef bg::sections<bg::model::box<point_type>, 2> sections_type;
+    typedef bg::strategy::intersection::cartesian_segments<> strategy_type;
+
+    Polygon const clip = wavy_polygon<Polygon>(20, 3, 0.0, 0.0, 0.0, 100.0);
+    Polygon const other = clip;
+    sections_type sections, reversed;
+    bg::detail::section::with_prepared_sections
+        <
+            strategy_type, Polygon, sections_type
+        > const strategy(strategy_type(), clip, sections, reversed);
+
+    BOOST_CHECK((bg::detail::section::prepared_sections<false, sections_type>(clip, strategy) == &sections));
+    BOOST_CHECK((bg::detail::section::prepared_sections<true, sections_type>(clip, strategy) == &reversed));
+    BOOST_CHECK((bg::detail::section::prepared_sections<false, sections_type>(other, strategy) == 0));
+    BOOST_CHECK((bg::detail::section::prepared_sections<false, sections_type>(clip, strategy_type()) == 0));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::d2::point_xy<double> point_type;
+
+    test_prepared_sections<bg::model::polygon<point_type> >();
+
+    test_areal<bg::model::polygon<point_type> >();
+    test_areal<bg::model::polygon<point_type, false> >();
+
+    test_linear<bg::model::polygon<point_type> >();
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/tiled_overlay.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/difference.hpp>
+#include <boost/geometry/algorithms/is_valid.hpp>
+#include <boost/geometry/algorithms/union_all.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+
+
+template <typename Polygon>
+Polygon wavy_polygon(std::size_t count, double waves, double cx, double cy,
+                     double radius)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    typedef typename bg::coordinate_type<Polygon>::type coordinate_type;
+    double const pi = 3.14159265358979323846;
+
+    Polygon result;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        double const a = 2.0 * pi * double(i) / double(count);
+        double const r = radius * (1.0 + 0.1 * std::sin(waves * a + cx));
+        bg::append(result, point_type(
+            coordinate_type(std::floor(cx + r * std::cos(a))),
+            coordinate_type(std::floor(cy + r * std::sin(a)))));
+    }
+    bg::correct(result);
+    return result;
+}
+
+// A large polygon with a hole, and islands of which some are in the hole
+template <typename MultiPolygon>
+MultiPolygon input_geometry(double cx, double cy)
+{
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+
+    std::vector<polygon_type> polygons;
+    polygons.push_back(wavy_polygon<polygon_type>(2000, 40.0, cx, cy, 10000.0));
+    for (int i = 0; i < 6; i++)
+    {
+        polygons.push_back(wavy_polygon<polygon_type>(300, 7.0,
+                            cx + 13000.0 * std::cos(double(i)),
+                            cy + 13000.0 * std::sin(double(i)), 2000.0));
+    }
+    MultiPolygon result;
+    bg::union_all(polygons, result);
+
+    MultiPolygon hole;
+    bg::convert(wavy_polygon<polygon_type>(500, 11.0, cx + 500.0, cy, 3000.0), hole);
+    MultiPolygon with_hole;
+    bg::difference(result, hole, with_hole);
+    bg::convert(wavy_polygon<polygon_type>(100, 3.0, cx + 500.0, cy, 1000.0), hole);
+    bg::union_(with_hole, hole, result);
+    return result;
+}
+
+template <typename MultiPolygon, typename Result>
+double total_area(Result const& result)
+{
+    double area = 0.0;
+    for (std::size_t i = 0; i < boost::size(result); i++)
+    {
+        area += bg::area(bg::range::at(result, i));
+    }
+    return area;
+}
+
+template <typename Polygon>
+void test_all()
+{
+    typedef bg::model::multi_polygon<Polygon> multi_polygon;
+
+    multi_polygon const g1 = input_geometry<multi_polygon>(0.0, 0.0);
+    multi_polygon const g2 = input_geometry<multi_polygon>(3500.0, 2100.0);
+    BOOST_CHECK(bg::is_valid(g1));
+    BOOST_CHECK(bg::is_valid(g2));
+
+    multi_polygon expected_intersection, expected_union;
+    bg::intersection(g1, g2, expected_intersection);
+    bg::union_(g1, g2, expected_union);
+
+    for (std::size_t tiles = 1; tiles <= 8; tiles *= 2)
+    {
+        multi_polygon result;
+        bg::tiled_intersection(g1, g2, result, tiles);
+        BOOST_CHECK_EQUAL(boost::size(expected_intersection), boost::size(result));
+        BOOST_CHECK_CLOSE(bg::area(expected_intersection), bg::area(result), 0.001);
+        BOOST_CHECK(bg::is_valid(result));
+
+        result.clear();
+        bg::tiled_union(g1, g2, result, tiles);
+        BOOST_CHECK_EQUAL(boost::size(expected_union), boost::size(result));
+        BOOST_CHECK_CLOSE(bg::area(expected_union), bg::area(result), 0.001);
+        BOOST_CHECK(bg::is_valid(result));
+    }
+
+    // Multi-threaded, into a vector
+    typedef bg::strategy::intersection::parallel
+        <
+            bg::strategy::intersection::cartesian_segments<>
+        > parallel_type;
+    std::vector<Polygon> parallel_result;
+    bg::tiled_intersection(g1, g2, parallel_result, 4, parallel_type(4));
+    BOOST_CHECK_EQUAL(boost::size(expected_intersection), parallel_result.size());
+    BOOST_CHECK_CLOSE(bg::area(expected_intersection),
+                      total_area<multi_polygon>(parallel_result), 0.001);
+
+    // Disjoint and empty input
+    multi_polygon result;
+    bg::tiled_intersection(g1, input_geometry<multi_polygon>(100000.0, 0.0),
+                           result, 4);
+    BOOST_CHECK(result.empty());
+    bg::tiled_union(g1, multi_polygon(), result, 4);
+    BOOST_CHECK_EQUAL(boost::size(g1), boost::size(result));
+    BOOST_CHECK_CLOSE(bg::area(g1), bg::area(result), 0.0001);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+
+    test_all<bg::model::polygon<point_type> >();
+    test_all<bg::model::polygon<point_type, false, false> >();
+    test_all<bg::model::polygon<bg::model::d2::point_xy<long long> > >();
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/union_all.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/is_valid.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+
+
+template <typename Polygon>
+Polygon wavy_polygon(std::size_t count, double cx, double cy, double radius)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    double const pi = 3.14159265358979323846;
+
+    Polygon result;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        double const a = 2.0 * pi * double(i) / double(count);
+        double const r = radius * (1.0 + 0.1 * std::sin(5.0 * a + cx));
+        bg::append(result, point_type(cx + r * std::cos(a), cy + r * std::sin(a)));
+    }
+    bg::correct(result);
+    return result;
+}
+
+// Overlapping polygons in a grid, and some isolated ones
+template <typename Polygon>
+std::vector<Polygon> input_polygons(int count_x, int count_y)
+{
+    std::vector<Polygon> result;
+    for (int i = 0; i < count_x; i++)
+    {
+        for (int j = 0; j < count_y; j++)
+        {
+            result.push_back(wavy_polygon<Polygon>(20 + (i + j) % 13,
+                                                   10.0 * i + 0.3 * j, 10.0 * j, 7.0));
+        }
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        result.push_back(wavy_polygon<Polygon>(12, -100.0 - 30.0 * i, -100.0, 5.0));
+    }
+    return result;
+}
+
+template <typename MultiPolygon, typename Polygon>
+MultiPolygon union_sequentially(std::vector<Polygon> const& input)
+{
+    MultiPolygon result;
+    for (std::size_t i = 0; i < input.size(); i++)
+    {
+        MultiPolygon next;
+        bg::union_(result, input[i], next);
+        result.swap(next);
+    }
+    return result;
+}
+
+template <typename Polygon>
+void test_all()
+{
+    typedef bg::model::multi_polygon<Polygon> multi_polygon;
+
+    std::vector<Polygon> const input = input_polygons<Polygon>(12, 9);
+    multi_polygon const expected = union_sequentially<multi_polygon>(input);
+
+    multi_polygon result;
+    bg::union_all(input, result);
+    BOOST_CHECK_EQUAL(boost::size(expected), boost::size(result));
+    BOOST_CHECK_CLOSE(bg::area(expected), bg::area(result), 0.0001);
+    BOOST_CHECK(bg::is_valid(result));
+
+    // Multi-threaded, into a vector
+    std::vector<Polygon> parallel_result;
+    bg::union_all(input, parallel_result,
+                  bg::strategy::intersection::parallel
+                    <
+                        bg::strategy::intersection::cartesian_segments<>
+                    >(4));
+    BOOST_CHECK_EQUAL(boost::size(expected), parallel_result.size());
+    double area = 0.0;
+    for (std::size_t i = 0; i < parallel_result.size(); i++)
+    {
+        area += bg::area(parallel_result[i]);
+    }
+    BOOST_CHECK_CLOSE(bg::area(expected), area, 0.0001);
+
+    // Multi-polygons as input
+    std::vector<multi_polygon> multi_input(3);
+    for (std::size_t i = 0; i < input.size(); i++)
+    {
+        multi_input[i % 3].push_back(input[i]);
+    }
+    // The polygons of one multi-polygon may not overlap
+    for (std::size_t i = 0; i < multi_input.size(); i++)
+    {
+        multi_polygon valid;
+        bg::union_all(multi_input[i], valid);
+        multi_input[i].swap(valid);
+    }
+    result.clear();
+    bg::union_all(multi_input, result);
+    BOOST_CHECK_EQUAL(boost::size(expected), boost::size(result));
+    BOOST_CHECK_CLOSE(bg::area(expected), bg::area(result), 0.0001);
+
+    // Empty input and a single polygon
+    result.clear();
+    bg::union_all(std::vector<Polygon>(), result);
+    BOOST_CHECK(result.empty());
+
+    bg::union_all(std::vector<Polygon>(1, input.front()), result);
+    BOOST_CHECK_EQUAL(1u, boost::size(result));
+    BOOST_CHECK_CLOSE(bg::area(input.front()), bg::area(result), 0.0001);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+
+    test_all<bg::model::polygon<point_type> >();
+    test_all<bg::model::polygon<point_type, false, false> >();
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Robustness Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Benchmark of overlay and relate of polygons with coordinates quantized
+// to 1e-7 degrees, stored as integers (not rescaled) and as doubles
+// (rescaled into the robust integer space).
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/program_options.hpp>
+
+namespace bg = boost::geometry;
+
+typedef boost::chrono::steady_clock clock_type;
+typedef boost::chrono::duration<float> dur_type;
+
+
+// Polygon around (cx, cy) in degrees with the radius varying along the
+// circle, quantized to 1e-7 degrees
+template <typename Polygon>
+Polygon wavy_polygon(int count, double waves, double phase,
+                     double cx, double cy, double radius)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    typedef typename bg::coordinate_type<Polygon>::type coordinate_type;
+    double const pi = 3.14159265358979323846;
+
+    Polygon result;
+    for (int i = 0; i < count; i++)
+    {
+        double const a = 2.0 * pi * double(i) / double(count);
+        double const r = radius * (1.0 + 0.1 * std::sin(waves * a + phase));
+        double const x = std::floor((cx + r * std::cos(a)) * 1.0e7 + 0.5);
+        double const y = std::floor((cy + r * std::sin(a)) * 1.0e7 + 0.5);
+        bg::append(result, point_type(coordinate_type(x), coordinate_type(y)));
+    }
+    bg::correct(result);
+    return result;
+}
+
+template <typename Coordinate>
+void run(std::string const& name, int count, int vertices)
+{
+    typedef bg::model::d2::point_xy<Coordinate> point_type;
+    typedef bg::model::polygon<point_type> polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+
+    // A field near the antimeridian, so the coordinates are large
+    polygon const p = wavy_polygon<polygon>(vertices, 50, 0.0, 170.0, 60.0, 0.5);
+    polygon const q = wavy_polygon<polygon>(vertices, 70, 0.5, 170.05, 60.0, 0.5);
+
+    double area = 0;
+    std::size_t relations = 0;
+
+    clock_type::time_point const start = clock_type::now();
+    for (int i = 0; i < count; i++)
+    {
+        multi_polygon intersection, union_result;
+        bg::intersection(p, q, intersection);
+        bg::union_(p, q, union_result);
+        area += bg::area(intersection) / bg::area(union_result);
+    }
+    float const overlay_seconds = dur_type(clock_type::now() - start).count();
+
+    clock_type::time_point const relate_start = clock_type::now();
+    for (int i = 0; i < count; i++)
+    {
+        relations += bg::intersects(p, q) ? 1 : 0;
+        relations += bg::relate(p, q, bg::de9im::mask("T*T***T**")) ? 1 : 0;
+    }
+    float const relate_seconds = dur_type(clock_type::now() - relate_start).count();
+
+    std::cout << name
+              << " overlay: " << overlay_seconds << " s"
+              << ", relate: " << relate_seconds << " s"
+              << ", intersection / union: " << area / count
+              << ", relations: " << relations
+              << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    namespace po = boost::program_options;
+    po::options_description description("=== integer_overlay ===\nAllowed options");
+
+    int count = 20;
+    int vertices = 5000;
+
+    description.add_options()
+        ("help", "Help message")
+        ("count", po::value<int>(&count)->default_value(20), "Number of repetitions")
+        ("vertices", po::value<int>(&vertices)->default_value(5000), "Number of vertices of each polygon")
+    ;
+
+    po::variables_map varmap;
+    po::store(po::parse_command_line(argc, argv, description), varmap);
+    po::notify(varmap);
+
+    if (varmap.count("help"))
+    {
+        std::cout << description << std::endl;
+        return 1;
+    }
+
+    run<double>("double (rescaled)", count, vertices);
+    run<boost::int64_t>("int64", count, vertices);
+    run<boost::int32_t>("int32", count, vertices);
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Robustness Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Benchmark of overlay of adjacent polygons sharing long borders, such as
+// administrative boundaries from the same source, causing many colocated
+// turns
+
+#include <iostream>
+#include <string>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/strategies/with_statistics.hpp>
+#include <boost/geometry/util/overlay_statistics.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/program_options.hpp>
+
+namespace bg = boost::geometry;
+
+typedef boost::chrono::steady_clock clock_type;
+typedef boost::chrono::duration<float> dur_type;
+
+typedef bg::model::d2::point_xy<double> point_type;
+typedef bg::model::polygon<point_type> polygon;
+typedef bg::model::multi_polygon<polygon> multi_polygon;
+
+
+// Square cell with the given number of vertices on each side, the vertices
+// of the borders shared by neighbouring cells are the same
+polygon cell(int i, int j, int vertices)
+{
+    polygon result;
+    double const step = 1.0 / vertices;
+    for (int k = 0; k < vertices; k++)
+    {
+        bg::append(result, point_type(i, j + k * step));
+    }
+    for (int k = 0; k < vertices; k++)
+    {
+        bg::append(result, point_type(i + k * step, j + 1));
+    }
+    for (int k = 0; k < vertices; k++)
+    {
+        bg::append(result, point_type(i + 1, j + 1 - k * step));
+    }
+    for (int k = 0; k < vertices; k++)
+    {
+        bg::append(result, point_type(i + 1 - k * step, j));
+    }
+    bg::append(result, point_type(i, j));
+    bg::correct(result);
+    return result;
+}
+
+template <typename Operation>
+void run(std::string const& name, multi_polygon const& a, multi_polygon const& b,
+         int count, Operation const& operation)
+{
+    typedef bg::strategy::intersection::cartesian_segments<> strategy_type;
+    typedef bg::strategy::intersection::with_statistics<strategy_type> statistics_type;
+
+    bg::overlay_statistics statistics;
+    double area = 0;
+
+    clock_type::time_point const start = clock_type::now();
+    for (int i = 0; i < count; i++)
+    {
+        multi_polygon result;
+        operation(a, b, result, statistics_type(statistics));
+        area += bg::area(result);
+    }
+    float const seconds = dur_type(clock_type::now() - start).count();
+
+    std::cout << name << ": " << seconds << " s"
+        << ", handle_colocations: "
+        << statistics.seconds[bg::overlay_statistics::phase_handle_colocations] << " s"
+        << ", turns: " << statistics.turns / count
+        << ", clusters: " << statistics.clusters / count
+        << ", area: " << area / count
+        << std::endl;
+}
+
+struct intersection_operation
+{
+    template <typename G1, typename G2, typename Result, typename Strategy>
+    void operator()(G1 const& g1, G2 const& g2, Result& result, Strategy const& strategy) const
+    {
+        bg::intersection(g1, g2, result, strategy);
+    }
+};
+
+struct union_operation
+{
+    template <typename G1, typename G2, typename Result, typename Strategy>
+    void operator()(G1 const& g1, G2 const& g2, Result& result, Strategy const& strategy) const
+    {
+        bg::union_(g1, g2, result, strategy);
+    }
+};
+
+int main(int argc, char** argv)
+{
+    namespace po = boost::program_options;
+    po::options_description description("=== shared_borders ===\nAllowed options");
+
+    int count = 5;
+    int cells = 20;
+    int vertices = 20;
+
+    description.add_options()
+        ("help", "Help message")
+        ("count", po::value<int>(&count)->default_value(5), "Number of repetitions")
+        ("cells", po::value<int>(&cells)->default_value(20), "Number of cells in each direction")
+        ("vertices", po::value<int>(&vertices)->default_value(20), "Number of vertices on each side of a cell")
+    ;
+
+    po::variables_map varmap;
+    po::store(po::parse_command_line(argc, argv, description), varmap);
+    po::notify(varmap);
+
+    if (varmap.count("help"))
+    {
+        std::cout << description << std::endl;
+        return 1;
+    }
+
+    // The black and the white cells of a checkerboard, sharing all borders,
+    // and the same grid with cells twice as large, sharing the borders
+    // with every other cell
+    multi_polygon black, white, coarse;
+    for (int i = 0; i < cells; i++)
+    {
+        for (int j = 0; j < cells; j++)
+        {
+            ((i + j) % 2 == 0 ? black : white).push_back(cell(i, j, vertices));
+        }
+    }
+    for (int i = 0; i < cells; i += 2)
+    {
+        for (int j = 0; j < cells; j += 2)
+        {
+            polygon p = cell(i, j, vertices);
+            multi_polygon large;
+            bg::union_(p, cell(i + 1, j, vertices), large);
+            multi_polygon upper;
+            bg::union_(cell(i, j + 1, vertices), cell(i + 1, j + 1, vertices), upper);
+            multi_polygon merged;
+            bg::union_(large, upper, merged);
+            coarse.insert(coarse.end(), merged.begin(), merged.end());
+        }
+    }
+
+    run("union black/white", black, white, count, union_operation());
+    run("intersection black/white", black, white, count, intersection_operation());
+    run("intersection black/coarse", black, coarse, count, intersection_operation());
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Robustness Test
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Benchmark of union_all for thousands of overlapping polygons, compared
+// with folding union_ over the polygons one by one.
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/algorithms/union_all.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/strategies/parallel.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/program_options.hpp>
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+namespace bg = boost::geometry;
+
+typedef boost::chrono::steady_clock clock_type;
+typedef boost::chrono::duration<float> dur_type;
+
+
+// Footprint-like polygons: rotated rectangles with some extra vertices,
+// scattered over the field and overlapping their neighbours
+template <typename Polygon, typename Generator>
+Polygon make_footprint(Generator& generator, double field_size)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+
+    double const cx = generator() * field_size;
+    double const cy = generator() * field_size;
+    double const w = 1.0 + generator() * 2.0;
+    double const h = 1.0 + generator() * 2.0;
+    double const angle = generator() * 3.14159265358979323846;
+    double const ca = std::cos(angle);
+    double const sa = std::sin(angle);
+
+    double const xs[] = { -w, 0.0, w, w, -w };
+    double const ys[] = { -h, -h * 1.1, -h, h, h };
+
+    Polygon result;
+    for (int i = 0; i < 5; i++)
+    {
+        bg::append(result, point_type(cx + ca * xs[i] - sa * ys[i],
+                                      cy + sa * xs[i] + ca * ys[i]));
+    }
+    bg::correct(result);
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    namespace po = boost::program_options;
+    po::options_description description("=== union_all ===\nAllowed options");
+
+    int count = 5000;
+    int threads = 0;
+    double field_size = 0;
+    bool fold = true;
+
+    description.add_options()
+        ("help", "Help message")
+        ("count", po::value<int>(&count)->default_value(5000), "Number of polygons")
+        ("threads", po::value<int>(&threads)->default_value(0), "Number of threads, 0 for all hardware threads")
+        ("field_size", po::value<double>(&field_size)->default_value(0), "Size of the field, 0 for 3 * sqrt(count)")
+        ("fold", po::value<bool>(&fold)->default_value(true), "Also fold union_ over the polygons")
+    ;
+
+    po::variables_map varmap;
+    po::store(po::parse_command_line(argc, argv, description), varmap);
+    po::notify(varmap);
+
+    if (varmap.count("help"))
+    {
+        std::cout << description << std::endl;
+        return 1;
+    }
+
+    typedef bg::model::d2::point_xy<double> point_type;
+    typedef bg::model::polygon<point_type> polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+    typedef bg::strategy::intersection::cartesian_segments<> strategy_type;
+
+    if (field_size <= 0)
+    {
+        field_size = 3.0 * std::sqrt(double(count));
+    }
+
+    boost::minstd_rand rand_generator(12345);
+    boost::uniform_real<> random_range(0.0, 1.0);
+    boost::variate_generator
+        <
+            boost::minstd_rand&, boost::uniform_real<>
+        > generator(rand_generator, random_range);
+
+    std::vector<polygon> polygons;
+    for (int i = 0; i < count; i++)
+    {
+        polygons.push_back(make_footprint<polygon>(generator, field_size));
+    }
+
+    {
+        clock_type::time_point const start = clock_type::now();
+        multi_polygon result;
+        bg::union_all(polygons, result, strategy_type());
+        float const seconds = dur_type(clock_type::now() - start).count();
+        std::cout << "union_all, 1 thread: " << seconds << " s, "
+                  << result.size() << " polygons, area " << bg::area(result)
+                  << std::endl;
+    }
+
+    {
+        clock_type::time_point const start = clock_type::now();
+        multi_polygon result;
+        bg::union_all(polygons, result,
+                      bg::strategy::intersection::parallel<strategy_type>(threads));
+        float const seconds = dur_type(clock_type::now() - start).count();
+        std::cout << "union_all, parallel: " << seconds << " s, "
+                  << result.size() << " polygons, area " << bg::area(result)
+                  << std::endl;
+    }
+
+    if (fold)
+    {
+        clock_type::time_point const start = clock_type::now();
+        multi_polygon result;
+        for (std::size_t i = 0; i < polygons.size(); i++)
+        {
+            multi_polygon next;
+            bg::union_(result, polygons[i], next);
+            result.swap(next);
+        }
+        float const seconds = dur_type(clock_type::now() - start).count();
+        std::cout << "fold union_: " << seconds << " s, "
+                  << result.size() << " polygons, area " << bg::area(result)
+                  << std::endl;
+    }
+
+    return 0;
+}